@@ -3,6 +3,7 @@
 #include "astronomy/orbital_elements.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <tuple>
 #include <vector>
 
@@ -12,6 +13,7 @@
 #include "numerics/quadrature.hpp"
 #include "integrators/embedded_explicit_runge_kutta_integrator.hpp"
 #include "integrators/methods.hpp"
+#include "numerics/elementary_function_kernels.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/kepler_orbit.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -26,6 +28,7 @@ using namespace principia::integrators::_embedded_explicit_runge_kutta_integrato
 using namespace principia::integrators::_integrators;
 using namespace principia::integrators::_methods;
 using namespace principia::integrators::_ordinary_differential_equations;
+using namespace principia::numerics::_elementary_function_kernels;
 using namespace principia::numerics::_quadrature;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_kepler_orbit;
@@ -361,34 +364,41 @@ OrbitalElements::MeanEquinoctialElements(
     return eerk_a_tolerance / Abs(Δa);
   };
 
-  auto const initial_integration =
-      [&equinoctial_elements, period, t_min](auto const element) {
-        return AutomaticClenshawCurtis(
-                   [element, &equinoctial_elements](Instant const& t) {
-                     return equinoctial_elements(t).*element;
-                   },
-                   t_min,
-                   t_min + period,
-                   max_clenshaw_curtis_relative_error_for_initial_integration,
-                   /*max_points=*/max_clenshaw_curtis_points) /
-               period;
-      };
-
   // Ensure that Clenshaw-Curtis will not go out of the bounds of the
   // trajectory.
   if (t_max < t_min + period) {
     return mean_elements;
   }
 
-  ODE::DependentVariables const initial_mean_elements{
-      initial_integration(&EquinoctialElements::a),
-      initial_integration(&EquinoctialElements::h),
-      initial_integration(&EquinoctialElements::k),
-      initial_integration(&EquinoctialElements::λ),
-      initial_integration(&EquinoctialElements::p),
-      initial_integration(&EquinoctialElements::q),
-      initial_integration(&EquinoctialElements::pʹ),
-      initial_integration(&EquinoctialElements::qʹ)};
+  // All the elements are integrated together, so that the (expensive)
+  // equinoctial elements are only computed once per node.
+  auto const [ʃ_a_dt, ʃ_h_dt, ʃ_k_dt, ʃ_λ_dt,
+              ʃ_p_dt, ʃ_q_dt, ʃ_pʹ_dt, ʃ_qʹ_dt] =
+      AutomaticClenshawCurtisOfTuple(
+          [&equinoctial_elements](Instant const& t) {
+            auto const elements = equinoctial_elements(t);
+            return std::tuple(elements.a,
+                              elements.h,
+                              elements.k,
+                              elements.λ,
+                              elements.p,
+                              elements.q,
+                              elements.pʹ,
+                              elements.qʹ);
+          },
+          t_min,
+          t_min + period,
+          max_clenshaw_curtis_relative_error_for_initial_integration,
+          /*max_points=*/max_clenshaw_curtis_points);
+
+  ODE::DependentVariables const initial_mean_elements{ʃ_a_dt / period,
+                                                      ʃ_h_dt / period,
+                                                      ʃ_k_dt / period,
+                                                      ʃ_λ_dt / period,
+                                                      ʃ_p_dt / period,
+                                                      ʃ_q_dt / period,
+                                                      ʃ_pʹ_dt / period,
+                                                      ʃ_qʹ_dt / period};
 
   // Compute bounds that make sure that the ODE integrator never evaluate the
   // trajectory outside of its bounds.
@@ -432,18 +442,33 @@ OrbitalElements::MeanEquinoctialElements(
 inline absl::StatusOr<std::vector<OrbitalElements::ClassicalElements>>
 OrbitalElements::ToClassicalElements(
     std::vector<EquinoctialElements> const& equinoctial_elements) {
+  // The square roots are evaluated in a batch, see
+  // |elementary_function_kernels|; the arc tangents are correctly rounded and
+  // use the scalar functions.  The array below contains n entries for each of
+  // the norms that we compute.
+  std::int64_t const n = equinoctial_elements.size();
+  std::vector<double> norms(3 * n);
+  for (std::int64_t j = 0; j < n; ++j) {
+    RETURN_IF_STOPPED;
+    auto const& equinoctial = equinoctial_elements[j];
+    norms[j] = Pow<2>(equinoctial.p) + Pow<2>(equinoctial.q);
+    norms[n + j] = Pow<2>(equinoctial.pʹ) + Pow<2>(equinoctial.qʹ);
+    norms[2 * n + j] = Pow<2>(equinoctial.h) + Pow<2>(equinoctial.k);
+  }
+  BatchSqrt(3 * n, norms.data(), norms.data());
+
   std::vector<ClassicalElements> classical_elements;
-  classical_elements.reserve(equinoctial_elements.size());
-  for (auto const& equinoctial : equinoctial_elements) {
+  classical_elements.reserve(n);
+  for (std::int64_t j = 0; j < n; ++j) {
     RETURN_IF_STOPPED;
-    double const tg_½i = Sqrt(Pow<2>(equinoctial.p) + Pow<2>(equinoctial.q));
-    double const cotg_½i =
-        Sqrt(Pow<2>(equinoctial.pʹ) + Pow<2>(equinoctial.qʹ));
+    auto const& equinoctial = equinoctial_elements[j];
+    double const tg_½i = norms[j];
+    double const cotg_½i = norms[n + j];
     Angle const i =
         cotg_½i > tg_½i ? 2 * ArcTan(tg_½i) : 2 * ArcTan(1 / cotg_½i);
     Angle const Ω = cotg_½i > tg_½i ? ArcTan(equinoctial.p, equinoctial.q)
                                     : ArcTan(equinoctial.pʹ, equinoctial.qʹ);
-    double const e = Sqrt(Pow<2>(equinoctial.h) + Pow<2>(equinoctial.k));
+    double const e = norms[2 * n + j];
     Angle const ϖ = ArcTan(equinoctial.h, equinoctial.k);
     Angle const ω = ϖ - Ω;
     Angle const M = equinoctial.λ - ϖ;
@@ -482,59 +507,43 @@ inline absl::Status OrbitalElements::ComputePeriodsAndPrecession() {
   //   12 ∫ э(t) (t - t̄) dt / Δt³.
   // We first compute ∫ э(t) (t - t̄) dt for the three elements of interest.
 
-  auto const interpolate_function_of_mean_classical_element =
-      [this](auto const f, Instant const& t) {
-        CHECK_LE(t, mean_classical_elements_.back().time);
-        auto const it =
-            std::partition_point(mean_classical_elements_.begin(),
-                                 mean_classical_elements_.end(),
-                                 [&t](ClassicalElements const& elements) {
-                                   return elements.time < t;
-                                 });
-        ClassicalElements const& high = *it;
-        if (it == mean_classical_elements_.begin()) {
-          return f(high);
-        } else {
-          ClassicalElements const& low = *std::prev(it);
-          double const α = (t - low.time) / (high.time - low.time);
-          return f(low) + α * (f(high) - f(low));
-        }
-      };
+  // Returns the mean anomaly M, the mean argument of latitude u and the
+  // longitude of the ascending node Ω, linearly interpolated at |t|.
+  auto const interpolate_mean_angles = [this](Instant const& t) {
+    auto const angles = [](ClassicalElements const& elements) {
+      return std::tuple(
+          elements.mean_anomaly,
+          elements.argument_of_periapsis + elements.mean_anomaly,
+          elements.longitude_of_ascending_node);
+    };
+    CHECK_LE(t, mean_classical_elements_.back().time);
+    auto const it =
+        std::partition_point(mean_classical_elements_.begin(),
+                             mean_classical_elements_.end(),
+                             [&t](ClassicalElements const& elements) {
+                               return elements.time < t;
+                             });
+    ClassicalElements const& high = *it;
+    if (it == mean_classical_elements_.begin()) {
+      return angles(high);
+    } else {
+      ClassicalElements const& low = *std::prev(it);
+      double const α = (t - low.time) / (high.time - low.time);
+      auto const [M₀, u₀, Ω₀] = angles(low);
+      auto const [M₁, u₁, Ω₁] = angles(high);
+      return std::tuple(M₀ + α * (M₁ - M₀),
+                        u₀ + α * (u₁ - u₀),
+                        Ω₀ + α * (Ω₁ - Ω₀));
+    }
+  };
 
   Instant const t̄ = mean_classical_elements_.front().time + Δt / 2;
 
-  Product<Angle, Square<Time>> const ʃ_Mt_dt = AutomaticClenshawCurtis(
-      [&interpolate_function_of_mean_classical_element, &t̄](Instant const& t) {
-        return interpolate_function_of_mean_classical_element(
-            [&t, &t̄](ClassicalElements const& elements) {
-              return elements.mean_anomaly * (t - t̄);
-            },
-            t);
-      },
-      mean_classical_elements_.front().time,
-      mean_classical_elements_.back().time,
-      max_clenshaw_curtis_relative_error,
-      /*max_points=*/mean_classical_elements_.size());
-  Product<Angle, Square<Time>> const ʃ_ut_dt = AutomaticClenshawCurtis(
-      [&interpolate_function_of_mean_classical_element, &t̄](Instant const& t) {
-        return interpolate_function_of_mean_classical_element(
-            [&t, &t̄](ClassicalElements const& elements) {
-              return (elements.argument_of_periapsis + elements.mean_anomaly) *
-                     (t - t̄);
-            },
-            t);
-      },
-      mean_classical_elements_.front().time,
-      mean_classical_elements_.back().time,
-      max_clenshaw_curtis_relative_error,
-      /*max_points=*/mean_classical_elements_.size());
-  Product<Angle, Square<Time>> const ʃ_Ωt_dt = AutomaticClenshawCurtis(
-      [&interpolate_function_of_mean_classical_element, &t̄](Instant const& t) {
-        return interpolate_function_of_mean_classical_element(
-            [&t, &t̄](ClassicalElements const& elements) {
-              return elements.longitude_of_ascending_node * (t - t̄);
-            },
-            t);
+  // The three integrals share their evaluations.
+  auto const [ʃ_Mt_dt, ʃ_ut_dt, ʃ_Ωt_dt] = AutomaticClenshawCurtisOfTuple(
+      [&interpolate_mean_angles, &t̄](Instant const& t) {
+        auto const [M, u, Ω] = interpolate_mean_angles(t);
+        return std::tuple(M * (t - t̄), u * (t - t̄), Ω * (t - t̄));
       },
       mean_classical_elements_.front().time,
       mean_classical_elements_.back().time,
@@ -5,7 +5,6 @@
 #include <map>
 #include <random>
 #include <string>
-#include <thread>
 #include <utility>
 #include <vector>
 
@@ -17,6 +16,7 @@
 #include "base/file.hpp"
 #include "base/graveyard.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/sign.hpp"
@@ -51,6 +51,7 @@ using namespace principia::base::_bundle;
 using namespace principia::base::_file;
 using namespace principia::base::_graveyard;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_sign;
@@ -1080,7 +1081,7 @@ class TrappistDynamicsTest : public ::testing::Test {
   static double ProlongAndComputeTransitsχ²(SolarSystem<Sky>& system,
                                             std::string& info) {
     static auto* const graveyard =
-        new Graveyard(std::thread::hardware_concurrency());
+        new Graveyard(HardwareConcurrency());
 
     auto ephemeris = system.MakeEphemeris(
         /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
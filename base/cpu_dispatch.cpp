@@ -0,0 +1,72 @@
+#include "base/cpu_dispatch.hpp"
+
+#include <algorithm>
+
+#include "base/cpuid.hpp"
+#include "base/flags.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _cpu_dispatch {
+namespace internal {
+
+using namespace principia::base::_cpuid;
+using namespace principia::base::_flags;
+
+namespace {
+
+InstructionSet DetectInstructionSet() {
+  if (HasCPUFeatures(StructuredExtendedFeatureFlags::AVX512F |
+                     StructuredExtendedFeatureFlags::AVX512DQ |
+                     StructuredExtendedFeatureFlags::AVX512VL |
+                     StructuredExtendedFeatureFlags::AVX2) &&
+      HasCPUFeatures(CPUFeatureFlags::FMA) && OSSupportsAVX512()) {
+    return InstructionSet::AVX512;
+  }
+  if (HasCPUFeatures(StructuredExtendedFeatureFlags::AVX2) &&
+      HasCPUFeatures(CPUFeatureFlags::FMA) && OSSupportsAVX()) {
+    return InstructionSet::AVX2;
+  }
+  return InstructionSet::Generic;
+}
+
+InstructionSet ComputeSupportedInstructionSet() {
+  InstructionSet const detected = DetectInstructionSet();
+  InstructionSet cap = InstructionSet::AVX512;
+  if (Flags::IsPresent("instruction_set", "generic")) {
+    cap = InstructionSet::Generic;
+  } else if (Flags::IsPresent("instruction_set", "avx2")) {
+    cap = InstructionSet::AVX2;
+  }
+  InstructionSet const supported = std::min(detected, cap);
+  LOG(INFO) << "Detected instruction set " << detected << ", using "
+            << supported;
+  return supported;
+}
+
+}  // namespace
+
+InstructionSet SupportedInstructionSet() {
+  static InstructionSet const supported = ComputeSupportedInstructionSet();
+  return supported;
+}
+
+std::ostream& operator<<(std::ostream& out,
+                         InstructionSet const instruction_set) {
+  switch (instruction_set) {
+    case InstructionSet::Generic:
+      return out << "generic";
+    case InstructionSet::AVX2:
+      return out << "AVX2";
+    case InstructionSet::AVX512:
+      return out << "AVX-512";
+  }
+  return out << "unknown instruction set "
+             << static_cast<int>(instruction_set);
+}
+
+}  // namespace internal
+}  // namespace _cpu_dispatch
+}  // namespace base
+}  // namespace principia
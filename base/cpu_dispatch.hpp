@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+
+namespace principia {
+namespace base {
+namespace _cpu_dispatch {
+namespace internal {
+
+// The instruction sets for which a kernel may have an implementation, in
+// increasing order of capability.
+enum class InstructionSet {
+  // SSE3, which we require.
+  Generic = 0,
+  // AVX2 and FMA.
+  AVX2 = 1,
+  // AVX-512 F, DQ and VL, in addition to the above.
+  AVX512 = 2,
+};
+constexpr int number_of_instruction_sets = 3;
+
+// The most capable instruction set supported by the processor and the OS.  It
+// may be capped by the flag |instruction_set|, whose value is one of |generic|,
+// |avx2| or |avx512|, for instance to reproduce on a recent processor a bug
+// observed on an older one.  The result is computed on the first call, so the
+// flag must be set before then.
+InstructionSet SupportedInstructionSet();
+
+std::ostream& operator<<(std::ostream& out, InstructionSet instruction_set);
+
+template<typename Signature>
+class CPUDispatch;
+
+// A kernel with one implementation per instruction set, which selects the most
+// capable one for |SupportedInstructionSet()| the first time it is called.  A
+// kernel that has no distinct implementation for AVX-512 passes a null |avx512|
+// and uses its AVX2 implementation on processors that support AVX-512.  The
+// implementations must be functionally equivalent; callers that rely on
+// reproducibility across processors should additionally ensure that they give
+// bitwise identical results, e.g., by not using FMA.  The constructor is
+// constexpr so that kernels at namespace scope are constant-initialized and may
+// be called during dynamic initialization.  This class is thread-safe.
+template<typename Result, typename... Args>
+class CPUDispatch<Result(Args...)> {
+ public:
+  using Implementation = Result (*)(Args...);
+
+  constexpr CPUDispatch(Implementation generic,
+                        Implementation avx2,
+                        Implementation avx512 = nullptr);
+
+  Result operator()(Args... args) const;
+
+  // The instruction set of the implementation selected by |operator()|.  This
+  // is AVX2, not AVX-512, for a kernel without an AVX-512 implementation.
+  InstructionSet instruction_set() const;
+
+  // The implementation used for the given |instruction_set|, for testing and
+  // benchmarking.  It may only be called if |instruction_set| is supported.
+  Implementation implementation(InstructionSet instruction_set) const;
+
+ private:
+  // The most capable instruction set at or below |instruction_set| for which
+  // this kernel has an implementation.
+  InstructionSet Implemented(InstructionSet instruction_set) const;
+
+  Implementation Select() const;
+
+  Implementation const implementations_[number_of_instruction_sets];
+  // Null until the first call.  Racing calls select the same implementation.
+  mutable std::atomic<Implementation> selected_ = nullptr;
+};
+
+}  // namespace internal
+
+using internal::CPUDispatch;
+using internal::InstructionSet;
+using internal::number_of_instruction_sets;
+using internal::SupportedInstructionSet;
+
+}  // namespace _cpu_dispatch
+}  // namespace base
+}  // namespace principia
+
+#include "base/cpu_dispatch_body.hpp"
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "base/cpu_dispatch.hpp"
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _cpu_dispatch {
+namespace internal {
+
+template<typename Result, typename... Args>
+constexpr CPUDispatch<Result(Args...)>::CPUDispatch(
+    Implementation const generic,
+    Implementation const avx2,
+    Implementation const avx512)
+    : implementations_{generic, avx2, avx512} {}
+
+template<typename Result, typename... Args>
+Result CPUDispatch<Result(Args...)>::operator()(Args... args) const {
+  Implementation implementation = selected_.load(std::memory_order_relaxed);
+  if (implementation == nullptr) {
+    implementation = Select();
+  }
+  return implementation(args...);
+}
+
+template<typename Result, typename... Args>
+InstructionSet CPUDispatch<Result(Args...)>::instruction_set() const {
+  return Implemented(SupportedInstructionSet());
+}
+
+template<typename Result, typename... Args>
+auto CPUDispatch<Result(Args...)>::implementation(
+    InstructionSet const instruction_set) const -> Implementation {
+  CHECK_LE(static_cast<int>(instruction_set),
+           static_cast<int>(SupportedInstructionSet()))
+      << instruction_set;
+  return implementations_[static_cast<int>(Implemented(instruction_set))];
+}
+
+template<typename Result, typename... Args>
+InstructionSet CPUDispatch<Result(Args...)>::Implemented(
+    InstructionSet const instruction_set) const {
+  int i = static_cast<int>(instruction_set);
+  while (implementations_[i] == nullptr) {
+    --i;
+  }
+  return static_cast<InstructionSet>(i);
+}
+
+template<typename Result, typename... Args>
+auto CPUDispatch<Result(Args...)>::Select() const -> Implementation {
+  Implementation const implementation = implementations_[
+      static_cast<int>(Implemented(SupportedInstructionSet()))];
+  selected_.store(implementation, std::memory_order_relaxed);
+  return implementation;
+}
+
+}  // namespace internal
+}  // namespace _cpu_dispatch
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,77 @@
+#include "base/cpu_dispatch.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include "base/cpuid.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::Eq;
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::base::_cpuid;
+
+namespace {
+
+int Generic(int const x) {
+  return x + static_cast<int>(InstructionSet::Generic);
+}
+
+int AVX2(int const x) {
+  return x + static_cast<int>(InstructionSet::AVX2);
+}
+
+int AVX512(int const x) {
+  return x + static_cast<int>(InstructionSet::AVX512);
+}
+
+CPUDispatch<int(int)> const kernel(&Generic, &AVX2, &AVX512);
+CPUDispatch<int(int)> const kernel_without_avx512(&Generic, &AVX2);
+
+}  // namespace
+
+class CPUDispatchTest : public ::testing::Test {};
+
+TEST_F(CPUDispatchTest, Selection) {
+  InstructionSet const supported = SupportedInstructionSet();
+  EXPECT_THAT(kernel.instruction_set(), Eq(supported));
+  EXPECT_THAT(kernel(10), Eq(10 + static_cast<int>(supported)));
+  // The selection is stable.
+  EXPECT_THAT(kernel(20), Eq(20 + static_cast<int>(supported)));
+  EXPECT_THAT(kernel.implementation(InstructionSet::Generic)(10), Eq(10));
+}
+
+TEST_F(CPUDispatchTest, WithoutAVX512) {
+  InstructionSet const supported = SupportedInstructionSet();
+  InstructionSet const expected = std::min(supported, InstructionSet::AVX2);
+  EXPECT_THAT(kernel_without_avx512.instruction_set(), Eq(expected));
+  EXPECT_THAT(kernel_without_avx512(10), Eq(10 + static_cast<int>(expected)));
+  EXPECT_THAT(kernel_without_avx512.implementation(supported)(10),
+              Eq(10 + static_cast<int>(expected)));
+}
+
+TEST_F(CPUDispatchTest, Detection) {
+  InstructionSet const supported = SupportedInstructionSet();
+  if (supported >= InstructionSet::AVX2) {
+    EXPECT_TRUE(HasCPUFeatures(StructuredExtendedFeatureFlags::AVX2));
+    EXPECT_TRUE(HasCPUFeatures(CPUFeatureFlags::FMA));
+    EXPECT_TRUE(OSSupportsAVX());
+  }
+  if (supported >= InstructionSet::AVX512) {
+    EXPECT_TRUE(HasCPUFeatures(StructuredExtendedFeatureFlags::AVX512F));
+    EXPECT_TRUE(OSSupportsAVX512());
+  }
+}
+
+TEST_F(CPUDispatchTest, Output) {
+  std::stringstream s;
+  s << InstructionSet::Generic << " " << InstructionSet::AVX2 << " "
+    << InstructionSet::AVX512;
+  EXPECT_THAT(s.str(), Eq("generic AVX2 AVX-512"));
+}
+
+}  // namespace base
+}  // namespace principia
@@ -1,9 +1,11 @@
 #include "base/cpuid.hpp"
 
+#include <cstring>
 #include <string>
 
 #include "base/macros.hpp"
 #if PRINCIPIA_COMPILER_MSVC
+#include <immintrin.h>
 #include <intrin.h>
 #else
 #include <cpuid.h>
@@ -36,6 +38,31 @@ CPUIDResult CPUID(std::uint32_t const eax, std::uint32_t const ecx) {
 #endif
 }
 
+// The value of the extended control register XCR0.  Must only be called if the
+// OSXSAVE flag is set.
+std::uint64_t XCR0() {
+#if PRINCIPIA_COMPILER_MSVC
+  return _xgetbv(0);
+#else
+  std::uint32_t eax;
+  std::uint32_t edx;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));  // NOLINT
+  return static_cast<std::uint64_t>(edx) << 32 | eax;
+#endif
+}
+
+// The bits of XCR0 that must be set for the OS to support a given set of
+// registers.
+constexpr std::uint64_t xcr0_sse = 1 << 1;
+constexpr std::uint64_t xcr0_avx = 1 << 2;
+constexpr std::uint64_t xcr0_opmask = 1 << 5;
+constexpr std::uint64_t xcr0_zmm_hi256 = 1 << 6;
+constexpr std::uint64_t xcr0_hi16_zmm = 1 << 7;
+
+bool XCR0Has(std::uint64_t const bits) {
+  return HasCPUFeatures(CPUFeatureFlags::OSXSAVE) && (XCR0() & bits) == bits;
+}
+
 std::string CPUVendorIdentificationString() {
   auto const leaf_0 = CPUID(0, 0);
   std::string result(12, '\0');
@@ -58,6 +85,32 @@ bool HasCPUFeatures(CPUFeatureFlags const flags) {
              static_cast<std::uint64_t>(flags)) == flags;
 }
 
+StructuredExtendedFeatureFlags operator|(
+    StructuredExtendedFeatureFlags const left,
+    StructuredExtendedFeatureFlags const right) {
+  return static_cast<StructuredExtendedFeatureFlags>(
+      static_cast<std::uint32_t>(left) | static_cast<std::uint32_t>(right));
+}
+
+bool HasCPUFeatures(StructuredExtendedFeatureFlags const flags) {
+  auto const leaf_0 = CPUID(0, 0);
+  if (leaf_0.eax < 7) {
+    return false;
+  }
+  auto const leaf_7 = CPUID(7, 0);
+  return static_cast<StructuredExtendedFeatureFlags>(
+             leaf_7.ebx & static_cast<std::uint32_t>(flags)) == flags;
+}
+
+bool OSSupportsAVX() {
+  return XCR0Has(xcr0_sse | xcr0_avx);
+}
+
+bool OSSupportsAVX512() {
+  return XCR0Has(xcr0_sse | xcr0_avx |
+                 xcr0_opmask | xcr0_zmm_hi256 | xcr0_hi16_zmm);
+}
+
 }  // namespace internal
 }  // namespace _cpuid
 }  // namespace base
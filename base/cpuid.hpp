@@ -25,10 +25,11 @@ enum class CPUFeatureFlags : std::uint64_t {
   SSE = edx_bit << 25,   // Streaming SIMD Extensions.
   SSE2 = edx_bit << 26,  // Streaming SIMD Extensions 2.
   // Table 3-10.
-  SSE3 = ecx_bit << 0,     // Streaming SIMD Extensions 3.
-  FMA = ecx_bit << 12,     // Fused Multiply Add.
-  SSE4_1 = ecx_bit << 19,  // Streaming SIMD Extensions 4.1.
-  AVX = ecx_bit << 28,     // Advanced Vector eXtensions.
+  SSE3 = ecx_bit << 0,      // Streaming SIMD Extensions 3.
+  FMA = ecx_bit << 12,      // Fused Multiply Add.
+  SSE4_1 = ecx_bit << 19,   // Streaming SIMD Extensions 4.1.
+  OSXSAVE = ecx_bit << 27,  // XSAVE enabled by the OS.
+  AVX = ecx_bit << 28,      // Advanced Vector eXtensions.
 };
 
 // Bitwise or of feature flags; the result represents the union of all features
@@ -38,11 +39,44 @@ CPUFeatureFlags operator|(CPUFeatureFlags left, CPUFeatureFlags right);
 // Whether the CPU has all features listed in |flags|.
 bool HasCPUFeatures(CPUFeatureFlags flags);
 
+// Leaf 7, subleaf 0.
+// We represent feature flags as EBX.
+enum class StructuredExtendedFeatureFlags : std::uint32_t {
+  // Table 3-8.
+  AVX2 = 1u << 5,       // Advanced Vector eXtensions 2.
+  AVX512F = 1u << 16,   // AVX-512 Foundation.
+  AVX512DQ = 1u << 17,  // AVX-512 Doubleword and Quadword Instructions.
+  AVX512VL = 1u << 31,  // AVX-512 Vector Length Extensions.
+};
+
+// Bitwise or of feature flags; the result represents the union of all features
+// in |left| and |right|.
+StructuredExtendedFeatureFlags operator|(StructuredExtendedFeatureFlags left,
+                                         StructuredExtendedFeatureFlags right);
+
+// Whether the CPU has all features listed in |flags|.  Returns false if the CPU
+// does not support leaf 7.
+bool HasCPUFeatures(StructuredExtendedFeatureFlags flags);
+
+// The CPU flags only tell us what the processor can do; the OS must also save
+// the corresponding registers on context switches, which is reported by XCR0.
+// See Volume 1, sections 14.3 and 15.2.
+
+// Whether the OS saves the YMM registers.  Required for AVX, AVX2 and FMA.
+bool OSSupportsAVX();
+
+// Whether the OS saves the YMM and ZMM registers and the opmask registers.
+// Required for AVX-512.
+bool OSSupportsAVX512();
+
 }  // namespace internal
 
 using internal::CPUFeatureFlags;
 using internal::CPUVendorIdentificationString;
 using internal::HasCPUFeatures;
+using internal::OSSupportsAVX;
+using internal::OSSupportsAVX512;
+using internal::StructuredExtendedFeatureFlags;
 
 }  // namespace _cpuid
 }  // namespace base
@@ -32,5 +32,22 @@ TEST_F(CPUIDTest, CPUFeatureFlags) {
                               CPUFeatureFlags::PSN));
 }
 
+TEST_F(CPUIDTest, StructuredExtendedFeatureFlags) {
+  // The AVX-512 foundation implies AVX2, which implies AVX.
+  if (HasCPUFeatures(StructuredExtendedFeatureFlags::AVX512F)) {
+    EXPECT_TRUE(HasCPUFeatures(StructuredExtendedFeatureFlags::AVX2));
+  }
+  if (HasCPUFeatures(StructuredExtendedFeatureFlags::AVX2)) {
+    EXPECT_TRUE(HasCPUFeatures(CPUFeatureFlags::AVX));
+  }
+  // Likewise for the support by the OS.
+  if (OSSupportsAVX512()) {
+    EXPECT_TRUE(OSSupportsAVX());
+  }
+  if (OSSupportsAVX()) {
+    EXPECT_TRUE(HasCPUFeatures(CPUFeatureFlags::OSXSAVE));
+  }
+}
+
 }  // namespace base
 }  // namespace principia
@@ -50,6 +50,14 @@ std::multimap<std::string, std::string>& Flags::flags() {
   return *flags;
 }
 
+ScopedFlag::ScopedFlag(std::string_view const name,
+                       std::string_view const value)
+    : it_(Flags::flags().emplace(std::string(name), std::string(value))) {}
+
+ScopedFlag::~ScopedFlag() {
+  Flags::flags().erase(it_);
+}
+
 }  // namespace internal
 }  // namespace _flags
 }  // namespace base
@@ -34,11 +34,27 @@ class Flags {
 
  private:
   static std::multimap<std::string, std::string>& flags();
+
+  friend class ScopedFlag;
+};
+
+// Sets a flag with the given |name| and |value| for the lifetime of this
+// object.  Useful in tests.  The flags must not be cleared during that
+// lifetime.
+class ScopedFlag final {
+ public:
+  ScopedFlag(std::string_view name, std::string_view value);
+  ScopedFlag(ScopedFlag const&) = delete;
+  ~ScopedFlag();
+
+ private:
+  std::multimap<std::string, std::string>::iterator const it_;
 };
 
 }  // namespace internal
 
 using internal::Flags;
+using internal::ScopedFlag;
 
 }  // namespace _flags
 }  // namespace base
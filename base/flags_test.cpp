@@ -31,5 +31,19 @@ TEST(FlagsTest, Basics) {
   EXPECT_THAT(Flags::Values("decimal"), IsEmpty());
 }
 
+TEST(FlagsTest, Scoped) {
+  Flags::Clear();
+  Flags::Set("zfp", "yes");
+  {
+    ScopedFlag const hex("hex", "");
+    ScopedFlag const zfp("zfp", "no");
+    EXPECT_TRUE(Flags::IsPresent("hex"));
+    EXPECT_THAT(Flags::Values("zfp"), ElementsAre("no", "yes"));
+  }
+  EXPECT_FALSE(Flags::IsPresent("hex"));
+  EXPECT_THAT(Flags::Values("zfp"), ElementsAre("yes"));
+  Flags::Clear();
+}
+
 }  // namespace base
 }  // namespace principia
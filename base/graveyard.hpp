@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 
+#include "absl/synchronization/mutex.h"
 #include "base/thread_pool.hpp"
 
 namespace principia {
@@ -12,14 +14,34 @@ namespace internal {
 
 using namespace principia::base::_thread_pool;
 
+// A graveyard destroys the objects that are buried in it asynchronously, so
+// that the destruction of large objects doesn't block the caller.  At most
+// |max_backlog| objects may be waiting for their destruction: beyond that, the
+// objects are destroyed synchronously by |Bury|.  This class is thread-safe.
 class Graveyard {
  public:
-  explicit Graveyard(std::int64_t number_of_threads);
+  explicit Graveyard(
+      std::int64_t number_of_threads,
+      std::int64_t max_backlog = std::numeric_limits<std::int64_t>::max());
+
+  // Waits until all the buried objects have been destroyed.
+  ~Graveyard();
 
   template<typename T>
   void Bury(std::unique_ptr<T> t);
 
+  // Waits until all the objects buried so far have been destroyed.
+  void Flush();
+
+  // The number of objects that are waiting for their destruction.
+  std::int64_t backlog() const;
+
  private:
+  std::int64_t const max_backlog_;
+  mutable absl::Mutex lock_;
+  std::int64_t backlog_ GUARDED_BY(lock_) = 0;
+  // Declared last so that its threads are joined before the other members are
+  // destroyed.
   ThreadPool<void> gravedigger_;
 };
 
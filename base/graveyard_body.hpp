@@ -7,18 +7,48 @@ namespace base {
 namespace _graveyard {
 namespace internal {
 
-inline Graveyard::Graveyard(std::int64_t const number_of_threads)
-    : gravedigger_(number_of_threads) {}
+inline Graveyard::Graveyard(std::int64_t const number_of_threads,
+                            std::int64_t const max_backlog)
+    : max_backlog_(max_backlog),
+      gravedigger_(number_of_threads) {}
+
+inline Graveyard::~Graveyard() {
+  // The pending calls of the |gravedigger_| are dropped when it is destroyed,
+  // which would leak their coffins.
+  Flush();
+}
 
 template<typename T>
 void Graveyard::Bury(std::unique_ptr<T> t) {
+  {
+    absl::MutexLock l(&lock_);
+    if (backlog_ >= max_backlog_) {
+      // The gravedigger is falling behind, the object is destroyed here, on
+      // return, without holding the lock.
+      return;
+    }
+    ++backlog_;
+  }
   // TODO(egg): Investigate the possibility of a mutable lambda with
   // std::packaged_task in the ThreadPool instead of std::function.
-  gravedigger_.Add([coffin = t.release()]() {
+  gravedigger_.Add([this, coffin = t.release()]() {
     delete coffin;
+    absl::MutexLock l(&lock_);
+    --backlog_;
   });
 }
 
+inline void Graveyard::Flush() {
+  absl::MutexLock l(&lock_);
+  auto const empty = [this]() { return backlog_ == 0; };
+  lock_.Await(absl::Condition(&empty));
+}
+
+inline std::int64_t Graveyard::backlog() const {
+  absl::ReaderMutexLock l(&lock_);
+  return backlog_;
+}
+
 }  // namespace internal
 }  // namespace _graveyard
 }  // namespace base
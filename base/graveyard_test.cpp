@@ -0,0 +1,73 @@
+#include "base/graveyard.hpp"
+
+#include <memory>
+#include <thread>
+
+#include "absl/synchronization/notification.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using namespace principia::base::_graveyard;
+
+class GraveyardTest : public ::testing::Test {
+ protected:
+  // Records the thread that destroys it, after waiting for |release| if it is
+  // not null.
+  class Corpse {
+   public:
+    Corpse(std::thread::id& destroyer, absl::Notification* const release)
+        : destroyer_(destroyer),
+          release_(release) {}
+
+    ~Corpse() {
+      if (release_ != nullptr) {
+        release_->WaitForNotification();
+      }
+      destroyer_ = std::this_thread::get_id();
+    }
+
+   private:
+    std::thread::id& destroyer_;
+    absl::Notification* const release_;
+  };
+};
+
+TEST_F(GraveyardTest, Flush) {
+  Graveyard graveyard(/*number_of_threads=*/2);
+  std::thread::id destroyer1;
+  std::thread::id destroyer2;
+  graveyard.Bury(std::make_unique<Corpse>(destroyer1, /*release=*/nullptr));
+  graveyard.Bury(std::make_unique<Corpse>(destroyer2, /*release=*/nullptr));
+  graveyard.Flush();
+  EXPECT_EQ(0, graveyard.backlog());
+  EXPECT_NE(std::thread::id(), destroyer1);
+  EXPECT_NE(std::this_thread::get_id(), destroyer1);
+  EXPECT_NE(std::thread::id(), destroyer2);
+  EXPECT_NE(std::this_thread::get_id(), destroyer2);
+}
+
+TEST_F(GraveyardTest, BoundedBacklog) {
+  Graveyard graveyard(/*number_of_threads=*/1, /*max_backlog=*/1);
+  absl::Notification release;
+  std::thread::id destroyer1;
+  std::thread::id destroyer2;
+  graveyard.Bury(std::make_unique<Corpse>(destroyer1, &release));
+  EXPECT_EQ(1, graveyard.backlog());
+
+  // The backlog is full, so this corpse is destroyed synchronously.
+  graveyard.Bury(std::make_unique<Corpse>(destroyer2, /*release=*/nullptr));
+  EXPECT_EQ(std::this_thread::get_id(), destroyer2);
+  EXPECT_EQ(1, graveyard.backlog());
+
+  release.Notify();
+  graveyard.Flush();
+  EXPECT_EQ(0, graveyard.backlog());
+  EXPECT_NE(std::thread::id(), destroyer1);
+  EXPECT_NE(std::this_thread::get_id(), destroyer1);
+}
+
+}  // namespace base
+}  // namespace principia
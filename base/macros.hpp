@@ -129,6 +129,22 @@ inline void noreturn() { std::exit(0); }
 #define PRINCIPIA_USE_SSE3_INTRINSICS !_DEBUG
 #define PRINCIPIA_USE_FMA_IF_AVAILABLE !_DEBUG
 
+// Used to compile a function for a more recent instruction set than the one of
+// the translation unit, for dispatch at runtime by |CPUDispatch|.  MSVC emits
+// the AVX2 and AVX-512 intrinsics irrespective of the /arch option.
+#if PRINCIPIA_COMPILER_CLANG    ||  \
+    PRINCIPIA_COMPILER_CLANG_CL ||  \
+    PRINCIPIA_COMPILER_GCC
+#  define PRINCIPIA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#  define PRINCIPIA_TARGET_AVX512 \
+       __attribute__((target("avx512f,avx512dq,avx512vl,avx2,fma")))
+#elif PRINCIPIA_COMPILER_MSVC
+#  define PRINCIPIA_TARGET_AVX2
+#  define PRINCIPIA_TARGET_AVX512
+#else
+#  error "What compiler is this?"
+#endif
+
 // Set this to 1 to test analytical series based on piecewise Poisson series.
 #define PRINCIPIA_CONTINUOUS_TRAJECTORY_SUPPORTS_PIECEWISE_POISSON_SERIES 0
 
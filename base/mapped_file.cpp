@@ -0,0 +1,103 @@
+#include "base/mapped_file.hpp"
+
+#include "base/macros.hpp"
+#include "glog/logging.h"
+#if OS_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace principia {
+namespace base {
+namespace _mapped_file {
+namespace internal {
+
+#if OS_WIN
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+  // Allow the file to be written while it is mapped, e.g., a journal that is
+  // still being recorded.
+  file_ = CreateFileW(path.c_str(),
+                      GENERIC_READ,
+                      FILE_SHARE_READ | FILE_SHARE_WRITE,
+                      /*lpSecurityAttributes=*/nullptr,
+                      OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL,
+                      /*hTemplateFile=*/nullptr);
+  CHECK(file_ != INVALID_HANDLE_VALUE)
+      << path << ": error " << GetLastError();
+  LARGE_INTEGER size;
+  CHECK(GetFileSizeEx(file_, &size)) << path << ": error " << GetLastError();
+  size_ = size.QuadPart;
+  // An empty file cannot be mapped.
+  if (size_ == 0) {
+    return;
+  }
+  mapping_ = CreateFileMappingW(file_,
+                                /*lpFileMappingAttributes=*/nullptr,
+                                PAGE_READONLY,
+                                /*dwMaximumSizeHigh=*/0,
+                                /*dwMaximumSizeLow=*/0,
+                                /*lpName=*/nullptr);
+  CHECK(mapping_ != nullptr) << path << ": error " << GetLastError();
+  data_ = static_cast<char const*>(MapViewOfFile(mapping_,
+                                                 FILE_MAP_READ,
+                                                 /*dwFileOffsetHigh=*/0,
+                                                 /*dwFileOffsetLow=*/0,
+                                                 /*dwNumberOfBytesToMap=*/0));
+  CHECK(data_ != nullptr) << path << ": error " << GetLastError();
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_ != nullptr) {
+    CloseHandle(mapping_);
+  }
+  CloseHandle(file_);
+}
+
+#else
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+  int const descriptor = open(path.c_str(), O_RDONLY);
+  PCHECK(descriptor >= 0) << path;
+  struct stat status;
+  PCHECK(fstat(descriptor, &status) == 0) << path;
+  size_ = status.st_size;
+  // An empty file cannot be mapped.
+  if (size_ > 0) {
+    void* const data = mmap(/*addr=*/nullptr,
+                            size_,
+                            PROT_READ,
+                            MAP_PRIVATE,
+                            descriptor,
+                            /*offset=*/0);
+    PCHECK(data != MAP_FAILED) << path;
+    data_ = static_cast<char const*>(data);
+  }
+  // The mapping remains valid after the descriptor is closed.
+  close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+#endif
+
+std::string_view MappedFile::contents() const {
+  return std::string_view(data_, size_);
+}
+
+}  // namespace internal
+}  // namespace _mapped_file
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include "base/macros.hpp"
+
+namespace principia {
+namespace base {
+namespace _mapped_file {
+namespace internal {
+
+// A read-only mapping of the contents of a file in memory.  The contents are
+// those of the file at construction; they are not guaranteed to reflect later
+// changes to the file.  Pages are only read when they are accessed, so mapping
+// a large file is cheap.  The contents may be read concurrently.
+class MappedFile final {
+ public:
+  // Fails if the file cannot be opened or mapped.
+  explicit MappedFile(std::filesystem::path const& path);
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  std::string_view contents() const;
+
+ private:
+  char const* data_ = nullptr;
+  std::int64_t size_ = 0;
+#if OS_WIN
+  // The native handles of the file and of its mapping.
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#endif
+};
+
+}  // namespace internal
+
+using internal::MappedFile;
+
+}  // namespace _mapped_file
+}  // namespace base
+}  // namespace principia
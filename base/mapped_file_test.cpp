@@ -0,0 +1,59 @@
+#include "base/mapped_file.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using namespace principia::base::_mapped_file;
+
+class MappedFileTest : public testing::Test {
+ protected:
+  MappedFileTest()
+      : path_(std::string(
+                  testing::UnitTest::GetInstance()->current_test_info()->name()) +
+              ".mapped") {}
+
+  ~MappedFileTest() override {
+    std::filesystem::remove(path_);
+  }
+
+  void Write(std::string const& contents) {
+    std::ofstream stream(path_, std::ios::out | std::ios::binary);
+    stream << contents;
+  }
+
+  std::filesystem::path const path_;
+};
+
+TEST_F(MappedFileTest, Contents) {
+  // Include a null character and non-ASCII bytes.
+  std::string const contents("journal\n\0\xFF\r\n", 12);
+  Write(contents);
+  MappedFile const file(path_);
+  EXPECT_EQ(contents, file.contents());
+}
+
+TEST_F(MappedFileTest, Empty) {
+  Write("");
+  MappedFile const file(path_);
+  EXPECT_TRUE(file.contents().empty());
+}
+
+TEST_F(MappedFileTest, Large) {
+  std::string contents;
+  for (int i = 0; i < 100'000; ++i) {
+    contents += std::to_string(i) + "\n";
+  }
+  Write(contents);
+  MappedFile const file(path_);
+  ASSERT_EQ(contents.size(), file.contents().size());
+  EXPECT_EQ(contents, file.contents());
+}
+
+}  // namespace base
+}  // namespace principia
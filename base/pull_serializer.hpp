@@ -2,15 +2,18 @@
 
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "base/array.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "gipfeli/compression.h"
 #include "google/protobuf/message.h"
 #include "google/protobuf/io/zero_copy_stream.h"
@@ -22,6 +25,7 @@ namespace internal {
 
 using namespace principia::base::_array;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 
 using ::google::compression::Compressor;
 
@@ -72,6 +76,17 @@ class PullSerializer final {
   PullSerializer(int chunk_size,
                  int number_of_chunks,
                  std::unique_ptr<Compressor> compressor);
+  // Same as above, but the chunks are compressed concurrently on |thread_pool|
+  // while the serialization proceeds.  Compressors are not thread-safe, so
+  // |compressor_factory| is used to create one compressor per chunk.  The
+  // output is identical to that produced with a single compressor.  This class
+  // uses at most |number_of_chunks * (2 * compressed_chunk_size + O(1)) + O(1)|
+  // bytes, in addition to the memory used by the compressors.
+  PullSerializer(
+      int chunk_size,
+      int number_of_chunks,
+      std::function<std::unique_ptr<Compressor>()> const& compressor_factory,
+      not_null<ThreadPool<Array<std::uint8_t>>*> thread_pool);
   ~PullSerializer();
 
   // Starts the serializer, which will proceed to serialize |message|.  This
@@ -97,13 +112,25 @@ class PullSerializer final {
   // underlying |DelegatingArrayOutputStream|.
   Array<std::uint8_t> Push(Array<std::uint8_t> bytes);
 
+  // Compresses the chunk |bytes| of |data_| into the corresponding chunk of
+  // |compressed_data_| using the corresponding compressor.  Used when
+  // compressing in parallel.
+  Array<std::uint8_t> CompressChunk(Array<std::uint8_t> bytes);
+
   // |owned_message_| is null if this object doesn't own the message.
   // |message_| is non-null after Start.
   std::unique_ptr<google::protobuf::Message const> owned_message_;
   google::protobuf::Message const* message_ = nullptr;
 
+  // Null when compressing in parallel.
   std::unique_ptr<Compressor> const compressor_;
 
+  // Only set when compressing in parallel, in which case |compressors_[i]| is
+  // used for the |i|th chunk of |data_|.  There is at most one compression of a
+  // given chunk in progress at any time.
+  ThreadPool<Array<std::uint8_t>>* const thread_pool_ = nullptr;
+  std::vector<not_null<std::unique_ptr<Compressor>>> const compressors_;
+
   // The chunk size passed at construction.  The stream outputs chunks of that
   // size.
   int const chunk_size_;
@@ -124,6 +151,11 @@ class PullSerializer final {
   std::unique_ptr<std::uint8_t[]> data_;
   DelegatingArrayOutputStream stream_;
 
+  // When compressing in parallel, the |i|th chunk of |data_| is compressed into
+  // the |i|th chunk of this array.  The result stays valid until the chunk of
+  // |data_| is freed and filled again.
+  std::unique_ptr<std::uint8_t[]> compressed_data_;
+
   // The thread doing the actual serialization.
   std::unique_ptr<std::thread> thread_;
 
@@ -140,6 +172,11 @@ class PullSerializer final {
   // ready to be returned by |Pull|.  That includes the chunk currently being
   // filled by the stream.
   std::queue<not_null<std::uint8_t*>> free_ GUARDED_BY(lock_);
+
+  // When compressing in parallel, the compressions of the nonempty chunks of
+  // |queue_| that have not yet been handed over to the caller, in the same
+  // order.
+  std::queue<std::future<Array<std::uint8_t>>> compressions_ GUARDED_BY(lock_);
 };
 
 }  // namespace internal
@@ -63,6 +63,18 @@ inline std::int64_t DelegatingArrayOutputStream::ByteCount() const {
   return byte_count_;
 }
 
+// Returns |number_of_compressors| compressors produced by |compressor_factory|.
+inline std::vector<not_null<std::unique_ptr<Compressor>>> MakeCompressors(
+    std::function<std::unique_ptr<Compressor>()> const& compressor_factory,
+    int const number_of_compressors) {
+  std::vector<not_null<std::unique_ptr<Compressor>>> compressors;
+  compressors.reserve(number_of_compressors);
+  for (int i = 0; i < number_of_compressors; ++i) {
+    compressors.push_back(check_not_null(compressor_factory()));
+  }
+  return compressors;
+}
+
 inline PullSerializer::PullSerializer(int const chunk_size,
                                       int const number_of_chunks,
                                       std::unique_ptr<Compressor> compressor)
@@ -93,10 +105,46 @@ inline PullSerializer::PullSerializer(int const chunk_size,
       data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0));
 }
 
+inline PullSerializer::PullSerializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    std::function<std::unique_ptr<Compressor>()> const& compressor_factory,
+    not_null<ThreadPool<Array<std::uint8_t>>*> const thread_pool)
+    : thread_pool_(thread_pool),
+      compressors_(MakeCompressors(compressor_factory, number_of_chunks)),
+      chunk_size_(chunk_size),
+      compressed_chunk_size_(
+          compressors_.front()->MaxCompressedLength(chunk_size_)),
+      number_of_chunks_(number_of_chunks),
+      number_of_compression_chunks_(0),
+      data_(std::make_unique<std::uint8_t[]>(compressed_chunk_size_ *
+                                             number_of_chunks_)),
+      stream_(Array<std::uint8_t>(data_.get(), chunk_size_),
+              std::bind(&PullSerializer::Push, this, _1)),
+      compressed_data_(std::make_unique<std::uint8_t[]>(
+          compressed_chunk_size_ * number_of_chunks_)) {
+  // Check the compatibility of the wait conditions in Push and Pull.
+  CHECK_GT(number_of_chunks_ - 1, 1);
+
+  // The chunks are set up as in the sequential case.  The compression doesn't
+  // need a reserved chunk since it happens in |compressed_data_|.
+  for (int i = 0; i < number_of_chunks_ - 1; ++i) {
+    free_.push(data_.get() + i * compressed_chunk_size_);
+  }
+  queue_.push(Array<std::uint8_t>(
+      data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0));
+}
+
 inline PullSerializer::~PullSerializer() {
   if (thread_ != nullptr) {
     thread_->join();
   }
+  // Don't let the compressions outlive this object.
+  absl::MutexLock l(&lock_);
+  while (!compressions_.empty()) {
+    compressions_.front().wait();
+    compressions_.pop();
+  }
 }
 
 inline void PullSerializer::Start(
@@ -125,6 +173,7 @@ inline void PullSerializer::Start(
 
 inline Array<std::uint8_t> PullSerializer::Pull() {
   Array<std::uint8_t> result;
+  std::future<Array<std::uint8_t>> compression;
   {
     absl::MutexLock l(&lock_);
 
@@ -138,6 +187,16 @@ inline Array<std::uint8_t> PullSerializer::Pull() {
     queue_.pop();
     result = queue_.front();
     CHECK_EQ(number_of_chunks_, queue_.size() + free_.size());
+    if (thread_pool_ != nullptr && result.size > 0) {
+      CHECK(!compressions_.empty());
+      compression = std::move(compressions_.front());
+      compressions_.pop();
+    }
+  }
+  // Wait for the compression outside of the lock so as to not block the
+  // serialization.
+  if (compression.valid()) {
+    result = compression.get();
   }
   return result;
 }
@@ -165,6 +224,13 @@ inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
       bytes = sink.array();
     }
   }
+  // When compressing in parallel, start the compression right away, it will
+  // proceed while the stream fills the next chunk.
+  std::future<Array<std::uint8_t>> compression;
+  if (bytes.size > 0 && thread_pool_ != nullptr) {
+    compression = thread_pool_->Add(
+        [this, bytes]() { return CompressChunk(bytes); });
+  }
   {
     absl::MutexLock l(&lock_);
 
@@ -178,6 +244,9 @@ inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
     lock_.Await(absl::Condition(&queue_has_room));
 
     queue_.emplace(bytes.data, bytes.size);
+    if (compression.valid()) {
+      compressions_.push(std::move(compression));
+    }
     CHECK_LE(2 + number_of_compression_chunks_, free_.size());
     CHECK_EQ(free_.front(), bytes.data);
     free_.pop();
@@ -187,6 +256,17 @@ inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
   return result;
 }
 
+inline Array<std::uint8_t> PullSerializer::CompressChunk(
+    Array<std::uint8_t> const bytes) {
+  std::int64_t const index = (bytes.data - data_.get()) / compressed_chunk_size_;
+  ArraySource<std::uint8_t> source(bytes);
+  ArraySink<std::uint8_t> sink(Array<std::uint8_t>(
+      compressed_data_.get() + index * compressed_chunk_size_,
+      compressed_chunk_size_));
+  compressors_[index]->CompressStream(&source, &sink);
+  return sink.array();
+}
+
 }  // namespace internal
 }  // namespace _pull_serializer
 }  // namespace base
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "base/thread_pool.hpp"
 #include "gipfeli/compression.h"
 #include "gipfeli/gipfeli.h"
 #include "gmock/gmock.h"
@@ -24,6 +25,7 @@ using ::testing::ElementsAreArray;
 using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::base::_pull_serializer;
+using namespace principia::base::_thread_pool;
 
 namespace this_internal = _pull_serializer::internal;
 
@@ -169,6 +171,53 @@ TEST_F(PullSerializerTest, SerializationGipfeli) {
   EXPECT_EQ(uncompressed1, uncompressed2);
 }
 
+TEST_F(PullSerializerTest, SerializationGipfeliParallel) {
+  std::vector<std::string> sequential_chunks;
+  std::vector<std::string> parallel_chunks;
+  {
+    auto const compressed_pull_serializer =
+        std::make_unique<PullSerializer>(
+            chunk_size,
+            /*number_of_chunks=*/4,
+            google::compression::NewGipfeliCompressor());
+    compressed_pull_serializer->Start(BuildTrajectory());
+    for (;;) {
+      Array<std::uint8_t> const bytes = compressed_pull_serializer->Pull();
+      if (bytes.size == 0) {
+        break;
+      }
+      sequential_chunks.emplace_back(
+          reinterpret_cast<char const*>(bytes.data),
+          static_cast<std::size_t>(bytes.size));
+    }
+  }
+  {
+    // Use fewer chunks than in the sequential case since no chunk is reserved
+    // for compression.
+    ThreadPool<Array<std::uint8_t>> thread_pool(/*pool_size=*/4);
+    auto const compressed_pull_serializer =
+        std::make_unique<PullSerializer>(
+            chunk_size,
+            /*number_of_chunks=*/3,
+            []() { return google::compression::NewGipfeliCompressor(); },
+            &thread_pool);
+    compressed_pull_serializer->Start(BuildTrajectory());
+    for (;;) {
+      Array<std::uint8_t> const bytes = compressed_pull_serializer->Pull();
+      if (bytes.size == 0) {
+        break;
+      }
+      parallel_chunks.emplace_back(
+          reinterpret_cast<char const*>(bytes.data),
+          static_cast<std::size_t>(bytes.size));
+    }
+  }
+
+  // The chunks are compressed independently, so they are identical.
+  EXPECT_LT(1, sequential_chunks.size());
+  EXPECT_THAT(parallel_chunks, ElementsAreArray(sequential_chunks));
+}
+
 TEST_F(PullSerializerTest, SerializationThreading) {
   DiscreteTrajectory read_trajectory;
   auto const trajectory = BuildTrajectory();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <future>
@@ -14,12 +15,18 @@ namespace base {
 namespace _thread_pool {
 namespace internal {
 
+// Returns the number of threads that the hardware can run concurrently, or 1
+// if it cannot be determined.  Use this rather than
+// |std::thread::hardware_concurrency()|, which may return 0, to size a pool.
+std::int64_t HardwareConcurrency();
+
 // A pool of threads that are created at construction and to which functions can
 // be added for asynchronous execution.  This class is thread-safe.
 template<typename T>
 class ThreadPool final {
  public:
-  // Constructs a pool with the given number of threads.
+  // Constructs a pool with the given number of threads, which must be
+  // positive.
   explicit ThreadPool(std::int64_t pool_size);
 
   ~ThreadPool();
@@ -50,6 +57,7 @@ class ThreadPool final {
 
 }  // namespace internal
 
+using internal::HardwareConcurrency;
 using internal::ThreadPool;
 
 }  // namespace _thread_pool
@@ -2,11 +2,20 @@
 
 #include "base/thread_pool.hpp"
 
+#include <algorithm>
+#include <thread>
+
+#include "glog/logging.h"
+
 namespace principia {
 namespace base {
 namespace _thread_pool {
 namespace internal {
 
+inline std::int64_t HardwareConcurrency() {
+  return std::max<std::int64_t>(1, std::thread::hardware_concurrency());
+}
+
 // A helper function that is specialized for void because void is not really a
 // type.
 template<typename T>
@@ -24,6 +33,8 @@ inline void ExecuteAndSetValue<void>(std::function<void()> const& function,
 
 template<typename T>
 ThreadPool<T>::ThreadPool(std::int64_t const pool_size) {
+  // A pool without threads would never execute the calls.
+  CHECK_LT(0, pool_size);
   for (std::int64_t i = 0; i < pool_size; ++i) {
     threads_.emplace_back(std::bind(&ThreadPool::DequeueCallAndExecute, this));
   }
@@ -13,8 +13,8 @@ using namespace principia::base::_thread_pool;
 
 class ThreadPoolTest : public ::testing::Test {
  protected:
-  ThreadPoolTest() : pool_(std::thread::hardware_concurrency()) {
-    LOG(ERROR) << "Concurrency is " << std::thread::hardware_concurrency();
+  ThreadPoolTest() : pool_(HardwareConcurrency()) {
+    LOG(ERROR) << "Concurrency is " << HardwareConcurrency();
   }
 
   ThreadPool<void> pool_;
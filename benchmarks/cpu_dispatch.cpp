@@ -0,0 +1,95 @@
+// .\Release\x64\benchmarks.exe --benchmark_filter=CPUDispatch --benchmark_repetitions=5  // NOLINT(whitespace/line_length)
+
+#include "base/cpu_dispatch.hpp"
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "physics/gravity_kernel.hpp"
+
+namespace principia {
+namespace base {
+
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::physics::_gravity_kernel;
+
+namespace {
+
+std::vector<double> RandomVector(std::int64_t const n,
+                                 double const min,
+                                 double const max) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> distribution(min, max);
+  std::vector<double> result;
+  for (std::int64_t i = 0; i < n; ++i) {
+    result.push_back(distribution(random));
+  }
+  return result;
+}
+
+// Returns false, after marking the benchmark as skipped, if the instruction set
+// given by the first argument of the benchmark is not supported.  Otherwise,
+// labels the benchmark with the instruction set, indicating whether it is the
+// one selected by the dispatch.
+template<typename Signature>
+bool CheckAndLabelInstructionSet(CPUDispatch<Signature> const& kernel,
+                                 benchmark::State& state) {
+  auto const instruction_set = static_cast<InstructionSet>(state.range(0));
+  if (instruction_set > SupportedInstructionSet()) {
+    std::stringstream ss;
+    ss << instruction_set << " not supported";
+    state.SkipWithError(ss.str().c_str());
+    return false;
+  }
+  std::stringstream ss;
+  ss << instruction_set;
+  if (instruction_set == kernel.instruction_set()) {
+    ss << " (selected)";
+  }
+  state.SetLabel(ss.str());
+  return true;
+}
+
+}  // namespace
+
+// The acceleration exerted by a spherical body on the given number of massless
+// bodies.
+void BM_CPUDispatchGravityKernel(benchmark::State& state) {
+  if (!CheckAndLabelInstructionSet(AccumulateSphericalBodyAccelerations,
+                                   state)) {
+    return;
+  }
+  auto const implementation = AccumulateSphericalBodyAccelerations.
+      implementation(static_cast<InstructionSet>(state.range(0)));
+  std::int64_t const n = state.range(1);
+  auto const qx = RandomVector(n, -1e9, 1e9);
+  auto const qy = RandomVector(n, -1e9, 1e9);
+  auto const qz = RandomVector(n, -1e9, 1e9);
+  std::vector<double> ax(n);
+  std::vector<double> ay(n);
+  std::vector<double> az(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(implementation(/*μ=*/3.986004418e14,
+                                            /*q1x=*/1e8,
+                                            /*q1y=*/-2e8,
+                                            /*q1z=*/3e7,
+                                            /*collision_radius=*/6.4e6,
+                                            n,
+                                            qx.data(), qy.data(), qz.data(),
+                                            ax.data(), ay.data(), az.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_CPUDispatchGravityKernel)
+    ->ArgsProduct({{static_cast<int>(InstructionSet::Generic),
+                    static_cast<int>(InstructionSet::AVX2),
+                    static_cast<int>(InstructionSet::AVX512)},
+                   {3, 16, 100, 1000}});
+
+}  // namespace base
+}  // namespace principia
@@ -2,8 +2,12 @@
 
 #include "physics/discrete_trajectory.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 
+#include "absl/strings/str_cat.h"
 #include "astronomy/epoch.hpp"
 #include "base/not_null.hpp"
 #include "benchmark/benchmark.h"
@@ -15,7 +19,9 @@
 #include "physics/discrete_trajectory_types.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"
 #include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
 #include "testing_utilities/discrete_trajectory_factories.hpp"
 
 namespace principia {
@@ -400,6 +406,50 @@ void BM_DiscreteTrajectoryEvaluateDegreesOfFreedomInterpolated(
   }
 }
 
+// Measures the latency of the individual calls to |Append| on a downsampled
+// trajectory, which is dominated by the calls that trigger a fit.  If
+// |state.range(0)| is 1, the fit runs asynchronously.
+void BM_DiscreteTrajectoryAppendLatency(benchmark::State& state) {
+  bool const asynchronous = state.range(0) != 0;
+  Instant const t0;
+  auto const timeline = NewCircularTrajectoryTimeline<World>(
+      /*ω=*/2 * π * Radian / (90 * Minute),
+      /*r=*/7000 * Kilo(Metre),
+      /*Δt=*/10 * Second,
+      /*t1=*/t0,
+      /*t2=*/t0 + 200'000 * 10 * Second);
+
+  std::vector<double> latencies;
+  latencies.reserve(timeline.size());
+  for (auto _ : state) {
+    DiscreteTrajectory<World> trajectory;
+    trajectory.segments().front().SetDownsampling(
+        {.max_dense_intervals = 10'000,
+         .tolerance = 10 * Metre,
+         .asynchronous = asynchronous});
+    for (auto const& [t, degrees_of_freedom] : timeline) {
+      auto const start = std::chrono::steady_clock::now();
+      trajectory.Append(t, degrees_of_freedom).IgnoreError();
+      auto const stop = std::chrono::steady_clock::now();
+      latencies.push_back(
+          std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    benchmark::DoNotOptimize(trajectory.size());
+  }
+
+  auto const percentile = [&latencies](double const p) {
+    auto const nth = latencies.begin() +
+                     static_cast<std::int64_t>(p * (latencies.size() - 1));
+    std::nth_element(latencies.begin(), nth, latencies.end());
+    return *nth;
+  };
+  double const p50 = percentile(0.5);
+  double const p99 = percentile(0.99);
+  double const max = *std::max_element(latencies.begin(), latencies.end());
+  state.SetLabel(absl::StrCat("p50 ", p50, " ns, p99 ", p99, " ns, max ",
+                              max / 1e6, " ms"));
+}
+
 BENCHMARK(BM_DiscreteTrajectoryFront);
 BENCHMARK(BM_DiscreteTrajectoryFrontEmpty);
 BENCHMARK(BM_DiscreteTrajectoryBack);
@@ -423,6 +473,10 @@ BENCHMARK(BM_DiscreteTrajectoryFind)->Range(8, 1024);
 BENCHMARK(BM_DiscreteTrajectoryLowerBound)->Range(8, 1024);
 BENCHMARK(BM_DiscreteTrajectoryEvaluateDegreesOfFreedomExact);
 BENCHMARK(BM_DiscreteTrajectoryEvaluateDegreesOfFreedomInterpolated);
+BENCHMARK(BM_DiscreteTrajectoryAppendLatency)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace physics
 }  // namespace principia
@@ -169,6 +169,72 @@ void BM_EphemerisSolarSystem(benchmark::State& state) {
   state.SetLabel(quantities::DebugString(error / AstronomicalUnit) + " ua");
 }
 
+// Measures the throughput of |Prolong| in steps per second.  With many bodies,
+// fitting the Newhall approximations is a significant part of each step.
+template<SolarSystemFactory::Accuracy accuracy>
+void BM_EphemerisProlongThroughput(benchmark::State& state) {
+  Time const step = EphemerisParameters().step();
+  Time const duration = 10 * JulianYear;
+  std::int64_t steps = 0;
+  std::int64_t bodies = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(accuracy);
+    auto const ephemeris =
+        at_спутник_1_launch->MakeEphemeris(
+            SolarSystemFactory::MakeAccuracyParameters<Barycentric>(
+                FittingTolerance(state.range(0)),
+                accuracy),
+            EphemerisParameters());
+    bodies = ephemeris->bodies().size();
+    state.ResumeTiming();
+
+    CHECK_OK(ephemeris->Prolong(at_спутник_1_launch->epoch() + duration));
+    steps += std::floor(duration / step);
+  }
+  state.SetItemsProcessed(steps);
+  state.SetLabel(std::to_string(bodies) + " bodies");
+}
+
+// Measures the compression of the polynomials of a 50-year ephemeris into the
+// cold tier, and reports the memory used by the polynomials before and after.
+template<SolarSystemFactory::Accuracy accuracy>
+void BM_EphemerisCompressTrajectories(benchmark::State& state) {
+  Time const duration = 50 * JulianYear;
+  auto const polynomials_memory_size =
+      [](Ephemeris<Barycentric> const& ephemeris) {
+        std::int64_t size = 0;
+        for (auto const body : ephemeris.bodies()) {
+          size += ephemeris.trajectory(body)->polynomials_memory_size();
+        }
+        return size;
+      };
+
+  std::int64_t hot_size = 0;
+  std::int64_t cold_size = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(accuracy);
+    auto const ephemeris =
+        at_спутник_1_launch->MakeEphemeris(
+            SolarSystemFactory::MakeAccuracyParameters<Barycentric>(
+                FittingTolerance(state.range(0)),
+                accuracy),
+            EphemerisParameters());
+    CHECK_OK(ephemeris->Prolong(at_спутник_1_launch->epoch() + duration));
+    hot_size = polynomials_memory_size(*ephemeris);
+    state.ResumeTiming();
+
+    ephemeris->CompressTrajectoriesBefore(ephemeris->t_max());
+
+    state.PauseTiming();
+    cold_size = polynomials_memory_size(*ephemeris);
+    state.ResumeTiming();
+  }
+  state.SetLabel(std::to_string(hot_size >> 20) + " MiB hot, " +
+                 std::to_string(cold_size >> 20) + " MiB cold");
+}
+
 template<SolarSystemFactory::Accuracy accuracy, Flow* flow>
 void BM_EphemerisLEOProbe(benchmark::State& state) {
   Length sun_error;
@@ -591,6 +657,22 @@ BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
                    SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
     ->Arg(-3)
     ->Unit(benchmark::kSecond);
+BENCHMARK_TEMPLATE(BM_EphemerisProlongThroughput,
+                   SolarSystemFactory::Accuracy::MajorBodiesOnly)
+    ->Arg(-3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EphemerisProlongThroughput,
+                   SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
+    ->Arg(-3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EphemerisCompressTrajectories,
+                   SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness)
+    ->Arg(-3)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
 BENCHMARK_TEMPLATE(BM_EphemerisL4Probe,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly,
                    &FlowEphemerisWithAdaptiveStep)
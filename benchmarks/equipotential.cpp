@@ -0,0 +1,212 @@
+// .\Release\x64\benchmarks.exe --benchmark_filter=Equipotential --benchmark_repetitions=1  // NOLINT(whitespace/line_length)
+
+#include "physics/equipotential.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "astronomy/time_scales.hpp"
+#include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/barycentre_calculator.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/plane.hpp"
+#include "geometry/space.hpp"
+#include "integrators/embedded_explicit_runge_kutta_integrator.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "numerics/global_optimization.hpp"
+#include "numerics/root_finders.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
+#include "physics/rotating_pulsating_reference_frame.hpp"
+#include "physics/solar_system.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/solar_system_factory.hpp"
+
+namespace principia {
+namespace physics {
+
+using namespace principia::astronomy::_time_scales;
+using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_barycentre_calculator;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_plane;
+using namespace principia::geometry::_space;
+using namespace principia::integrators::_embedded_explicit_runge_kutta_integrator;  // NOLINT
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_symmetric_linear_multistep_integrator;
+using namespace principia::numerics::_global_optimization;
+using namespace principia::numerics::_root_finders;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_equipotential;
+using namespace principia::physics::_massive_body;
+using namespace principia::physics::_rotating_pulsating_reference_frame;
+using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_solar_system_factory;
+
+using Barycentric = Frame<struct BarycentricTag, Inertial>;
+using World = Frame<struct WorldTag, Arbitrary>;
+
+// Measures the computation of the Earth-Moon equipotentials at the energy
+// levels drawn by the plotter, as a function of the number of threads.  A pool
+// size of 0 means that no thread pool is used.
+void BM_EquipotentialEarthMoon(benchmark::State& state) {
+  std::int64_t const pool_size = state.range(0);
+  constexpr int levels = 8;
+  constexpr int l1_level = 7;
+
+  auto const solar_system = make_not_null_unique<SolarSystem<Barycentric>>(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt",
+      /*ignore_frame=*/true);
+  auto const ephemeris = solar_system->MakeEphemeris(
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<Barycentric>::FixedStepParameters(
+          SymmetricLinearMultistepIntegrator<
+              QuinlanTremaine1990Order12,
+              Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+          /*step=*/10 * Minute));
+  auto const earth = solar_system->massive_body(
+      *ephemeris, SolarSystemFactory::name(SolarSystemFactory::Earth));
+  auto const moon = solar_system->massive_body(
+      *ephemeris, SolarSystemFactory::name(SolarSystemFactory::Moon));
+  Instant const t = "JD2451545.5"_TT;
+  CHECK_OK(ephemeris->Prolong(t));
+
+  RotatingPulsatingReferenceFrame<Barycentric, World> const reference_frame(
+      ephemeris.get(), moon, earth);
+  auto const plane =
+      Plane<World>::OrthogonalTo(Vector<double, World>({0, 0, 1}));
+  auto const potential = [&reference_frame,
+                          &t](Position<World> const& position) {
+    return reference_frame.GeometricPotential(t, position);
+  };
+  auto const gradient = [&reference_frame,
+                         &t](Position<World> const& position) {
+    auto const acceleration =
+        reference_frame.GeometricAcceleration(t, {position, Velocity<World>{}});
+    // Note the sign.
+    return -Vector<Acceleration, World>({acceleration.coordinates()[0],
+                                         acceleration.coordinates()[1],
+                                         Acceleration{}});
+  };
+
+  // The peaks, wells and energies are computed as in the plotter, outside of
+  // the measurement.
+  MultiLevelSingleLinkage<SpecificEnergy, Position<World>, 2>::Box const box = {
+      .centre = World::origin,
+      .vertices = {Displacement<World>({3 * Metre, 0 * Metre, 0 * Metre}),
+                   Displacement<World>({0 * Metre, 3 * Metre, 0 * Metre})}};
+  auto const arg_maximorum =
+      MultiLevelSingleLinkage<SpecificEnergy, Position<World>, 2>(
+          box, potential, gradient)
+          .FindGlobalMaxima(/*points_per_round=*/1000,
+                            /*number_of_rounds=*/std::nullopt,
+                            /*local_search_tolerance=*/1e-3 * Metre);
+  SpecificEnergy maximum_maximorum = -Infinity<SpecificEnergy>;
+  for (auto const& arg_maximum : arg_maximorum) {
+    maximum_maximorum = std::max(maximum_maximorum, potential(arg_maximum));
+  }
+
+  auto const position_in_world = [&reference_frame, &ephemeris, &t](
+                                     not_null<MassiveBody const*> const body) {
+    return reference_frame.ToThisFrameAtTimeSimilarly(t).similarity()(
+        ephemeris->trajectory(body)->EvaluatePosition(t));
+  };
+  Position<World> const earth_position = position_in_world(earth);
+  Position<World> const moon_position = position_in_world(moon);
+  Length const r = (ephemeris->trajectory(moon)->EvaluatePosition(t) -
+                    ephemeris->trajectory(earth)->EvaluatePosition(t))
+                       .Norm();
+  std::vector<Equipotential<Barycentric, World>::Well> const wells{
+      {moon_position, moon->min_radius() / r * (1 * Metre)},
+      {earth_position, earth->min_radius() / r * (1 * Metre)}};
+  auto const towards_infinity = [](Position<World> q) {
+    return World::origin + Normalize(q - World::origin) * 3 * Metre;
+  };
+
+  double const arg_approx_l1 = Brent(
+      [&](double const x) {
+        return potential(Barycentre(std::pair(moon_position, earth_position),
+                                    std::pair(x, 1 - x)));
+      },
+      0.0,
+      1.0,
+      std::greater<>{});
+  SpecificEnergy const approx_l1_energy =
+      potential(Barycentre(std::pair(moon_position, earth_position),
+                           std::pair(arg_approx_l1, 1 - arg_approx_l1)));
+  std::vector<SpecificEnergy> energies;
+  for (int i = 1; i <= levels; ++i) {
+    energies.push_back(
+        maximum_maximorum -
+        i * (1.0 / l1_level * (maximum_maximorum - approx_l1_energy)));
+  }
+
+  constexpr Length characteristic_length = 1 * Nano(Metre);
+  Equipotential<Barycentric, World> const equipotential(
+      {EmbeddedExplicitRungeKuttaIntegrator<
+           DormandPrince1986RK547FC,
+           Equipotential<Barycentric, World>::ODE>(),
+       /*max_steps=*/1000,
+       /*length_integration_tolerance=*/characteristic_length},
+      &reference_frame,
+      characteristic_length);
+
+  std::unique_ptr<ThreadPool<void>> thread_pool;
+  if (pool_size > 0) {
+    thread_pool = std::make_unique<ThreadPool<void>>(pool_size);
+  }
+
+  std::int64_t total_lines = 0;
+  std::int64_t total_points = 0;
+  for (auto _ : state) {
+    auto const all_lines = equipotential.ComputeLines(plane,
+                                                      t,
+                                                      arg_maximorum,
+                                                      wells,
+                                                      towards_infinity,
+                                                      energies,
+                                                      thread_pool.get());
+    for (auto const& lines : all_lines) {
+      total_lines += lines.size();
+      for (auto const& line : lines) {
+        total_points += line.size();
+      }
+    }
+  }
+  state.SetLabel(absl::StrCat(
+      static_cast<double>(total_lines) / state.iterations(),
+      " lines, ",
+      static_cast<double>(total_points) / state.iterations(),
+      " points"));
+}
+
+BENCHMARK(BM_EquipotentialEarthMoon)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace physics
+}  // namespace principia
@@ -1,17 +1,24 @@
-// .\Release\x64\benchmarks.exe --benchmark_repetitions=10 --benchmark_min_time=2 --benchmark_filter=FastSinCos  // NOLINT(whitespace/line_length)
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=10 --benchmark_min_time=2 --benchmark_filter=(FastSinCos|SinCos|Sqrt)  // NOLINT(whitespace/line_length)
 
 #include "numerics/fast_sin_cos_2π.hpp"
 
 #include <pmmintrin.h>
+
+#include <cmath>
 #include <random>
+#include <sstream>
 #include <vector>
 
+#include "base/cpu_dispatch.hpp"
 #include "benchmark/benchmark.h"
+#include "numerics/elementary_function_kernels.hpp"
 #include "quantities/numbers.hpp"
 
 namespace principia {
 namespace numerics {
 
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::numerics::_elementary_function_kernels;
 using namespace principia::numerics::_fast_sin_cos_2π;
 
 namespace {
@@ -44,6 +51,37 @@ double PoorlyMixTrigonometricLines(double cos_2πx, double sin_2πx) {
       cos_2πx, sin_2πx, mantissa_bits_and_5_bits_of_exponent);
 }
 
+constexpr int throughput_inputs = 1e3;
+
+std::vector<double> RandomInputs(double const min, double const max) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(min, max);
+  std::vector<double> input;
+  for (int i = 0; i < throughput_inputs; ++i) {
+    input.push_back(distribution(random));
+  }
+  return input;
+}
+
+// Returns the implementation of |kernel| for the instruction set given by the
+// first argument of the benchmark, or null, after marking the benchmark as
+// skipped, if that instruction set is not supported.
+template<typename Signature>
+auto ImplementationOrSkip(CPUDispatch<Signature> const& kernel,
+                          benchmark::State& state)
+    -> decltype(kernel.implementation(InstructionSet::Generic)) {
+  auto const instruction_set = static_cast<InstructionSet>(state.range(0));
+  std::stringstream ss;
+  ss << instruction_set;
+  if (instruction_set > SupportedInstructionSet()) {
+    ss << " not supported";
+    state.SkipWithError(ss.str().c_str());
+    return nullptr;
+  }
+  state.SetLabel(ss.str());
+  return kernel.implementation(instruction_set);
+}
+
 }  // namespace
 
 void BM_FastSinCos2πPoorlyPredictedLatency(benchmark::State& state) {
@@ -85,9 +123,57 @@ void BM_FastSinCos2πThroughput(benchmark::State& state) {
   }
 }
 
+// The accurate functions, for comparison with |FastSinCos2π|.
+void BM_StdSinCosThroughput(benchmark::State& state) {
+  auto const input = RandomInputs(-π, π);
+  for (auto _ : state) {
+    double sin;
+    double cos;
+    for (double const x : input) {
+      sin = std::sin(x);
+      cos = std::cos(x);
+      benchmark::DoNotOptimize(sin);
+      benchmark::DoNotOptimize(cos);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * throughput_inputs);
+}
+
+void BM_StdSqrtThroughput(benchmark::State& state) {
+  auto const input = RandomInputs(0.0, 1e6);
+  std::vector<double> values(throughput_inputs);
+  for (auto _ : state) {
+    for (int i = 0; i < throughput_inputs; ++i) {
+      values[i] = std::sqrt(input[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * throughput_inputs);
+}
+
+void BM_BatchSqrtThroughput(benchmark::State& state) {
+  auto const implementation = ImplementationOrSkip(BatchSqrt, state);
+  if (implementation == nullptr) {
+    return;
+  }
+  auto const input = RandomInputs(0.0, 1e6);
+  std::vector<double> values(throughput_inputs);
+  for (auto _ : state) {
+    implementation(throughput_inputs, input.data(), values.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * throughput_inputs);
+}
+
 BENCHMARK(BM_FastSinCos2πPoorlyPredictedLatency)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_FastSinCos2πWellPredictedLatency)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_FastSinCos2πThroughput)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StdSinCosThroughput)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StdSqrtThroughput)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchSqrtThroughput)
+    ->DenseRange(static_cast<int>(InstructionSet::Generic),
+                 static_cast<int>(InstructionSet::AVX512))
+    ->Unit(benchmark::kMicrosecond);
 
 }  // namespace numerics
 }  // namespace principia
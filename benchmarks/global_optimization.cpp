@@ -2,9 +2,11 @@
 
 #include "numerics/global_optimization.hpp"
 
+#include <memory>
 #include <random>
 
 #include "absl/strings/str_cat.h"
+#include "base/thread_pool.hpp"
 #include "benchmark/benchmark.h"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
@@ -17,6 +19,7 @@
 namespace principia {
 namespace numerics {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_space;
@@ -27,6 +30,19 @@ using namespace principia::quantities::_si;
 using namespace principia::testing_utilities::_optimization_test_functions;
 
 using World = Frame<struct WorldTag>;
+using Hartmann3Optimizer =
+    MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
+
+// The unit cube on which |Hartmann3| is minimized.
+Hartmann3Optimizer::Box Hartmann3Box() {
+  return {
+      .centre = Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre}),
+      .vertices = {
+          Displacement<World>({0.5 * Metre, 0 * Metre, 0 * Metre}),
+          Displacement<World>({0 * Metre, 0.5 * Metre, 0 * Metre}),
+          Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
+      }};
+}
 
 void BM_MLSLBranin(benchmark::State& state) {
   std::int64_t const points_per_round = state.range(0);
@@ -120,42 +136,43 @@ void BM_MLSLHartmann3(benchmark::State& state) {
   std::int64_t const points_per_round = state.range(0);
   std::int64_t const number_of_rounds = state.range(1);
 
-  using Optimizer =
-      MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
-
-  auto hartmann3 = [](Displacement<World> const& displacement) {
-    auto const& coordinates = displacement.coordinates();
-    double const x₀ = coordinates[0] / Metre;
-    double const x₁ = coordinates[1] / Metre;
-    double const x₂ = coordinates[2] / Metre;
-    return Hartmann3(x₀, x₁, x₂);
-  };
+  auto const tolerance = 1e-6 * Metre;
+  Hartmann3Optimizer optimizer(
+      Hartmann3Box(), &Hartmann3<World>, &𝛁Hartmann3<World>);
 
-  auto grad_hartmann3 = [](Displacement<World> const& displacement) {
-    auto const& coordinates = displacement.coordinates();
-    double const x₀ = coordinates[0] / Metre;
-    double const x₁ = coordinates[1] / Metre;
-    double const x₂ = coordinates[2] / Metre;
-    auto const [g₀, g₁, g₂] = 𝛁Hartmann3(x₀, x₁, x₂);
-    return Vector<Inverse<Length>, World>({g₀ / Metre, g₁ / Metre, g₂ / Metre});
-  };
+  int64_t total_minima = 0;
+  for (auto _ : state) {
+    total_minima +=
+        optimizer.FindGlobalMinima(points_per_round,
+                                   number_of_rounds, tolerance).size();
+  }
+  state.SetLabel(
+      absl::StrCat("number of minima: ",
+                   static_cast<double>(total_minima) / state.iterations()));
+}
 
-  Optimizer::Box const box = {
-      .centre = Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre}),
-      .vertices = {
-          Displacement<World>({0.5 * Metre, 0 * Metre, 0 * Metre}),
-          Displacement<World>({0 * Metre, 0.5 * Metre, 0 * Metre}),
-          Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
-      }};
+// Measures the scaling of the search with the number of threads.  A pool size
+// of 0 means that no thread pool is used.
+void BM_MLSLHartmann3Parallel(benchmark::State& state) {
+  std::int64_t const points_per_round = state.range(0);
+  std::int64_t const pool_size = state.range(1);
 
   auto const tolerance = 1e-6 * Metre;
-  Optimizer optimizer(box, hartmann3, grad_hartmann3);
+  std::unique_ptr<ThreadPool<void>> thread_pool;
+  if (pool_size > 0) {
+    thread_pool = std::make_unique<ThreadPool<void>>(pool_size);
+  }
+  Hartmann3Optimizer optimizer(Hartmann3Box(),
+                               &Hartmann3<World>,
+                               &𝛁Hartmann3<World>,
+                               thread_pool.get());
 
   int64_t total_minima = 0;
   for (auto _ : state) {
     total_minima +=
         optimizer.FindGlobalMinima(points_per_round,
-                                   number_of_rounds, tolerance).size();
+                                   /*number_of_rounds=*/std::nullopt,
+                                   tolerance).size();
   }
   state.SetLabel(
       absl::StrCat("number of minima: ",
@@ -165,6 +182,9 @@ void BM_MLSLHartmann3(benchmark::State& state) {
 BENCHMARK(BM_MLSLBranin)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
 BENCHMARK(BM_MLSLGoldsteinPrice)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
 BENCHMARK(BM_MLSLHartmann3)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
+BENCHMARK(BM_MLSLHartmann3Parallel)
+    ->ArgsProduct({{100, 1000}, {0, 1, 2, 4, 8, 16}})
+    ->UseRealTime();
 
 }  // namespace numerics
 }  // namespace principia
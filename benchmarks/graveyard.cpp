@@ -0,0 +1,99 @@
+// .\Release\x64\benchmarks.exe --benchmark_filter=Graveyard --benchmark_repetitions=5  // NOLINT(whitespace/line_length)
+
+#include "base/graveyard.hpp"
+
+#include <cstdint>
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "geometry/frame.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/discrete_trajectory_types.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/discrete_trajectory_factories.hpp"
+
+namespace principia {
+namespace base {
+
+using namespace principia::base::_graveyard;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_discrete_trajectory_types;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_discrete_trajectory_factories;
+
+namespace {
+
+using World = Frame<struct WorldTag>;
+
+Timeline<World> MakeTimeline(std::int64_t const number_of_points) {
+  Instant const t0;
+  return NewLinearTrajectoryTimeline(
+      DegreesOfFreedom<World>(
+          World::origin,
+          Velocity<World>({1 * Metre / Second,
+                           2 * Metre / Second,
+                           3 * Metre / Second})),
+      /*Δt=*/1 * Second,
+      /*t1=*/t0,
+      /*t2=*/t0 + number_of_points * Second);
+}
+
+std::unique_ptr<DiscreteTrajectory<World>> MakeTrajectory(
+    Timeline<World> const& timeline) {
+  auto trajectory = std::make_unique<DiscreteTrajectory<World>>();
+  for (auto const& [time, degrees_of_freedom] : timeline) {
+    trajectory->Append(time, degrees_of_freedom).IgnoreError();
+  }
+  return trajectory;
+}
+
+}  // namespace
+
+// The time spent by the caller to destroy a trajectory with the given number of
+// points.
+void BM_GraveyardDestroyTrajectory(benchmark::State& state) {
+  auto const timeline = MakeTimeline(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto trajectory = MakeTrajectory(timeline);
+    state.ResumeTiming();
+    trajectory.reset();
+  }
+}
+
+// The time spent by the caller to bury a trajectory with the given number of
+// points.  The time spent by the gravedigger is not included.
+void BM_GraveyardBuryTrajectory(benchmark::State& state) {
+  Graveyard graveyard(/*number_of_threads=*/1);
+  auto const timeline = MakeTimeline(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto trajectory = MakeTrajectory(timeline);
+    state.ResumeTiming();
+    graveyard.Bury(std::move(trajectory));
+    state.PauseTiming();
+    graveyard.Flush();
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK(BM_GraveyardDestroyTrajectory)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GraveyardBuryTrajectory)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace base
+}  // namespace principia
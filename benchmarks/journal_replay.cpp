@@ -0,0 +1,107 @@
+// set PRINCIPIA_REPLAY_JOURNAL=P:\Public Mockingbird\Principia\Journals\JOURNAL.20230506-192603  // NOLINT(whitespace/line_length)
+// .\Release\x64\benchmarks.exe --benchmark_filter=JournalReplay --benchmark_repetitions=3 --benchmark_out=replay.json --benchmark_out_format=json  // NOLINT(whitespace/line_length)
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+#include "journal/player.hpp"
+#include "ksp_plugin/interface.hpp"
+
+namespace principia {
+namespace journal {
+
+using namespace principia::journal::_player;
+
+namespace {
+
+// The environment variable that gives the path of the journal to replay.
+constexpr char journal_variable[] = "PRINCIPIA_REPLAY_JOURNAL";
+
+// Returns the method statistics of the plugin, see |MethodStatistics::Dump|,
+// and starts a new period of collection.  The statistics must be obtained
+// through the interface, as the plugin may be a separate library with its own
+// statistics.
+std::string GetAndResetMethodStatistics() {
+  char const* statistics;
+  interface::principia__GetMethodStatistics(/*reset=*/true, &statistics);
+  std::string result = statistics;
+  interface::principia__DeleteString(&statistics);
+  return result;
+}
+
+// Adds counters to |state| for each of the methods in |statistics|.
+void SetMethodCounters(std::string const& statistics,
+                       benchmark::State& state) {
+  std::vector<std::string_view> const lines =
+      absl::StrSplit(statistics, '\n', absl::SkipEmpty());
+  // Skip the header.
+  for (std::size_t i = 1; i < lines.size(); ++i) {
+    std::vector<std::string_view> const fields = absl::StrSplit(lines[i], '\t');
+    CHECK_LE(4, fields.size()) << lines[i];
+    std::string const name(fields[0]);
+    // The call that reset the statistics is not part of the replay.  Neither is
+    // the call to |DeleteString| that followed it, but it is negligible.
+    if (name == "GetMethodStatistics") {
+      continue;
+    }
+    double calls;
+    double total_ms;
+    double mean_us;
+    CHECK(absl::SimpleAtod(fields[1], &calls)) << lines[i];
+    CHECK(absl::SimpleAtod(fields[2], &total_ms)) << lines[i];
+    CHECK(absl::SimpleAtod(fields[3], &mean_us)) << lines[i];
+    state.counters[name + ".calls"] = calls;
+    state.counters[name + ".total_ms"] = total_ms;
+    state.counters[name + ".mean_us"] = mean_us;
+  }
+}
+
+}  // namespace
+
+// Replays a journal and reports, in addition to the total time, the number of
+// calls and the time spent in each interface method.  The methods that are
+// only used for logging are skipped, as they depend on the game environment.
+// The journal is expected to start with the creation of the plugin and to end
+// with its destruction, so that each iteration starts from a clean state.
+void BM_JournalReplay(benchmark::State& state) {
+  char const* const path = std::getenv(journal_variable);
+  if (path == nullptr) {
+    state.SkipWithError(
+        (std::string(journal_variable) + " is not set").c_str());
+    return;
+  }
+  std::string statistics;
+  std::int64_t methods = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Player player(path);
+    player.set_skip_diagnostics(true);
+    GetAndResetMethodStatistics();
+    state.ResumeTiming();
+
+    int index = 0;
+    while (player.Play(index)) {
+      ++index;
+    }
+
+    state.PauseTiming();
+    methods += index;
+    statistics = GetAndResetMethodStatistics();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(methods);
+  // The counters are those of the last iteration.
+  SetMethodCounters(statistics, state);
+}
+
+BENCHMARK(BM_JournalReplay)->Unit(benchmark::kMillisecond)->Iterations(1);
+
+}  // namespace journal
+}  // namespace principia
@@ -13,6 +13,7 @@
 #include "numerics/polynomial.hpp"
 #include "numerics/polynomial_evaluators.hpp"
 #include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 
 namespace principia {
@@ -27,6 +28,7 @@ using namespace principia::numerics::_polynomial;
 using namespace principia::numerics::_polynomial_evaluators;
 using namespace principia::numerics::_чебышёв_series;
 using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
 template<typename Result,
@@ -94,6 +96,57 @@ void BM_NewhallApproximationDisplacement(benchmark::State& state) {
   }
 }
 
+// Measures the search for the best degree done by |ContinuousTrajectory|,
+// going from degree 3 to |state.range(0)|.  If |state.range(1)| is 0, an
+// approximation is computed for each degree, as was done originally.
+// Otherwise, only the error estimates are computed for each degree and a
+// single approximation is computed for the last degree.
+void BM_NewhallBestApproximationDisplacement(benchmark::State& state) {
+  int const max_degree = state.range(0);
+  bool const estimate_only = state.range(1) != 0;
+  std::mt19937_64 random(42);
+  std::vector<Displacement<ICRS>> p;
+  std::vector<Variation<Displacement<ICRS>>> v;
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+
+  Length total_error_estimate;
+  Displacement<ICRS> error_estimate;
+  for (auto _ : state) {
+    state.PauseTiming();
+    p.clear();
+    v.clear();
+    for (int i = 0; i <= 8; ++i) {
+      p.push_back(Displacement<ICRS>({static_cast<double>(random()) * Metre,
+                                      static_cast<double>(random()) * Metre,
+                                      static_cast<double>(random()) * Metre}));
+      v.push_back(Variation<Displacement<ICRS>>(
+          {static_cast<double>(random()) * Metre / Second,
+           static_cast<double>(random()) * Metre / Second,
+           static_cast<double>(random()) * Metre / Second}));
+    }
+    state.ResumeTiming();
+    for (int degree = 3; degree < max_degree; ++degree) {
+      if (estimate_only) {
+        error_estimate = NewhallApproximationErrorEstimate(
+            degree, p, v, t_min, t_max);
+      } else {
+        auto const polynomial = NewhallApproximationInMonomialBasis<
+            Displacement<ICRS>, EstrinEvaluator>(
+                degree, p, v, t_min, t_max, error_estimate);
+        benchmark::DoNotOptimize(polynomial);
+      }
+      total_error_estimate += error_estimate.Norm();
+    }
+    auto const polynomial = NewhallApproximationInMonomialBasis<
+        Displacement<ICRS>, EstrinEvaluator>(
+            max_degree, p, v, t_min, t_max, error_estimate);
+    benchmark::DoNotOptimize(polynomial);
+  }
+  benchmark::DoNotOptimize(total_error_estimate);
+}
+
 using ResultЧебышёвDouble = ЧебышёвSeries<double>;
 using ResultЧебышёвDisplacement = ЧебышёвSeries<Displacement<ICRS>>;
 using ResultMonomialDouble =
@@ -123,5 +176,8 @@ BENCHMARK_TEMPLATE(
                                           EstrinEvaluator>))
     ->Arg(4)->Arg(8)->Arg(16);
 
+BENCHMARK(BM_NewhallBestApproximationDisplacement)
+    ->ArgsProduct({{4, 8, 12, 16}, {0, 1}});
+
 }  // namespace numerics
 }  // namespace principia
@@ -0,0 +1,221 @@
+// .\Release\x64\benchmarks.exe --benchmark_filter=PileUp --benchmark_repetitions=3  // NOLINT(whitespace/line_length)
+
+#include "ksp_plugin/pile_up.hpp"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "astronomy/epoch.hpp"
+#include "base/not_null.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/integrators.hpp"
+#include "ksp_plugin/lock_step_histories.hpp"
+#include "ksp_plugin/part.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/rigid_motion.hpp"
+#include "physics/solar_system.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/solar_system_factory.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+
+using namespace principia::astronomy::_epoch;
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_symmetric_linear_multistep_integrator;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_integrators;
+using namespace principia::ksp_plugin::_lock_step_histories;
+using namespace principia::ksp_plugin::_part;
+using namespace principia::ksp_plugin::_pile_up;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_rigid_motion;
+using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_solar_system_factory;
+
+// The position of the |i|th part of a synthetic pile-up, on a cubic lattice
+// with a spacing of 1 m.
+template<typename Frame>
+Displacement<Frame> PartOffset(int const i) {
+  return Displacement<Frame>({(i % 10) * Metre,
+                              ((i / 10) % 10) * Metre,
+                              (i / 100) * Metre});
+}
+
+not_null<std::unique_ptr<SolarSystem<Barycentric>>> MakeSolarSystem() {
+  return make_not_null_unique<SolarSystem<Barycentric>>(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt",
+      /*ignore_frame=*/true);
+}
+
+not_null<std::unique_ptr<Ephemeris<Barycentric>>> MakeEphemeris(
+    SolarSystem<Barycentric> const& solar_system) {
+  return solar_system.MakeEphemeris(
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<Barycentric>::FixedStepParameters(
+          SymmetricLinearMultistepIntegrator<
+              QuinlanTremaine1990Order12,
+              Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+          /*step=*/10 * Minute));
+}
+
+// The degrees of freedom at J2000 of a circular orbit at an altitude of about
+// 600 km.
+DegreesOfFreedom<Barycentric> LowEarthOrbit(
+    SolarSystem<Barycentric> const& solar_system,
+    Ephemeris<Barycentric> const& ephemeris) {
+  auto const earth = solar_system.massive_body(
+      ephemeris, SolarSystemFactory::name(SolarSystemFactory::Earth));
+  Length const r = 7000 * Kilo(Metre);
+  DegreesOfFreedom<Barycentric> const earth_dof =
+      ephemeris.trajectory(earth)->EvaluateDegreesOfFreedom(J2000);
+  return DegreesOfFreedom<Barycentric>(
+      earth_dof.position() +
+          Displacement<Barycentric>({r, 0 * Metre, 0 * Metre}),
+      earth_dof.velocity() +
+          Velocity<Barycentric>({0 * Metre / Second,
+                                 Sqrt(earth->gravitational_parameter() / r),
+                                 0 * Metre / Second}));
+}
+
+// Measures |DeformAndAdvanceTime| for a synthetic pile-up in low Earth orbit
+// with |state.range(0)| parts, as happens at every frame for a large station
+// in the physics bubble.
+void BM_PileUpDeformAndAdvanceTime(benchmark::State& state) {
+  int const number_of_parts = state.range(0);
+
+  auto const solar_system = MakeSolarSystem();
+  auto const ephemeris = MakeEphemeris(*solar_system);
+  DegreesOfFreedom<Barycentric> const station_dof =
+      LowEarthOrbit(*solar_system, *ephemeris);
+
+  Mass const mass = 1 * Tonne;
+  std::vector<std::unique_ptr<Part>> parts;
+  std::list<not_null<Part*>> pile_up_parts;
+  for (int i = 0; i < number_of_parts; ++i) {
+    parts.push_back(std::make_unique<Part>(
+        i,
+        std::to_string(i),
+        mass,
+        EccentricPart::origin,
+        MakeWaterSphereInertiaTensor(mass),
+        RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+            {station_dof.position() + PartOffset<Barycentric>(i),
+             station_dof.velocity()}),
+        /*deletion_callback=*/nullptr));
+    pile_up_parts.push_back(parts.back().get());
+  }
+  PileUp pile_up(std::move(pile_up_parts),
+                 J2000,
+                 DefaultPsychohistoryParameters(),
+                 DefaultHistoryParameters(),
+                 ephemeris.get(),
+                 /*deletion_callback=*/nullptr);
+
+  Time const Δt = 20 * Milli(Second);
+  Instant t = J2000;
+  for (auto _ : state) {
+    // The game reports the apparent motions of all the parts at every frame.
+    state.PauseTiming();
+    for (int i = 0; i < number_of_parts; ++i) {
+      pile_up.SetPartApparentRigidMotion(
+          parts[i].get(),
+          RigidMotion<RigidPart, Apparent>::MakeNonRotatingMotion(
+              {Apparent::origin + PartOffset<Apparent>(i),
+               Apparent::unmoving}));
+    }
+    state.ResumeTiming();
+    t += Δt;
+    benchmark::DoNotOptimize(pile_up.DeformAndAdvanceTime(t));
+  }
+}
+
+// Measures the advance of |state.range(0)| coasting single-part pile-ups in low
+// Earth orbit by one history step, with their histories integrated separately
+// if |state.range(1)| is 0 and in lock-step otherwise.
+void BM_PileUpLockStepHistories(benchmark::State& state) {
+  int const number_of_pile_ups = state.range(0);
+  bool const lock_step = state.range(1) != 0;
+
+  auto const solar_system = MakeSolarSystem();
+  auto const ephemeris = MakeEphemeris(*solar_system);
+  DegreesOfFreedom<Barycentric> const orbit_dof =
+      LowEarthOrbit(*solar_system, *ephemeris);
+  LockStepHistories lock_step_histories(ephemeris.get(),
+                                        DefaultHistoryParameters());
+
+  Mass const mass = 1 * Tonne;
+  std::vector<std::unique_ptr<Part>> parts;
+  std::vector<std::unique_ptr<PileUp>> pile_ups;
+  for (int i = 0; i < number_of_pile_ups; ++i) {
+    // The vessels are spread along the orbit, 1 km apart.
+    parts.push_back(std::make_unique<Part>(
+        i,
+        std::to_string(i),
+        mass,
+        EccentricPart::origin,
+        MakeWaterSphereInertiaTensor(mass),
+        RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+            {orbit_dof.position() +
+                 Displacement<Barycentric>(
+                     {0 * Metre, i * Kilo(Metre), 0 * Metre}),
+             orbit_dof.velocity()}),
+        /*deletion_callback=*/nullptr));
+    pile_ups.push_back(std::make_unique<PileUp>(
+        std::list<not_null<Part*>>{parts.back().get()},
+        J2000,
+        DefaultPsychohistoryParameters(),
+        DefaultHistoryParameters(),
+        ephemeris.get(),
+        /*deletion_callback=*/nullptr));
+    if (lock_step) {
+      pile_ups.back()->SetLockStepHistories(&lock_step_histories);
+    }
+  }
+
+  Time const Δt = DefaultHistoryParameters().step();
+  Instant t = J2000;
+  for (auto _ : state) {
+    t += Δt;
+    for (auto const& pile_up : pile_ups) {
+      benchmark::DoNotOptimize(pile_up->DeformAndAdvanceTime(t));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * number_of_pile_ups);
+}
+
+BENCHMARK(BM_PileUpDeformAndAdvanceTime)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PileUpLockStepHistories)
+    ->ArgsProduct({{10, 100}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace ksp_plugin
+}  // namespace principia
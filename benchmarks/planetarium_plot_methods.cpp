@@ -3,7 +3,11 @@
 #include "ksp_plugin/planetarium.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "astronomy/epoch.hpp"
 #include "astronomy/time_scales.hpp"
 #include "base/status_utilities.hpp"
 #include "benchmark/benchmark.h"
@@ -12,12 +16,16 @@
 #include "geometry/space.hpp"
 #include "physics/body_centred_non_rotating_reference_frame.hpp"
 #include "physics/discrete_trajectory.hpp"
+#include "physics/rotating_body.hpp"
 #include "physics/solar_system.hpp"
+#include "quantities/astronomy.hpp"
+#include "testing_utilities/discrete_trajectory_factories.hpp"
 #include "testing_utilities/solar_system_factory.hpp"
 
 namespace principia {
 namespace geometry {
 
+using namespace principia::astronomy::_epoch;
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
@@ -42,10 +50,14 @@ using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_kepler_orbit;
 using namespace principia::physics::_massive_body;
 using namespace principia::physics::_massless_body;
+using namespace principia::physics::_rotating_body;
 using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_astronomy;
 using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_discrete_trajectory_factories;
 using namespace principia::testing_utilities::_solar_system_factory;
 
 namespace {
@@ -194,21 +206,120 @@ class Satellites {
   DiscreteTrajectory<Barycentric> goes_8_trajectory_;
 };
 
+// A synthetic system made of a central body with the mass and radius of the
+// Earth and of |moons| moons on circular orbits in its equatorial plane, with
+// a trajectory that winds its way among them.  The moons are massive enough to
+// hide parts of the trajectory, but not to perturb it significantly.
+class Moons {
+ public:
+  explicit Moons(int const moons) {
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    std::vector<DegreesOfFreedom<Barycentric>> initial_state;
+    GravitationalParameter const central_μ = TerrestrialGravitationalParameter;
+    bodies.emplace_back(MakeBody(central_μ, TerrestrialEquatorialRadius));
+    initial_state.emplace_back(Barycentric::origin, Barycentric::unmoving);
+    for (int i = 0; i < moons; ++i) {
+      // The moons are at increasing distances and are separated by the golden
+      // angle, so that they are spread over the field of view.
+      Length const r = 20'000 * Kilo(Metre) + i * 5'000 * Kilo(Metre);
+      Angle const θ = i * (3 - Sqrt(5.0)) * π * Radian;
+      bodies.emplace_back(MakeBody(1e-9 * central_μ, 1'000 * Kilo(Metre)));
+      initial_state.emplace_back(
+          Barycentric::origin +
+              Displacement<Barycentric>({r * Cos(θ), r * Sin(θ), 0 * Metre}),
+          Barycentric::unmoving +
+              Sqrt(central_μ / r) *
+                  Vector<double, Barycentric>({-Sin(θ), Cos(θ), 0}));
+    }
+    ephemeris_ = std::make_unique<Ephemeris<Barycentric>>(
+        std::move(bodies),
+        initial_state,
+        J2000,
+        /*accuracy_parameters=*/Ephemeris<Barycentric>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Milli(Metre),
+            /*geopotential_tolerance=*/0x1p-24),
+        Ephemeris<Barycentric>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute));
+    CHECK_OK(ephemeris_->Prolong(J2000 + 1 * Day));
+    centred_inertial_ = std::make_unique<
+        BodyCentredNonRotatingReferenceFrame<Barycentric, Navigation>>(
+        ephemeris_.get(), ephemeris_->bodies().front());
+    AppendTrajectoryTimeline(
+        NewCircularTrajectoryTimeline<Barycentric>(
+            /*period=*/1 * Day,
+            /*r=*/100'000 * Kilo(Metre),
+            /*Δt=*/10 * Second,
+            /*t1=*/J2000,
+            /*t2=*/J2000 + 1 * Day),
+        trajectory_);
+  }
+
+  DiscreteTrajectory<Barycentric> const& trajectory() const {
+    return trajectory_;
+  }
+
+  Planetarium MakePlanetarium(
+      Perspective<Navigation, Camera> const& perspective) const {
+    // Same parameters as for the satellites.
+    Planetarium::Parameters parameters(
+        /*sphere_radius_multiplier=*/1,
+        /*angular_resolution=*/0.4 * ArcMinute,
+        /*field_of_view=*/90 * Degree);
+    return Planetarium(parameters,
+                       perspective,
+                       ephemeris_.get(),
+                       centred_inertial_.get(),
+        [](Position<Navigation> const& plotted_point) {
+          constexpr auto inverse_scale_factor = 1 / (6000 * Metre);
+          return ScaledSpacePoint::FromCoordinates(
+              ((plotted_point - Navigation::origin) *
+               inverse_scale_factor).coordinates());
+        });
+  }
+
+ private:
+  static not_null<std::unique_ptr<MassiveBody const>> MakeBody(
+      GravitationalParameter const& μ,
+      Length const& mean_radius) {
+    return make_not_null_unique<RotatingBody<Barycentric>>(
+        μ,
+        RotatingBody<Barycentric>::Parameters(mean_radius,
+                                              /*reference_angle=*/0 * Radian,
+                                              J2000,
+                                              /*angular_frequency=*/
+                                              2 * π * Radian / Day,
+                                              /*right_ascension_of_pole=*/
+                                              0 * Radian,
+                                              /*declination_of_pole=*/
+                                              π / 2 * Radian));
+  }
+
+  std::unique_ptr<Ephemeris<Barycentric>> ephemeris_;
+  std::unique_ptr<NavigationFrame> centred_inertial_;
+  DiscreteTrajectory<Barycentric> trajectory_;
+};
+
 }  // namespace
 
+// The planetarium is created by |make_planetarium| at each iteration, as the
+// adapter does at each frame, so that the computation of its plottable spheres
+// is part of the measurement instead of being cached across iterations.
+template<typename MakePlanetarium>
 void RunBenchmark(benchmark::State& state,
-                  Perspective<Navigation, Camera> const& perspective) {
-  Satellites satellites;
-  Planetarium planetarium = satellites.MakePlanetarium(perspective);
+                  MakePlanetarium const& make_planetarium,
+                  DiscreteTrajectory<Barycentric> const& trajectory,
+                  Instant const& now) {
   RP2Lines<Length, Camera> lines;
   int total_lines = 0;
   int iterations = 0;
-  // This is the time of a lunar eclipse in January 2000.
-  constexpr Instant now = "2000-01-21T04:41:30,5"_TT;
   for (auto _ : state) {
-    lines = planetarium.PlotMethod2(satellites.goes_8_trajectory(),
-                                    satellites.goes_8_trajectory().begin(),
-                                    satellites.goes_8_trajectory().end(),
+    Planetarium const planetarium = make_planetarium();
+    lines = planetarium.PlotMethod2(trajectory,
+                                    trajectory.begin(),
+                                    trajectory.end(),
                                     now,
                                     /*reverse=*/false);
     total_lines += lines.size();
@@ -234,22 +345,58 @@ void RunBenchmark(benchmark::State& state,
                  DebugString(min_y) + ", " + DebugString(max_y) + "]");
 }
 
+void RunSatellitesBenchmark(
+    benchmark::State& state,
+    Perspective<Navigation, Camera> const& perspective) {
+  Satellites satellites;
+  // This is the time of a lunar eclipse in January 2000.
+  constexpr Instant now = "2000-01-21T04:41:30,5"_TT;
+  RunBenchmark(state,
+               [&perspective, &satellites]() {
+                 return satellites.MakePlanetarium(perspective);
+               },
+               satellites.goes_8_trajectory(),
+               now);
+}
+
+// |state.range(0)| is the number of moons.
+void RunMoonsBenchmark(benchmark::State& state,
+                       Perspective<Navigation, Camera> const& perspective) {
+  Moons moons(state.range(0));
+  RunBenchmark(state,
+               [&moons, &perspective]() {
+                 return moons.MakePlanetarium(perspective);
+               },
+               moons.trajectory(),
+               /*now=*/J2000 + 12 * Hour);
+}
+
 void BM_PlanetariumPlotMethod2NearPolarPerspective(benchmark::State& state) {
-  RunBenchmark(state, PolarPerspective(near));
+  RunSatellitesBenchmark(state, PolarPerspective(near));
 }
 
 void BM_PlanetariumPlotMethod2FarPolarPerspective(benchmark::State& state) {
-  RunBenchmark(state, PolarPerspective(far));
+  RunSatellitesBenchmark(state, PolarPerspective(far));
 }
 
 void BM_PlanetariumPlotMethod2NearEquatorialPerspective(
     benchmark::State& state) {
-  RunBenchmark(state, EquatorialPerspective(near));
+  RunSatellitesBenchmark(state, EquatorialPerspective(near));
 }
 
 void BM_PlanetariumPlotMethod2FarEquatorialPerspective(
     benchmark::State& state) {
-  RunBenchmark(state, EquatorialPerspective(far));
+  RunSatellitesBenchmark(state, EquatorialPerspective(far));
+}
+
+void BM_PlanetariumPlotMethod2ManyBodiesFarPolarPerspective(
+    benchmark::State& state) {
+  RunMoonsBenchmark(state, PolarPerspective(far));
+}
+
+void BM_PlanetariumPlotMethod2ManyBodiesFarEquatorialPerspective(
+    benchmark::State& state) {
+  RunMoonsBenchmark(state, EquatorialPerspective(far));
 }
 
 BENCHMARK(BM_PlanetariumPlotMethod2NearPolarPerspective)
@@ -260,6 +407,16 @@ BENCHMARK(BM_PlanetariumPlotMethod2NearEquatorialPerspective)
     ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_PlanetariumPlotMethod2FarEquatorialPerspective)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PlanetariumPlotMethod2ManyBodiesFarPolarPerspective)
+    ->Arg(0)
+    ->Arg(20)
+    ->Arg(59)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PlanetariumPlotMethod2ManyBodiesFarEquatorialPerspective)
+    ->Arg(0)
+    ->Arg(20)
+    ->Arg(59)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace geometry
 }  // namespace principia
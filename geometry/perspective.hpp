@@ -71,6 +71,14 @@ class Perspective final {
   // Returns sin² α where α is the half angle under which the |sphere| is seen.
   double SphereSin²HalfAngle(Sphere<FromFrame> const& sphere) const;
 
+  // Returns the smallest rectangle of the focal plane, with sides parallel to
+  // the x- and y- axes, that contains the projection of |sphere|, as its
+  // lower-left and upper-right corners.  Returns nullopt if the sphere is not
+  // entirely in front of the camera, as its projection is unbounded then.
+  std::optional<
+      std::pair<RP2Point<Length, ToFrame>, RP2Point<Length, ToFrame>>>
+  SphereBoundingBox(Sphere<FromFrame> const& sphere) const;
+
   // Returns the (sub)segments of |segment| that are visible in this perspective
   // after taking into account the hiding by |sphere|.  The returned vector has
   // 0, 1, or 2 elements.
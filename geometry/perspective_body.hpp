@@ -5,10 +5,12 @@
 #include <algorithm>
 #include <deque>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "geometry/barycentre_calculator.hpp"
 #include "numerics/root_finders.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 
 namespace principia {
@@ -161,6 +163,37 @@ double Perspective<FromFrame, ToFrame>::SphereSin²HalfAngle(
   return std::min(1.0, sphere.radius²() / KC²);
 }
 
+template<typename FromFrame, typename ToFrame>
+std::optional<std::pair<RP2Point<Length, ToFrame>, RP2Point<Length, ToFrame>>>
+Perspective<FromFrame, ToFrame>::SphereBoundingBox(
+    Sphere<FromFrame> const& sphere) const {
+  R3Element<Length> const c =
+      (to_camera_(sphere.centre()) - ToFrame::origin).coordinates();
+  Length const& r = sphere.radius();
+  if (c.z <= r) {
+    return std::nullopt;
+  }
+
+  // The sides of the rectangle are the intersections of the focal plane with
+  // the planes that contain the camera, are parallel to the y- (respectively
+  // x-) axis, and are tangent to the sphere.  Such a plane has the equation
+  // x = μ z; writing that its distance to the centre is r yields a quadratic
+  // equation in μ:
+  //   (c.z² - r²) μ² - 2 c.x c.z μ + c.x² - r² = 0
+  // whose discriminant is always positive since c.z > r.
+  auto const c_z² = c.z * c.z;
+  auto const denominator = c_z² - r * r;
+  auto const half_width = r * Sqrt(c.x * c.x + denominator);
+  auto const half_height = r * Sqrt(c.y * c.y + denominator);
+  double const x_min = (c.x * c.z - half_width) / denominator;
+  double const x_max = (c.x * c.z + half_width) / denominator;
+  double const y_min = (c.y * c.z - half_height) / denominator;
+  double const y_max = (c.y * c.z + half_height) / denominator;
+  return std::pair(
+      RP2Point<Length, ToFrame>(focal_ * x_min, focal_ * y_min, /*z=*/1),
+      RP2Point<Length, ToFrame>(focal_ * x_max, focal_ * y_max, /*z=*/1));
+}
+
 template<typename FromFrame, typename ToFrame>
 BoundedArray<Segment<FromFrame>, 2>
 Perspective<FromFrame, ToFrame>::VisibleSegments(
@@ -193,6 +193,44 @@ TEST_F(PerspectiveTest, SphereSin²HalfAngle) {
               AlmostEquals(0.0001, 0));
 }
 
+TEST_F(PerspectiveTest, SphereBoundingBox) {
+  Perspective<World, Camera> perspective(Similarity<World, Camera>::Identity(),
+                                         /*focal=*/1 * Metre);
+
+  Sphere<World> const centred_sphere(
+      World::origin + Displacement<World>({0 * Metre, 0 * Metre, 100 * Metre}),
+      /*radius=*/1 * Metre);
+  auto const centred_box = perspective.SphereBoundingBox(centred_sphere);
+  ASSERT_TRUE(centred_box.has_value());
+  EXPECT_THAT(centred_box->first.x(),
+              AlmostEquals(-1 / Sqrt(9999.0) * Metre, 0, 1));
+  EXPECT_THAT(centred_box->first.y(),
+              AlmostEquals(-1 / Sqrt(9999.0) * Metre, 0, 1));
+  EXPECT_THAT(centred_box->second.x(),
+              AlmostEquals(1 / Sqrt(9999.0) * Metre, 0, 1));
+  EXPECT_THAT(centred_box->second.y(),
+              AlmostEquals(1 / Sqrt(9999.0) * Metre, 0, 1));
+
+  // The projection of an off-axis sphere is stretched away from the centre of
+  // the focal plane.
+  Sphere<World> const shifted_sphere(
+      World::origin + Displacement<World>({10 * Metre, 0 * Metre, 100 * Metre}),
+      /*radius=*/1 * Metre);
+  auto const shifted_box = perspective.SphereBoundingBox(shifted_sphere);
+  ASSERT_TRUE(shifted_box.has_value());
+  EXPECT_THAT(shifted_box->first.x(),
+              AlmostEquals((1000 - Sqrt(10099.0)) / 9999 * Metre, 0, 4));
+  EXPECT_THAT(shifted_box->second.x(),
+              AlmostEquals((1000 + Sqrt(10099.0)) / 9999 * Metre, 0, 4));
+  EXPECT_THAT(shifted_box->second.y(),
+              AlmostEquals(1 / Sqrt(9999.0) * Metre, 0, 1));
+
+  Sphere<World> const sphere_around_camera(
+      World::origin + Displacement<World>({0 * Metre, 0 * Metre, 1 * Metre}),
+      /*radius=*/2 * Metre);
+  EXPECT_FALSE(perspective.SphereBoundingBox(sphere_around_camera).has_value());
+}
+
 TEST_F(PerspectiveTest, Output) {
   Perspective<World, Camera> perspective(Similarity<World, Camera>::Identity(),
                                          /*focal=*/1 * Metre);
@@ -0,0 +1,151 @@
+#include "journal/journal_index.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include "base/fingerprint2011.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace journal {
+namespace _journal_index {
+namespace internal {
+
+using namespace principia::base::_fingerprint2011;
+
+namespace {
+
+// The header of the cache file, which is followed by |number_of_offsets|
+// offsets, all stored in the native byte order: the cache is not meant to be
+// shared across machines.
+struct CacheHeader {
+  std::uint64_t magic;
+  std::uint64_t indexed_size;
+  std::uint64_t fingerprint;
+  std::uint64_t number_of_offsets;
+};
+
+constexpr std::uint64_t cache_magic = 0x31'58'45'44'4E'49'4A'50;  // "PJINDEX1".
+// The number of bytes at the beginning and at the end of the indexed part of a
+// journal that are used to check that a cache matches it.
+constexpr std::int64_t fingerprinted_bytes = 4096;
+
+}  // namespace
+
+JournalIndex::JournalIndex(std::string_view const journal) {
+  Extend(journal);
+}
+
+JournalIndex JournalIndex::ReadOrBuild(std::filesystem::path const& path,
+                                       std::string_view const journal) {
+  auto const cache_path = CachePath(path);
+  JournalIndex index;
+  if (index.ReadCache(cache_path, journal)) {
+    std::int64_t const cached_lines = index.number_of_lines();
+    index.Extend(journal);
+    if (index.number_of_lines() == cached_lines) {
+      return index;
+    }
+  } else {
+    index.line_starts_ = {0};
+    index.Extend(journal);
+  }
+  index.WriteCache(cache_path, journal);
+  return index;
+}
+
+std::filesystem::path JournalIndex::CachePath(
+    std::filesystem::path const& path) {
+  std::filesystem::path result = path;
+  result += ".index";
+  return result;
+}
+
+std::int64_t JournalIndex::number_of_lines() const {
+  return line_starts_.size() - 1;
+}
+
+std::string_view JournalIndex::line(std::string_view const journal,
+                                    std::int64_t const i) const {
+  CHECK_LE(0, i);
+  CHECK_LT(i, number_of_lines());
+  std::int64_t const start = line_starts_[i];
+  // Exclude the "\n" and, for journals written in text mode on Windows, the
+  // "\r" that precedes it.
+  std::int64_t end = line_starts_[i + 1] - 1;
+  if (end > start && journal[end - 1] == '\r') {
+    --end;
+  }
+  return journal.substr(start, end - start);
+}
+
+void JournalIndex::Extend(std::string_view const journal) {
+  std::int64_t start = line_starts_.back();
+  CHECK_LE(start, static_cast<std::int64_t>(journal.size()));
+  for (;;) {
+    auto const newline = journal.find('\n', start);
+    if (newline == std::string_view::npos) {
+      break;
+    }
+    start = newline + 1;
+    line_starts_.push_back(start);
+  }
+}
+
+bool JournalIndex::ReadCache(std::filesystem::path const& cache_path,
+                             std::string_view const journal) {
+  std::ifstream stream(cache_path, std::ios::in | std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  CacheHeader header;
+  if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != cache_magic ||
+      header.indexed_size > journal.size() ||
+      header.fingerprint != Fingerprint(journal, header.indexed_size) ||
+      header.number_of_offsets == 0 ||
+      header.number_of_offsets > header.indexed_size + 1) {
+    return false;
+  }
+  line_starts_.resize(header.number_of_offsets);
+  if (!stream.read(reinterpret_cast<char*>(line_starts_.data()),
+                   line_starts_.size() * sizeof(line_starts_[0])) ||
+      line_starts_.front() != 0 ||
+      line_starts_.back() !=
+          static_cast<std::int64_t>(header.indexed_size)) {
+    return false;
+  }
+  return true;
+}
+
+void JournalIndex::WriteCache(std::filesystem::path const& cache_path,
+                              std::string_view const journal) const {
+  CacheHeader const header{
+      .magic = cache_magic,
+      .indexed_size = static_cast<std::uint64_t>(line_starts_.back()),
+      .fingerprint = Fingerprint(journal, line_starts_.back()),
+      .number_of_offsets = line_starts_.size()};
+  std::ofstream stream(cache_path,
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+  stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  stream.write(reinterpret_cast<char const*>(line_starts_.data()),
+               line_starts_.size() * sizeof(line_starts_[0]));
+  stream.close();
+  LOG_IF(WARNING, stream.fail()) << "Unable to write the journal index cache "
+                                 << cache_path;
+}
+
+std::uint64_t JournalIndex::Fingerprint(std::string_view const journal,
+                                        std::int64_t const size) {
+  std::int64_t const length = std::min(size, fingerprinted_bytes);
+  std::uint64_t const beginning = Fingerprint2011(journal.data(), length);
+  std::uint64_t const end =
+      Fingerprint2011(journal.data() + size - length, length);
+  return beginning ^ (end * 31) ^ static_cast<std::uint64_t>(size);
+}
+
+}  // namespace internal
+}  // namespace _journal_index
+}  // namespace journal
+}  // namespace principia
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace principia {
+namespace journal {
+namespace _journal_index {
+namespace internal {
+
+// The offsets of the lines of a journal, giving random access to its methods.
+// Line 2 i holds the method in of the i-th method, and line 2 i + 1 its method
+// out/return.  Only the lines terminated by a newline are indexed, so that the
+// partial line at the end of a journal that is still being written, or that
+// was truncated by a crash, is ignored.
+class JournalIndex final {
+ public:
+  // Indexes the given |journal| contents.
+  explicit JournalIndex(std::string_view journal);
+
+  // Returns the index of |journal|, which are the contents of the file at
+  // |path|.  Building the index of a large journal requires a pass over it, so
+  // the index is cached in the file at |CachePath(path)|.  A cached index that
+  // matches |journal| is reused; since journals are only ever appended to, a
+  // cached index of a prefix of |journal| is extended.  Otherwise the index is
+  // built and the cache (re)written.  Failing to write the cache is not fatal.
+  static JournalIndex ReadOrBuild(std::filesystem::path const& path,
+                                  std::string_view journal);
+
+  static std::filesystem::path CachePath(std::filesystem::path const& path);
+
+  std::int64_t number_of_lines() const;
+
+  // Returns the |i|-th line of |journal|, which must be the contents that were
+  // indexed, without its line terminator.
+  std::string_view line(std::string_view journal, std::int64_t i) const;
+
+ private:
+  JournalIndex() = default;
+
+  // Indexes the complete lines of |journal| that start at or after the end of
+  // the last indexed line.
+  void Extend(std::string_view journal);
+
+  // Returns true if |line_starts_| were read from a cache matching a prefix of
+  // |journal|.
+  bool ReadCache(std::filesystem::path const& cache_path,
+                 std::string_view journal);
+  void WriteCache(std::filesystem::path const& cache_path,
+                  std::string_view journal) const;
+
+  // A fingerprint of the parts of |journal| that identify it, namely its
+  // beginning and the end of its first |size| bytes.
+  static std::uint64_t Fingerprint(std::string_view journal,
+                                   std::int64_t size);
+
+  // The offset of the start of each line, followed by the offset of the end of
+  // the last complete line.  Never empty.
+  std::vector<std::int64_t> line_starts_ = {0};
+};
+
+}  // namespace internal
+
+using internal::JournalIndex;
+
+}  // namespace _journal_index
+}  // namespace journal
+}  // namespace principia
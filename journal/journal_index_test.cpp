@@ -0,0 +1,77 @@
+#include "journal/journal_index.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace journal {
+
+using namespace principia::journal::_journal_index;
+
+class JournalIndexTest : public testing::Test {
+ protected:
+  JournalIndexTest()
+      : path_(std::string(
+                  testing::UnitTest::GetInstance()->current_test_info()->name()) +
+              ".journal.hex") {
+    std::filesystem::remove(JournalIndex::CachePath(path_));
+  }
+
+  ~JournalIndexTest() override {
+    std::filesystem::remove(JournalIndex::CachePath(path_));
+  }
+
+  std::filesystem::path const path_;
+};
+
+TEST_F(JournalIndexTest, Lines) {
+  std::string_view const journal = "0a\r\n0b0c\n\n0d";
+  JournalIndex const index(journal);
+  // The last line is incomplete.
+  ASSERT_EQ(3, index.number_of_lines());
+  EXPECT_EQ("0a", index.line(journal, 0));
+  EXPECT_EQ("0b0c", index.line(journal, 1));
+  EXPECT_EQ("", index.line(journal, 2));
+}
+
+TEST_F(JournalIndexTest, Cache) {
+  std::string journal = "0a\n0b\n";
+  {
+    auto const index = JournalIndex::ReadOrBuild(path_, journal);
+    EXPECT_EQ(2, index.number_of_lines());
+    EXPECT_TRUE(std::filesystem::exists(JournalIndex::CachePath(path_)));
+  }
+  // The journal was appended to: the cached index is extended.
+  journal += "0c\n0d";
+  {
+    auto const index = JournalIndex::ReadOrBuild(path_, journal);
+    ASSERT_EQ(3, index.number_of_lines());
+    EXPECT_EQ("0c", index.line(journal, 2));
+  }
+  {
+    auto const index = JournalIndex::ReadOrBuild(path_, journal);
+    EXPECT_EQ(3, index.number_of_lines());
+  }
+  // The journal was replaced by one that is not an extension: the cached index
+  // is ignored.
+  journal = "0a0b\n0c0d0e\n";
+  {
+    auto const index = JournalIndex::ReadOrBuild(path_, journal);
+    ASSERT_EQ(2, index.number_of_lines());
+    EXPECT_EQ("0a0b", index.line(journal, 0));
+    EXPECT_EQ("0c0d0e", index.line(journal, 1));
+  }
+  // The journal was truncated.
+  journal = "0a0b\n";
+  {
+    auto const index = JournalIndex::ReadOrBuild(path_, journal);
+    ASSERT_EQ(1, index.number_of_lines());
+    EXPECT_EQ("0a0b", index.line(journal, 0));
+  }
+}
+
+}  // namespace journal
+}  // namespace principia
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -36,6 +37,10 @@ using namespace principia::base::_not_null;
 //    static void Run(Message const& message,
 //                    not_null<Player::PointerMap*> pointer_map);
 //  };
+//
+// Irrespective of journalling, the duration of each call, from the end of the
+// construction of the |Method| to the beginning of its destruction, is recorded
+// in the |MethodStatistics|.
 
 template<typename P, typename = void>
 struct has_in : std::false_type, not_constructible {};
@@ -91,10 +96,14 @@ class Method final {
   typename P::Return Return(typename P::Return const& result);
 
  private:
+  // The identifier of |Profile| in the |MethodStatistics|.
+  static int StatisticsId();
+
   std::function<void(not_null<typename Profile::Message*> message)> out_filler_;
   std::function<void(not_null<typename Profile::Message*> message)>
       return_filler_;
   bool returned_ = false;
+  std::chrono::steady_clock::time_point start_;
 };
 
 }  // namespace internal
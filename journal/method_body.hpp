@@ -4,6 +4,7 @@
 
 #include <list>
 
+#include "journal/method_statistics.hpp"
 #include "journal/recorder.hpp"
 
 namespace principia {
@@ -11,6 +12,7 @@ namespace journal {
 namespace _method {
 namespace internal {
 
+using namespace principia::journal::_method_statistics;
 using namespace principia::journal::_recorder;
 
 template<typename Profile>
@@ -21,6 +23,7 @@ Method<Profile>::Method() {
         method.MutableExtension(Profile::Message::extension);
     Recorder::active_recorder_->WriteAtConstruction(method);
   }
+  start_ = std::chrono::steady_clock::now();
 }
 
 template<typename Profile>
@@ -33,6 +36,7 @@ Method<Profile>::Method(typename P::In const& in) {
     Profile::Fill(in, message_in);
     Recorder::active_recorder_->WriteAtConstruction(method);
   }
+  start_ = std::chrono::steady_clock::now();
 }
 
 template<typename Profile>
@@ -48,6 +52,7 @@ Method<Profile>::Method(typename P::Out const& out) {
       Profile::Fill(out, message);
     };
   }
+  start_ = std::chrono::steady_clock::now();
 }
 
 template<typename Profile>
@@ -64,10 +69,13 @@ Method<Profile>::Method(typename P::In const& in, typename P::Out const& out) {
       Profile::Fill(out, message);
     };
   }
+  start_ = std::chrono::steady_clock::now();
 }
 
 template<typename Profile>
 Method<Profile>::~Method() {
+  MethodStatistics::Record(StatisticsId(),
+                           std::chrono::steady_clock::now() - start_);
   CHECK(returned_);
   if (Recorder::active_recorder_ != nullptr) {
     serialization::Method method;
@@ -105,6 +113,13 @@ typename P::Return Method<Profile>::Return(
   return result;
 }
 
+template<typename Profile>
+int Method<Profile>::StatisticsId() {
+  static int const id =
+      MethodStatistics::Register(Profile::Message::descriptor()->name());
+  return id;
+}
+
 }  // namespace internal
 }  // namespace _method
 }  // namespace journal
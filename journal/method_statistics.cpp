@@ -0,0 +1,246 @@
+#include "journal/method_statistics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "base/not_null.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace journal {
+namespace _method_statistics {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int max_methods = 512;
+
+// The counters of the calls to a method on one thread.  They are only written
+// by that thread, so they are incremented without read-modify-write
+// operations; they are atomic so that they may be read by other threads.
+struct Counters {
+  std::atomic<std::int64_t> count = 0;
+  std::atomic<std::int64_t> total_nanoseconds = 0;
+  std::array<std::atomic<std::int64_t>, MethodStatistics::number_of_buckets>
+      histogram{};
+};
+
+using ThreadCounters = std::array<Counters, max_methods>;
+
+void Increment(std::atomic<std::int64_t>& counter, std::int64_t const value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+class Registry {
+ public:
+  // Never destroyed, as it may be used by threads that exit after the static
+  // destructors have run.
+  static Registry& Instance();
+
+  int Register(std::string_view name);
+
+  // Returns counters for the exclusive use of the calling thread.
+  not_null<ThreadCounters*> Acquire();
+  // Called when a thread exits; the counters keep their values.
+  void Release(not_null<ThreadCounters*> counters);
+
+  std::vector<MethodStatistics::Summary> Get();
+  void Reset();
+
+ private:
+  // Returns the statistics of all the registered methods since the beginning
+  // of the process.
+  std::vector<MethodStatistics::Summary> Totals() const
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  mutable absl::Mutex lock_;
+  std::vector<std::string> names_ GUARDED_BY(lock_);
+  // All the counters ever acquired.  They are never deallocated, so that the
+  // calls made by threads that have exited are still counted.
+  std::vector<std::unique_ptr<ThreadCounters>> all_counters_ GUARDED_BY(lock_);
+  // The counters of the threads that have exited, available for reuse.
+  std::vector<not_null<ThreadCounters*>> free_counters_ GUARDED_BY(lock_);
+  // The value of |Totals()| at the last reset.
+  std::vector<MethodStatistics::Summary> baseline_ GUARDED_BY(lock_);
+};
+
+// The counters of the current thread, acquired at the first call that it
+// makes.
+class ThreadCountersHolder {
+ public:
+  ThreadCountersHolder();
+  ~ThreadCountersHolder();
+
+  ThreadCounters& counters() const;
+
+ private:
+  not_null<ThreadCounters*> const counters_;
+};
+
+Registry& Registry::Instance() {
+  static auto* const registry = new Registry;
+  return *registry;
+}
+
+int Registry::Register(std::string_view const name) {
+  absl::MutexLock l(&lock_);
+  CHECK_LT(names_.size(), static_cast<std::size_t>(max_methods)) << name;
+  names_.emplace_back(name);
+  return names_.size() - 1;
+}
+
+not_null<ThreadCounters*> Registry::Acquire() {
+  absl::MutexLock l(&lock_);
+  if (free_counters_.empty()) {
+    all_counters_.push_back(std::make_unique<ThreadCounters>());
+    return all_counters_.back().get();
+  } else {
+    auto const counters = free_counters_.back();
+    free_counters_.pop_back();
+    return counters;
+  }
+}
+
+void Registry::Release(not_null<ThreadCounters*> const counters) {
+  absl::MutexLock l(&lock_);
+  free_counters_.push_back(counters);
+}
+
+std::vector<MethodStatistics::Summary> Registry::Get() {
+  absl::MutexLock l(&lock_);
+  std::vector<MethodStatistics::Summary> result;
+  auto const totals = Totals();
+  int const number_of_methods = totals.size();
+  int const number_of_baseline_methods = baseline_.size();
+  for (int id = 0; id < number_of_methods; ++id) {
+    MethodStatistics::Summary summary = totals[id];
+    if (id < number_of_baseline_methods) {
+      auto const& baseline = baseline_[id];
+      summary.count -= baseline.count;
+      summary.total_duration -= baseline.total_duration;
+      for (int i = 0; i < MethodStatistics::number_of_buckets; ++i) {
+        summary.histogram[i] -= baseline.histogram[i];
+      }
+    }
+    if (summary.count > 0) {
+      result.push_back(std::move(summary));
+    }
+  }
+  std::sort(result.begin(),
+            result.end(),
+            [](MethodStatistics::Summary const& left,
+               MethodStatistics::Summary const& right) {
+              return left.total_duration > right.total_duration;
+            });
+  return result;
+}
+
+void Registry::Reset() {
+  absl::MutexLock l(&lock_);
+  baseline_ = Totals();
+}
+
+std::vector<MethodStatistics::Summary> Registry::Totals() const {
+  int const number_of_methods = names_.size();
+  std::vector<MethodStatistics::Summary> totals(number_of_methods);
+  for (int id = 0; id < number_of_methods; ++id) {
+    auto& total = totals[id];
+    total.name = names_[id];
+    for (auto const& thread_counters : all_counters_) {
+      auto const& counters = (*thread_counters)[id];
+      total.count += counters.count.load(std::memory_order_relaxed);
+      total.total_duration += std::chrono::nanoseconds(
+          counters.total_nanoseconds.load(std::memory_order_relaxed));
+      for (int i = 0; i < MethodStatistics::number_of_buckets; ++i) {
+        total.histogram[i] +=
+            counters.histogram[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+  return totals;
+}
+
+ThreadCountersHolder::ThreadCountersHolder()
+    : counters_(Registry::Instance().Acquire()) {}
+
+ThreadCountersHolder::~ThreadCountersHolder() {
+  Registry::Instance().Release(counters_);
+}
+
+ThreadCounters& ThreadCountersHolder::counters() const {
+  return *counters_;
+}
+
+}  // namespace
+
+double MethodStatistics::Summary::QuantileInMicroseconds(
+    double const fraction) const {
+  double const rank = fraction * count;
+  std::int64_t cumulative_count = 0;
+  for (int i = 0; i < number_of_buckets - 1; ++i) {
+    cumulative_count += histogram[i];
+    if (cumulative_count >= rank) {
+      return std::int64_t{1} << i;
+    }
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+int MethodStatistics::Register(std::string_view const name) {
+  return Registry::Instance().Register(name);
+}
+
+void MethodStatistics::Record(int const id,
+                              std::chrono::nanoseconds const duration) {
+  static thread_local ThreadCountersHolder const holder;
+  auto& counters = holder.counters()[id];
+  std::uint64_t const microseconds = std::max<std::int64_t>(duration / 1us, 0);
+  int const bucket =
+      std::min<int>(std::bit_width(microseconds), number_of_buckets - 1);
+  Increment(counters.count, 1);
+  Increment(counters.total_nanoseconds, duration.count());
+  Increment(counters.histogram[bucket], 1);
+}
+
+std::vector<MethodStatistics::Summary> MethodStatistics::Get() {
+  return Registry::Instance().Get();
+}
+
+void MethodStatistics::Reset() {
+  Registry::Instance().Reset();
+}
+
+std::string MethodStatistics::Dump() {
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  std::string result =
+      "method\tcalls\ttotal_ms\tmean_us\tp50_us\tp90_us\tp99_us\thistogram\n";
+  for (auto const& summary : Get()) {
+    absl::StrAppend(&result,
+                    summary.name, "\t",
+                    summary.count, "\t",
+                    Milliseconds(summary.total_duration).count(), "\t",
+                    Microseconds(summary.total_duration).count() /
+                        summary.count, "\t",
+                    summary.QuantileInMicroseconds(0.5), "\t",
+                    summary.QuantileInMicroseconds(0.9), "\t",
+                    summary.QuantileInMicroseconds(0.99), "\t",
+                    absl::StrJoin(summary.histogram, ","), "\n");
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace _method_statistics
+}  // namespace journal
+}  // namespace principia
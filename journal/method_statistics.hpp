@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/not_constructible.hpp"
+
+namespace principia {
+namespace journal {
+namespace _method_statistics {
+namespace internal {
+
+using namespace principia::base::_not_constructible;
+
+// The number of calls and the latency histograms of the interface functions.
+// They are collected by |Method| for every call, whether or not a journal is
+// being recorded.  Recording a call is lock-free: each thread accumulates into
+// its own counters, which are only summed when the statistics are read.
+class MethodStatistics : not_constructible {
+ public:
+  // Bucket 0 of the latency histograms holds the calls that lasted less than
+  // 1 µs, and bucket i > 0 those that lasted between 2^(i-1) µs and 2^i µs.
+  // The last bucket is unbounded.
+  static constexpr int number_of_buckets = 24;
+
+  struct Summary {
+    std::string name;
+    std::int64_t count = 0;
+    std::chrono::nanoseconds total_duration{};
+    std::array<std::int64_t, number_of_buckets> histogram{};
+
+    // An upper bound of the latency below which lie the given |fraction| of the
+    // calls, determined from the histogram.  Infinite if the quantile falls in
+    // the last bucket.
+    double QuantileInMicroseconds(double fraction) const;
+  };
+
+  // Returns the identifier to pass to |Record| for the method with the given
+  // |name|.  Must be called once per method.
+  static int Register(std::string_view name);
+
+  // Records a call to the method |id| that lasted |duration|.
+  static void Record(int id, std::chrono::nanoseconds duration);
+
+  // Returns the statistics of the methods that were called since the last
+  // reset, by decreasing total duration.
+  static std::vector<Summary> Get();
+
+  // Starts a new period of collection of the statistics.
+  static void Reset();
+
+  // Returns the statistics as a tab-separated table with a header line, for
+  // consumption by humans or by scripts.
+  static std::string Dump();
+};
+
+}  // namespace internal
+
+using internal::MethodStatistics;
+
+}  // namespace _method_statistics
+}  // namespace journal
+}  // namespace principia
@@ -0,0 +1,104 @@
+#include "journal/method_statistics.hpp"
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace journal {
+
+using namespace principia::journal::_method_statistics;
+using namespace std::chrono_literals;
+
+class MethodStatisticsTest : public ::testing::Test {
+ protected:
+  MethodStatisticsTest() {
+    MethodStatistics::Reset();
+  }
+
+  // The statistics are global, so other tests may have registered methods.
+  static MethodStatistics::Summary const* Find(
+      std::vector<MethodStatistics::Summary> const& statistics,
+      std::string const& name) {
+    for (auto const& summary : statistics) {
+      if (summary.name == name) {
+        return &summary;
+      }
+    }
+    return nullptr;
+  }
+};
+
+TEST_F(MethodStatisticsTest, RecordAndReset) {
+  int const fast = MethodStatistics::Register("Fast");
+  int const slow = MethodStatistics::Register("Slow");
+  int const unused = MethodStatistics::Register("Unused");
+  MethodStatistics::Record(fast, 500ns);
+  MethodStatistics::Record(fast, 3us);
+  MethodStatistics::Record(fast, 3us);
+  MethodStatistics::Record(slow, 1h);
+
+  auto statistics = MethodStatistics::Get();
+  ASSERT_GE(statistics.size(), 2);
+  EXPECT_EQ("Slow", statistics.front().name);
+  EXPECT_EQ(nullptr, Find(statistics, "Unused"));
+
+  auto const* const fast_summary = Find(statistics, "Fast");
+  ASSERT_NE(nullptr, fast_summary);
+  EXPECT_EQ(3, fast_summary->count);
+  EXPECT_EQ(6500ns, fast_summary->total_duration);
+  EXPECT_EQ(1, fast_summary->histogram[0]);
+  EXPECT_EQ(2, fast_summary->histogram[2]);
+  EXPECT_EQ(1, fast_summary->QuantileInMicroseconds(0.3));
+  EXPECT_EQ(4, fast_summary->QuantileInMicroseconds(0.5));
+
+  auto const* const slow_summary = Find(statistics, "Slow");
+  ASSERT_NE(nullptr, slow_summary);
+  EXPECT_EQ(1, slow_summary->histogram.back());
+  EXPECT_EQ(std::numeric_limits<double>::infinity(),
+            slow_summary->QuantileInMicroseconds(0.5));
+
+  MethodStatistics::Reset();
+  MethodStatistics::Record(fast, 1us);
+  statistics = MethodStatistics::Get();
+  EXPECT_EQ(nullptr, Find(statistics, "Slow"));
+  ASSERT_NE(nullptr, Find(statistics, "Fast"));
+  EXPECT_EQ(1, Find(statistics, "Fast")->count);
+  EXPECT_EQ(1, Find(statistics, "Fast")->histogram[1]);
+
+  std::string const dump = MethodStatistics::Dump();
+  EXPECT_TRUE(absl::StartsWith(dump, "method\tcalls\t")) << dump;
+  EXPECT_TRUE(absl::StrContains(dump, "\nFast\t1\t")) << dump;
+  MethodStatistics::Record(unused, 1us);
+}
+
+TEST_F(MethodStatisticsTest, Threads) {
+  int const id = MethodStatistics::Register("Threaded");
+  constexpr int threads = 8;
+  constexpr int calls = 10'000;
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([id]() {
+      for (int i = 0; i < calls; ++i) {
+        MethodStatistics::Record(id, 10us);
+      }
+    });
+  }
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  // The counts of the threads that have exited are retained.
+  auto const* const summary = Find(MethodStatistics::Get(), "Threaded");
+  ASSERT_NE(nullptr, summary);
+  EXPECT_EQ(threads * calls, summary->count);
+  EXPECT_EQ(threads * calls * 10us, summary->total_duration);
+  EXPECT_EQ(threads * calls, summary->histogram[4]);
+}
+
+}  // namespace journal
+}  // namespace principia
@@ -1,13 +1,15 @@
 #include "journal/player.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
-#include <string>
+#include <future>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "base/array.hpp"
-#include "base/get_line.hpp"
 #include "base/hexadecimal.hpp"
+#include "base/thread_pool.hpp"
 #include "base/version.hpp"
 #include "journal/profiles.hpp"
 #include "glog/logging.h"
@@ -21,26 +23,73 @@ namespace internal {
 
 using interface::principia__ActivatePlayer;
 using namespace principia::base::_array;
-using namespace principia::base::_get_line;
 using namespace principia::base::_hexadecimal;
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_version;
 
 using namespace std::chrono_literals;
 
 Player::Player(std::filesystem::path const& path)
-    : stream_(path, std::ios::in) {
+    : file_(path),
+      index_(JournalIndex::ReadOrBuild(path, file_.contents())) {
   principia__ActivatePlayer();
-  CHECK(!stream_.fail());
+}
+
+int Player::number_of_messages() const {
+  return index_.number_of_lines() / 2;
 }
 
 bool Player::Play(int const index) {
+  if (2 * index != next_line_) {
+    Seek(index);
+  }
   return Process(/*method_in=*/Read(), index, /*play=*/true);
 }
 
 bool Player::Scan(int const index) {
+  if (2 * index != next_line_) {
+    Seek(index);
+  }
   return Process(/*method_in=*/Read(), index, /*play=*/false);
 }
 
+void Player::set_skip_diagnostics(bool const skip_diagnostics) {
+  skip_diagnostics_ = skip_diagnostics;
+}
+
+void Player::Seek(int const index) {
+  CHECK_LE(0, index);
+  next_line_ = std::min(2 * static_cast<std::int64_t>(index),
+                        index_.number_of_lines());
+}
+
+void Player::ScanInParallel(Visitor const& visitor,
+                            int const number_of_threads) const {
+  CHECK_LT(0, number_of_threads);
+  // Use more chunks than threads, so that the load remains balanced if the
+  // sizes of the messages vary along the journal.
+  int const messages = number_of_messages();
+  int const chunks = std::min(messages, 16 * number_of_threads);
+  ThreadPool<void> pool(number_of_threads);
+  std::vector<std::future<void>> futures;
+  for (int chunk = 0; chunk < chunks; ++chunk) {
+    int const begin = static_cast<std::int64_t>(messages) * chunk / chunks;
+    int const end = static_cast<std::int64_t>(messages) * (chunk + 1) / chunks;
+    futures.push_back(pool.Add([this, begin, end, &visitor]() {
+      auto const contents = file_.contents();
+      for (int index = begin; index < end; ++index) {
+        auto const method_in = Parse(index_.line(contents, 2 * index));
+        auto const method_out_return =
+            Parse(index_.line(contents, 2 * index + 1));
+        visitor(index, *method_in, *method_out_return);
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+}
+
 serialization::Method const& Player::last_method_in() const {
   return *last_method_in_;
 }
@@ -50,13 +99,16 @@ serialization::Method const& Player::last_method_out_return() const {
 }
 
 std::unique_ptr<serialization::Method> Player::Read() {
-  std::string const line = GetLine(stream_);
-  if (line.empty()) {
+  if (next_line_ == index_.number_of_lines()) {
     return nullptr;
   }
+  return Parse(index_.line(file_.contents(), next_line_++));
+}
 
+std::unique_ptr<serialization::Method> Player::Parse(
+    std::string_view const line) {
   static auto* const encoder = new HexadecimalEncoder</*null_terminated=*/true>;
-  auto const bytes = encoder->Decode({line.c_str(), strlen(line.c_str())});
+  auto const bytes = encoder->Decode({line.data(), line.size()});
   auto method = std::make_unique<serialization::Method>();
   CHECK(method->ParseFromArray(bytes.data.get(), static_cast<int>(bytes.size)));
 
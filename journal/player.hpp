@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
+#include <functional>
 #include <map>
 #include <memory>
+#include <string_view>
 
+#include "base/mapped_file.hpp"
+#include "journal/journal_index.hpp"
 #include "serialization/journal.pb.h"
 
 namespace principia {
@@ -16,37 +20,82 @@ class RecorderTest;
 namespace _player {
 namespace internal {
 
+using namespace principia::base::_mapped_file;
+using namespace principia::journal::_journal_index;
+
+// The journal is mapped in memory and indexed, see |JournalIndex|, so the
+// player may start at any message and the messages may be parsed in parallel.
 class Player final {
  public:
   using PointerMap = std::map<std::uint64_t, void*>;
 
+  // The visitor of |ScanInParallel|.
+  using Visitor = std::function<void(
+      int index,
+      serialization::Method const& method_in,
+      serialization::Method const& method_out_return)>;
+
   explicit Player(std::filesystem::path const& path);
 
-  // Replays the next message in the journal.  Returns false at end of journal.
-  // |index| is the 0-based index of the message in the journal.
+  // The number of complete messages in the journal, i.e., of pairs of a method
+  // in and a method out/return.
+  int number_of_messages() const;
+
+  // Replays the message at |index|, the 0-based index of the message in the
+  // journal.  If it is not the message following the last one processed, first
+  // seeks to it.  Returns false at end of journal.
   bool Play(int index);
 
   // Same as |Play|, but does not execute the messages, only parse them.
   bool Scan(int index);
 
+  // If true, |Play| does not execute the methods that are only used for
+  // logging or for diagnostics, see the option |is_diagnostic| in
+  // journal.proto.  This is useful to replay a journal in a controlled
+  // environment, e.g., for benchmarking.  Defaults to false.
+  void set_skip_diagnostics(bool skip_diagnostics);
+
+  // Positions the player so that the next message processed is the one at
+  // |index|.  Note that the messages that are skipped are not replayed, so the
+  // objects that they would have created are not known to the player.
+  void Seek(int index);
+
+  // Parses all the complete messages of the journal on |number_of_threads|
+  // threads and calls |visitor| for each of them, in no particular order.
+  // |visitor| must be thread-safe.  This function does not execute the
+  // messages, does not check the version of the journal, and does not change
+  // the state of the player.
+  void ScanInParallel(Visitor const& visitor, int number_of_threads) const;
+
   // Return the last replayed messages.
   serialization::Method const& last_method_in() const;
   serialization::Method const& last_method_out_return() const;
 
  private:
-  // Reads one message from the stream.  Returns a |nullptr| at end of stream.
+  // Reads the next message.  Returns a |nullptr| at end of journal.
   std::unique_ptr<serialization::Method> Read();
 
+  // Parses the hexadecimal |line| of the journal.
+  static std::unique_ptr<serialization::Method> Parse(std::string_view line);
+
   // Implementation of |Play| and |Scan|.
   bool Process(std::unique_ptr<serialization::Method> method_in,
                int const index, bool const play);
 
+  // Runs |method_in| if it is a |Profile|, merged with its |method_out_return|,
+  // unless it |is_diagnostic| and the diagnostics are skipped.  Returns true
+  // iff |method_in| is a |Profile|.
   template<typename Profile>
   bool RunIfAppropriate(serialization::Method const& method_in,
-                        serialization::Method const& method_out_return);
+                        serialization::Method const& method_out_return,
+                        bool is_diagnostic);
 
   PointerMap pointer_map_;
-  std::ifstream stream_;
+  MappedFile const file_;
+  JournalIndex const index_;
+  // The index of the next line returned by |Read|.
+  std::int64_t next_line_ = 0;
+  bool skip_diagnostics_ = false;
 
   std::unique_ptr<serialization::Method> last_method_in_;
   std::unique_ptr<serialization::Method> last_method_out_return_;
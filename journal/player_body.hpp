@@ -13,12 +13,16 @@ namespace internal {
 
 template<typename Profile>
 bool Player::RunIfAppropriate(serialization::Method const& method_in,
-                              serialization::Method const& method_out_return) {
+                              serialization::Method const& method_out_return,
+                              bool const is_diagnostic) {
   if (method_in.HasExtension(Profile::Message::extension)) {
     CHECK(method_out_return.HasExtension(Profile::Message::extension))
         << "Unpaired methods:\n"
         << method_in.DebugString() << "\n"
         << method_out_return.DebugString();
+    if (is_diagnostic && skip_diagnostics_) {
+      return true;
+    }
     serialization::Method merged_method = method_in;
     merged_method.MergeFrom(method_out_return);
     Profile::Run(merged_method.GetExtension(Profile::Message::extension),
@@ -1,14 +1,19 @@
 #include "journal/player.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <list>
+#include <numeric>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "absl/synchronization/mutex.h"
 #include "benchmark/benchmark.h"
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "journal/journal_index.hpp"
 #include "journal/method.hpp"
 #include "journal/profiles.hpp"
 #include "journal/recorder.hpp"
@@ -18,6 +23,7 @@
 namespace principia {
 namespace journal {
 
+using namespace principia::journal::_journal_index;
 using namespace principia::journal::_player;
 using namespace principia::journal::_recorder;
 using namespace principia::ksp_plugin::_plugin;
@@ -50,7 +56,8 @@ class PlayerTest : public ::testing::Test {
   bool RunIfAppropriate(serialization::Method const& method_in,
                         serialization::Method const& method_out_return,
                         Player& player) {
-    return player.RunIfAppropriate<Profile>(method_in, method_out_return);
+    return player.RunIfAppropriate<Profile>(
+        method_in, method_out_return, /*is_diagnostic=*/false);
   }
 
   ::testing::TestInfo const* const test_info_;
@@ -86,6 +93,96 @@ TEST_F(PlayerTest, PlayTiny) {
   EXPECT_EQ(3, count);
 }
 
+TEST_F(PlayerTest, SeekAndScanInParallel) {
+  {
+    Recorder* const r(new Recorder(test_name_ + ".journal.hex"));
+    Recorder::Activate(r);
+
+    for (int i = 0; i < 10; ++i) {
+      {
+        Method<NewPlugin> m({"MJD1", "MJD2", 3});
+        m.Return(plugin_.get());
+      }
+      {
+        const Plugin* plugin = plugin_.get();
+        Method<DeletePlugin> m({&plugin}, {&plugin});
+        m.Return();
+      }
+    }
+    Recorder::Deactivate();
+  }
+
+  Player player(test_name_ + ".journal.hex");
+  EXPECT_EQ(21, player.number_of_messages());
+
+  // Random access.
+  EXPECT_TRUE(player.Scan(20));
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      serialization::DeletePlugin::extension));
+  EXPECT_FALSE(player.Scan(21));
+  EXPECT_TRUE(player.Scan(0));
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      serialization::GetVersion::extension));
+  player.Seek(5);
+  EXPECT_TRUE(player.Scan(5));
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      serialization::NewPlugin::extension));
+  EXPECT_TRUE(player.Scan(6));
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      serialization::DeletePlugin::extension));
+
+  absl::Mutex lock;
+  std::vector<int> indices;
+  int new_plugins = 0;
+  player.ScanInParallel(
+      [&lock, &indices, &new_plugins](
+          int const index,
+          serialization::Method const& method_in,
+          serialization::Method const& method_out_return) {
+        absl::MutexLock l(&lock);
+        indices.push_back(index);
+        if (method_in.HasExtension(serialization::NewPlugin::extension)) {
+          EXPECT_TRUE(method_out_return.HasExtension(
+              serialization::NewPlugin::extension));
+          ++new_plugins;
+        }
+      },
+      /*number_of_threads=*/4);
+  std::sort(indices.begin(), indices.end());
+  std::vector<int> expected_indices(21);
+  std::iota(expected_indices.begin(), expected_indices.end(), 0);
+  EXPECT_EQ(expected_indices, indices);
+  EXPECT_EQ(10, new_plugins);
+
+  // The index was cached next to the journal.
+  EXPECT_TRUE(std::filesystem::exists(
+      JournalIndex::CachePath(test_name_ + ".journal.hex")));
+}
+
+TEST_F(PlayerTest, SkipDiagnostics) {
+  int const buffer_duration = interface::principia__GetBufferDuration();
+  {
+    Recorder* const r(new Recorder(test_name_ + ".journal.hex"));
+    Recorder::Activate(r);
+    {
+      Method<SetBufferDuration> m({buffer_duration + 42});
+      m.Return();
+    }
+    Recorder::Deactivate();
+  }
+
+  Player player(test_name_ + ".journal.hex");
+  player.set_skip_diagnostics(true);
+  EXPECT_TRUE(player.Play(0));
+  EXPECT_TRUE(player.Play(1));
+  EXPECT_EQ(buffer_duration, interface::principia__GetBufferDuration());
+
+  player.set_skip_diagnostics(false);
+  EXPECT_TRUE(player.Play(1));
+  EXPECT_EQ(buffer_duration + 42, interface::principia__GetBufferDuration());
+  interface::principia__SetBufferDuration(buffer_duration);
+}
+
 TEST_F(PlayerTest, DISABLED_SECULAR_Benchmarks) {
   benchmark::RunSpecifiedBenchmarks();
 }
@@ -1,6 +1,9 @@
 #include "ksp_plugin/flight_plan.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -26,6 +29,8 @@ using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_si;
 using namespace principia::testing_utilities::_make_not_null;
 
+std::atomic<std::int64_t> FlightPlan::next_version_ = 0;
+
 inline absl::Status BadDesiredFinalTime() {
   return absl::Status(FlightPlan::bad_desired_final_time,
                       "Bad desired final time");
@@ -179,6 +184,9 @@ absl::Status FlightPlan::SetAdaptiveStepParameters(
         generalized_adaptive_step_parameters) {
   adaptive_step_parameters_ = adaptive_step_parameters;
   generalized_adaptive_step_parameters_ = generalized_adaptive_step_parameters;
+  // The cached segments are keyed by the parameters, so they are unlikely to be
+  // restored again.
+  segment_cache_.Clear();
   return RecomputeAllSegments();
 }
 
@@ -207,6 +215,10 @@ DiscreteTrajectory<Barycentric> const& FlightPlan::GetAllSegments() const {
   return trajectory_;
 }
 
+std::int64_t FlightPlan::version() const {
+  return version_;
+}
+
 OrbitAnalyser::Analysis* FlightPlan::analysis(int coast_index) {
   if (coast_index > manœuvres_.size() - number_of_anomalous_manœuvres()) {
     // If the coast follows an anomalous manœuvre, no valid initial state was
@@ -224,6 +236,15 @@ double FlightPlan::progress_of_analysis(int coast_index) const {
   return coast_analysers_[coast_index]->progress_of_next_analysis();
 }
 
+FlightPlanSegmentCache::Statistics const&
+FlightPlan::segment_cache_statistics() const {
+  return segment_cache_.statistics();
+}
+
+void FlightPlan::SetGraveyard(Graveyard* const graveyard) {
+  graveyard_ = graveyard;
+}
+
 void FlightPlan::WriteToMessage(
     not_null<serialization::FlightPlan*> const message) const {
   initial_mass_.WriteToMessage(message->mutable_initial_mass());
@@ -342,21 +363,35 @@ absl::Status FlightPlan::BurnSegment(
       ephemeris_->AwaitReanimation(starting_time);
     }
 
+    auto const key = FlightPlanSegmentCache::BurnKey(
+        segment->front().degrees_of_freedom,
+        manœuvre,
+        adaptive_step_parameters_,
+        generalized_adaptive_step_parameters_);
+    if (segment_cache_.Restore(key, &trajectory_)) {
+      return absl::OkStatus();
+    }
+
+    absl::Status status;
     if (manœuvre.is_inertially_fixed()) {
-      return ephemeris_->FlowWithAdaptiveStep(
-                             &trajectory_,
-                             manœuvre.InertialIntrinsicAcceleration(),
-                             final_time,
-                             adaptive_step_parameters_,
-                             max_ephemeris_steps_per_frame);
+      status = ephemeris_->FlowWithAdaptiveStep(
+                               &trajectory_,
+                               manœuvre.InertialIntrinsicAcceleration(),
+                               final_time,
+                               adaptive_step_parameters_,
+                               max_ephemeris_steps_per_frame);
     } else {
-      return ephemeris_->FlowWithAdaptiveStep(
-                             &trajectory_,
-                             manœuvre.FrenetIntrinsicAcceleration(),
-                             final_time,
-                             generalized_adaptive_step_parameters_,
-                             max_ephemeris_steps_per_frame);
+      status = ephemeris_->FlowWithAdaptiveStep(
+                               &trajectory_,
+                               manœuvre.FrenetIntrinsicAcceleration(),
+                               final_time,
+                               generalized_adaptive_step_parameters_,
+                               max_ephemeris_steps_per_frame);
     }
+    if (status.ok()) {
+      segment_cache_.Store(key, segment);
+    }
+    return status;
   } else {
     return absl::OkStatus();
   }
@@ -372,12 +407,25 @@ absl::Status FlightPlan::CoastSegment(
     ephemeris_->AwaitReanimation(starting_time);
   }
 
-  return ephemeris_->FlowWithAdaptiveStep(
-                         &trajectory_,
-                         Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-                         desired_final_time,
-                         adaptive_step_parameters_,
-                         max_ephemeris_steps_per_frame);
+  auto const& [initial_time, initial_degrees_of_freedom] = segment->front();
+  auto const key = FlightPlanSegmentCache::CoastKey(initial_time,
+                                                    desired_final_time,
+                                                    initial_degrees_of_freedom,
+                                                    adaptive_step_parameters_);
+  if (segment->size() == 1 && segment_cache_.Restore(key, &trajectory_)) {
+    return absl::OkStatus();
+  }
+
+  absl::Status const status = ephemeris_->FlowWithAdaptiveStep(
+      &trajectory_,
+      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+      desired_final_time,
+      adaptive_step_parameters_,
+      max_ephemeris_steps_per_frame);
+  if (status.ok()) {
+    segment_cache_.Store(key, segment);
+  }
+  return status;
 }
 
 absl::Status FlightPlan::ComputeSegments(
@@ -443,6 +491,7 @@ absl::Status FlightPlan::ComputeSegments(
       anomalous_status_ = status;
     }
   }
+  UpdateVersion();
   return overall_status;
 }
 
@@ -456,6 +505,7 @@ void FlightPlan::AddLastSegment() {
 void FlightPlan::ResetLastSegment() {
   auto const last_segment = segments_.back();
   trajectory_.ForgetAfter(std::next(last_segment->begin()));
+  UpdateVersion();
   if (anomalous_segments_ == 1) {
     anomalous_segments_ = 0;
   }
@@ -463,11 +513,16 @@ void FlightPlan::ResetLastSegment() {
 
 void FlightPlan::PopLastSegment() {
   auto last_segment = segments_.back();
-  trajectory_.DeleteSegments(last_segment);
+  auto popped_segment = trajectory_.DetachSegments(last_segment);
   segments_.pop_back();
+  UpdateVersion();
   if (anomalous_segments_ > 0) {
     --anomalous_segments_;
   }
+  if (graveyard_ != nullptr) {
+    graveyard_->Bury(std::make_unique<DiscreteTrajectory<Barycentric>>(
+        std::move(popped_segment)));
+  }
 }
 
 void FlightPlan::PopSegmentsAffectedByManœuvre(int const index) {
@@ -491,6 +546,10 @@ void FlightPlan::UpdateInitialMassOfManœuvresAfter(int const index) {
   }
 }
 
+void FlightPlan::UpdateVersion() {
+  version_ = next_version_.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 Instant FlightPlan::start_of_last_coast() const {
   return manœuvres_.empty() ? initial_time_ : manœuvres_.back().final_time();
 }
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
 #include "absl/status/status.h"
+#include "base/graveyard.hpp"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
+#include "ksp_plugin/flight_plan_segment_cache.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/manœuvre.hpp"
 #include "ksp_plugin/orbit_analyser.hpp"
@@ -22,9 +26,11 @@ namespace ksp_plugin {
 namespace _flight_plan {
 namespace internal {
 
+using namespace principia::base::_graveyard;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_instant;
 using namespace principia::integrators::_integrators;
+using namespace principia::ksp_plugin::_flight_plan_segment_cache;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_orbit_analyser;
 using namespace principia::physics::_degrees_of_freedom;
@@ -118,10 +124,23 @@ class FlightPlan {
   GetSegment(int index) const;
   virtual DiscreteTrajectory<Barycentric> const& GetAllSegments() const;
 
+  // A number that changes whenever the segments of this flight plan change.
+  // It is unique among all flight plans, so it identifies the segments of a
+  // flight plan in the keys of caches.
+  virtual std::int64_t version() const;
+
   // |coast_index| must be in [0, number_of_manœuvres()].
   virtual OrbitAnalyser::Analysis* analysis(int coast_index);
   double progress_of_analysis(int coast_index) const;
 
+  // Statistics about the reuse of previously computed segments.
+  FlightPlanSegmentCache::Statistics const& segment_cache_statistics() const;
+
+  // If |graveyard| is not null, the trajectories that are dropped when the
+  // segments are recomputed are destroyed asynchronously by |graveyard|, which
+  // must outlive this object.
+  void SetGraveyard(Graveyard* graveyard);
+
   void WriteToMessage(not_null<serialization::FlightPlan*> message) const;
 
   // This may return a null pointer if the flight plan contained in the
@@ -132,6 +151,9 @@ class FlightPlan {
 
   static constexpr std::int64_t max_ephemeris_steps_per_frame = 1000;
 
+  // The maximum number of points retained by the cache of segments.
+  static constexpr std::int64_t max_cached_segment_points = 100'000;
+
   static constexpr absl::StatusCode bad_desired_final_time =
       absl::StatusCode::kOutOfRange;
   static constexpr absl::StatusCode does_not_fit =
@@ -148,13 +170,15 @@ class FlightPlan {
   absl::Status RecomputeAllSegments();
 
   // Flows the given |segment| for the duration of |manœuvre| using its
-  // intrinsic acceleration.
+  // intrinsic acceleration.  The burn is restored from |segment_cache_| if
+  // possible.
   absl::Status BurnSegment(
       NavigationManœuvre const& manœuvre,
       DiscreteTrajectorySegmentIterator<Barycentric> segment);
 
   // Flows the given |segment| until |desired_final_time| with no intrinsic
-  // acceleration.
+  // acceleration.  If |segment| only contains its initial point, the coast is
+  // restored from |segment_cache_| if possible.
   absl::Status CoastSegment(
       Instant const& desired_final_time,
       DiscreteTrajectorySegmentIterator<Barycentric> segment);
@@ -192,6 +216,9 @@ class FlightPlan {
   // initial masses from |manœuvres_[index].final_mass()|.
   void UpdateInitialMassOfManœuvresAfter(int index);
 
+  // Gives a new value to |version_|.
+  void UpdateVersion();
+
   Instant start_of_last_coast() const;
 
   // In the following functions, |index| refers to the index of a manœuvre.
@@ -224,6 +251,16 @@ class FlightPlan {
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
   Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters
       generalized_adaptive_step_parameters_;
+
+  // The segments that we computed, including those that were since popped, so
+  // that they may be reused instead of being integrated again.
+  FlightPlanSegmentCache segment_cache_{max_cached_segment_points};
+
+  Graveyard* graveyard_ = nullptr;
+
+  std::int64_t version_ = 0;
+  // The source of the versions of all the flight plans.
+  static std::atomic<std::int64_t> next_version_;
 };
 
 }  // namespace internal
@@ -0,0 +1,164 @@
+#include "ksp_plugin/flight_plan_segment_cache.hpp"
+
+#include <iterator>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "glog/logging.h"
+#include "serialization/geometry.pb.h"
+#include "serialization/ksp_plugin.pb.h"
+#include "serialization/physics.pb.h"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _flight_plan_segment_cache {
+namespace internal {
+
+// Appends |message| to |key| prefixed by its length, so that the concatenation
+// of several messages is unambiguous.
+inline void AppendToKey(google::protobuf::Message const& message,
+                        FlightPlanSegmentCache::Key& key) {
+  std::string const serialized = message.SerializeAsString();
+  absl::StrAppend(&key, serialized.size(), ":", serialized);
+}
+
+double FlightPlanSegmentCache::Statistics::hit_rate() const {
+  std::int64_t const lookups = hits + misses;
+  return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+FlightPlanSegmentCache::FlightPlanSegmentCache(std::int64_t const max_points)
+    : max_points_(max_points) {
+  CHECK_LE(0, max_points_);
+}
+
+FlightPlanSegmentCache::Key FlightPlanSegmentCache::CoastKey(
+    Instant const& initial_time,
+    Instant const& final_time,
+    DegreesOfFreedom<Barycentric> const& initial_degrees_of_freedom,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const&
+        adaptive_step_parameters) {
+  serialization::Point initial_time_message;
+  initial_time.WriteToMessage(&initial_time_message);
+  serialization::Point final_time_message;
+  final_time.WriteToMessage(&final_time_message);
+  serialization::Pair initial_degrees_of_freedom_message;
+  initial_degrees_of_freedom.WriteToMessage(
+      &initial_degrees_of_freedom_message);
+  serialization::AdaptiveStepParameters adaptive_step_parameters_message;
+  adaptive_step_parameters.WriteToMessage(&adaptive_step_parameters_message);
+
+  Key key = "coast;";
+  AppendToKey(initial_time_message, key);
+  AppendToKey(final_time_message, key);
+  AppendToKey(initial_degrees_of_freedom_message, key);
+  AppendToKey(adaptive_step_parameters_message, key);
+  return key;
+}
+
+FlightPlanSegmentCache::Key FlightPlanSegmentCache::BurnKey(
+    DegreesOfFreedom<Barycentric> const& initial_degrees_of_freedom,
+    NavigationManœuvre const& manœuvre,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const&
+        adaptive_step_parameters,
+    Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
+        generalized_adaptive_step_parameters) {
+  serialization::Pair initial_degrees_of_freedom_message;
+  initial_degrees_of_freedom.WriteToMessage(
+      &initial_degrees_of_freedom_message);
+  serialization::Manoeuvre manœuvre_message;
+  manœuvre.WriteToMessage(&manœuvre_message);
+  serialization::AdaptiveStepParameters adaptive_step_parameters_message;
+  if (manœuvre.is_inertially_fixed()) {
+    adaptive_step_parameters.WriteToMessage(&adaptive_step_parameters_message);
+  } else {
+    generalized_adaptive_step_parameters.WriteToMessage(
+        &adaptive_step_parameters_message);
+  }
+
+  // The initial time is part of the manœuvre.
+  Key key = "burn;";
+  AppendToKey(initial_degrees_of_freedom_message, key);
+  AppendToKey(manœuvre_message, key);
+  AppendToKey(adaptive_step_parameters_message, key);
+  return key;
+}
+
+bool FlightPlanSegmentCache::Restore(
+    Key const& key,
+    not_null<DiscreteTrajectory<Barycentric>*> const trajectory) {
+  auto const it = entries_by_key_.find(key);
+  if (it == entries_by_key_.end()) {
+    ++statistics_.misses;
+    return false;
+  }
+  ++statistics_.hits;
+
+  // Mark the entry as most recently used.
+  Entries::iterator const entry = it->second;
+  entries_.splice(entries_.begin(), entries_, entry);
+
+  // The first point is a copy of the last point of the preceding segment, it is
+  // already in the trajectory.
+  auto const& points = entry->points;
+  for (auto p = std::next(points.begin()); p != points.end(); ++p) {
+    CHECK_OK(trajectory->Append(p->time, p->degrees_of_freedom));
+  }
+  return true;
+}
+
+void FlightPlanSegmentCache::Store(
+    Key const& key,
+    DiscreteTrajectorySegmentIterator<Barycentric> const segment) {
+  std::int64_t const size = segment->size();
+  if (size > max_points_) {
+    return;
+  }
+
+  // The key determines the segment, so an existing entry is identical to
+  // |segment|.
+  if (auto const it = entries_by_key_.find(key); it != entries_by_key_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  ++statistics_.entries;
+  entries_.push_front({.key = key});
+  Entries::iterator const entry = entries_.begin();
+  entries_by_key_.emplace(key, entry);
+  entry->points.reserve(size);
+  for (auto const& point : *segment) {
+    entry->points.push_back(point);
+  }
+  statistics_.points += size;
+  EvictIfNeeded();
+}
+
+void FlightPlanSegmentCache::Clear() {
+  entries_by_key_.clear();
+  entries_.clear();
+  statistics_.entries = 0;
+  statistics_.points = 0;
+}
+
+FlightPlanSegmentCache::Statistics const&
+FlightPlanSegmentCache::statistics() const {
+  return statistics_;
+}
+
+void FlightPlanSegmentCache::EvictIfNeeded() {
+  while (statistics_.points > max_points_) {
+    CHECK(!entries_.empty());
+    Entry const& least_recently_used = entries_.back();
+    statistics_.points -= least_recently_used.points.size();
+    entries_by_key_.erase(least_recently_used.key);
+    entries_.pop_back();
+    --statistics_.entries;
+    ++statistics_.evictions;
+  }
+}
+
+}  // namespace internal
+}  // namespace _flight_plan_segment_cache
+}  // namespace ksp_plugin
+}  // namespace principia
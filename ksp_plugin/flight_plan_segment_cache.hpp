@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/discrete_trajectory_segment_iterator.hpp"
+#include "physics/ephemeris.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _flight_plan_segment_cache {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_discrete_trajectory_segment_iterator;
+using namespace principia::physics::_ephemeris;
+
+// A content-addressed cache of the coasts and burns of a |FlightPlan|.  A
+// segment is identified by its initial state and by everything that affects its
+// integration, so a segment that was popped because an earlier manœuvre was
+// edited may be restored without integration if it turns out to be unchanged,
+// e.g., when the edit is undone.  The cache retains a bounded number of points
+// and evicts the least recently used segments.  This class is not thread-safe.
+class FlightPlanSegmentCache {
+ public:
+  using Key = std::string;
+
+  struct Statistics {
+    std::int64_t hits = 0;
+    std::int64_t misses = 0;
+    std::int64_t evictions = 0;
+    std::int64_t entries = 0;
+    std::int64_t points = 0;
+
+    // The fraction of the calls to |Restore| that found a segment, or 0 if
+    // there was no such call.
+    double hit_rate() const;
+  };
+
+  explicit FlightPlanSegmentCache(std::int64_t max_points);
+
+  // The key of a coast from |initial_time| to |final_time| starting with
+  // |initial_degrees_of_freedom|.  The final time is part of the key because a
+  // coast that would be extended from the end of a cached one would not take
+  // the same steps as one integrated from its initial state, and the flight
+  // plan would depend on the history of its edits.
+  static Key CoastKey(
+      Instant const& initial_time,
+      Instant const& final_time,
+      DegreesOfFreedom<Barycentric> const& initial_degrees_of_freedom,
+      Ephemeris<Barycentric>::AdaptiveStepParameters const&
+          adaptive_step_parameters);
+
+  // The key of the burn of |manœuvre| starting with
+  // |initial_degrees_of_freedom|.  Only the parameters that are actually used
+  // by the burn are part of the key.
+  static Key BurnKey(
+      DegreesOfFreedom<Barycentric> const& initial_degrees_of_freedom,
+      NavigationManœuvre const& manœuvre,
+      Ephemeris<Barycentric>::AdaptiveStepParameters const&
+          adaptive_step_parameters,
+      Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
+          generalized_adaptive_step_parameters);
+
+  // If a segment with the given |key| is in the cache, appends to the last
+  // segment of |trajectory| the points of the cached segment that follow its
+  // first one, and returns true.  Otherwise returns false and leaves
+  // |trajectory| unchanged.
+  bool Restore(Key const& key,
+               not_null<DiscreteTrajectory<Barycentric>*> trajectory);
+
+  // Records the points of |segment| under |key|, unless there is already an
+  // entry for that key.  Segments that exceed the capacity of the cache are not
+  // recorded.
+  void Store(Key const& key,
+             DiscreteTrajectorySegmentIterator<Barycentric> segment);
+
+  // Removes all the entries, e.g., when they may no longer be restored because
+  // the integration parameters have changed.
+  void Clear();
+
+  Statistics const& statistics() const;
+
+ private:
+  struct Entry {
+    Key key;
+    std::vector<DiscreteTrajectory<Barycentric>::value_type> points;
+  };
+  using Entries = std::list<Entry>;
+
+  // Evicts the least recently used entries until at most |max_points_| points
+  // are retained.
+  void EvictIfNeeded();
+
+  std::int64_t const max_points_;
+
+  // Most recently used first.
+  Entries entries_;
+  absl::flat_hash_map<Key, Entries::iterator> entries_by_key_;
+
+  Statistics statistics_;
+};
+
+}  // namespace internal
+
+using internal::FlightPlanSegmentCache;
+
+}  // namespace _flight_plan_segment_cache
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -28,7 +28,8 @@ using namespace principia::quantities::_si;
 
 GeometricPotentialPlotter::GeometricPotentialPlotter(
     not_null<Ephemeris<Barycentric>*> const ephemeris)
-    : ephemeris_(ephemeris) {}
+    : ephemeris_(ephemeris),
+      thread_pool_(/*pool_size=*/HardwareConcurrency()) {}
 
 void GeometricPotentialPlotter::Interrupt() {
   plotter_ = jthread();
@@ -119,14 +120,15 @@ absl::Status GeometricPotentialPlotter::PlotEquipotentials(
       &reference_frame,
       characteristic_length);
 
-  // TODO(phl): Make this interruptible.
+  // The search returns early if this thread is stopped.
   auto const arg_maximorum =
       MultiLevelSingleLinkage<SpecificEnergy, Position<Navigation>, 2>(
-          box, potential, gradient)
+          box, potential, gradient, &thread_pool_)
           .FindGlobalMaxima(
               /*points_per_round=*/1000,
               /*number_of_rounds=*/std::nullopt,
               /*local_search_tolerance=*/1e-3 * Metre);
+  RETURN_IF_STOPPED;
   SpecificEnergy maximum_maximorum = -Infinity<SpecificEnergy>;
   for (auto const& arg_maximum : arg_maximorum) {
     auto const maximum = potential(arg_maximum);
@@ -218,28 +220,30 @@ absl::Status GeometricPotentialPlotter::PlotEquipotentials(
   auto const towards_infinity = [](Position<Navigation> q) {
     return Navigation::origin + Normalize(q - Navigation::origin) * 3 * Metre;
   };
+  std::vector<SpecificEnergy> energies;
   for (int i = 1; i <= parameters.levels; ++i) {
-    RETURN_IF_STOPPED;
-    SpecificEnergy const energy =
-        maximum_maximorum - i * (1.0 / parameters.l1_level *
-                                 (maximum_maximorum - approx_l1_energy));
-    // TODO(phl): Make this interruptible.
-    auto lines = equipotential.ComputeLines(
-        plane, t, arg_maximorum, wells, towards_infinity, energy);
+    energies.push_back(maximum_maximorum -
+                       i * (1.0 / parameters.l1_level *
+                            (maximum_maximorum - approx_l1_energy)));
+  }
+  if (parameters.show_l245_level) {
+    energies.push_back(approx_l2_energy);
+    energies.push_back(l45_separator);
+  }
+
+  auto lines_by_energy = equipotential.ComputeLines(plane,
+                                                    t,
+                                                    arg_maximorum,
+                                                    wells,
+                                                    towards_infinity,
+                                                    energies,
+                                                    &thread_pool_);
+  RETURN_IF_STOPPED;
+  for (auto& lines : lines_by_energy) {
     equipotentials.lines.insert(equipotentials.lines.end(),
                                 std::make_move_iterator(lines.begin()),
                                 std::make_move_iterator(lines.end()));
   }
-  if (parameters.show_l245_level) {
-    for (SpecificEnergy const energy :
-         {approx_l2_energy, l45_separator}) {
-      auto lines = equipotential.ComputeLines(
-          plane, t, arg_maximorum, wells, towards_infinity, energy);
-      equipotentials.lines.insert(equipotentials.lines.end(),
-                                  std::make_move_iterator(lines.begin()),
-                                  std::make_move_iterator(lines.end()));
-    }
-  }
 
   absl::MutexLock l(&lock_);
   next_equipotentials_ = std::move(equipotentials);
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "base/jthread.hpp"
+#include "base/thread_pool.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "physics/equipotential.hpp"
 
@@ -13,6 +15,7 @@ namespace internal {
 
 using namespace principia::base::_jthread;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_instant;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_equipotential;
@@ -62,6 +65,11 @@ class GeometricPotentialPlotter {
 
   not_null<Ephemeris<Barycentric>*> const ephemeris_;
 
+  // Used by the |plotter_| to parallelize the search for the extrema of the
+  // potential and the computation of the lines at the various energies.  Must
+  // outlive the |plotter_|.
+  ThreadPool<void> thread_pool_;
+
   std::optional<Parameters> last_parameters_;
   std::optional<Equipotentials> equipotentials_;
 
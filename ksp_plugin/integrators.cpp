@@ -25,6 +25,7 @@ DefaultDownsamplingParameters() {
   return DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters{
       .max_dense_intervals = 10'000,
       .tolerance = 10 * Metre,
+      .asynchronous = true,
   };
 }
 
@@ -32,6 +32,7 @@
 #include "base/pull_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
+#include "base/thread_pool.hpp"
 #include "base/version.hpp"
 #include "gipfeli/gipfeli.h"
 #include "geometry/frame.hpp"
@@ -41,6 +42,7 @@
 #include "geometry/rotation.hpp"
 #include "google/protobuf/arena.h"
 #include "journal/method.hpp"
+#include "journal/method_statistics.hpp"
 #include "journal/profiles.hpp"
 #include "journal/recorder.hpp"
 #include "ksp_plugin/frames.hpp"
@@ -77,6 +79,7 @@ using namespace principia::base::_not_null;
 using namespace principia::base::_pull_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_version;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
@@ -86,6 +89,7 @@ using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_rotation;
 using namespace principia::integrators::_integrators;
+using namespace principia::journal::_method_statistics;
 using namespace principia::journal::_recorder;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
@@ -280,6 +284,13 @@ std::unique_ptr<google::compression::Compressor> NewCompressor(
   }
 }
 
+// The pool used to compress the chunks of a plugin save in parallel.
+ThreadPool<Array<std::uint8_t>>* CompressionThreadPool() {
+  static auto* const thread_pool = new ThreadPool<Array<std::uint8_t>>(
+      /*pool_size=*/HardwareConcurrency());
+  return thread_pool;
+}
+
 Encoder<char, /*null_terminated=*/true>*
 NewEncoder(std::string_view const encoder) {
   if (encoder == hexadecimal_encoder) {
@@ -629,6 +640,20 @@ int __cdecl principia__GetBufferedLogging() {
   return m.Return(FLAGS_logbuflevel);
 }
 
+void __cdecl principia__GetMethodStatistics(bool const reset,
+                                            char const** const statistics) {
+  journal::Method<journal::GetMethodStatistics> m({reset}, {statistics});
+  // Ownership will be transfered to the marshmallow.
+  std::string const dump = MethodStatistics::Dump();
+  UniqueArray<char> allocated_statistics(dump.size() + 1);
+  std::memcpy(allocated_statistics.data.get(), dump.data(), dump.size() + 1);
+  *CHECK_NOTNULL(statistics) = allocated_statistics.data.release();
+  if (reset) {
+    MethodStatistics::Reset();
+  }
+  return m.Return();
+}
+
 int __cdecl principia__GetStderrLogging() {
   journal::Method<journal::GetStderrLogging> m;
   return m.Return(FLAGS_stderrthreshold);
@@ -1098,9 +1123,21 @@ char const* __cdecl principia__SerializePlugin(
   // Create and start a serializer if the caller didn't provide one.
   if (*serializer == nullptr) {
     LOG(INFO) << "Begin plugin serialization";
-    *serializer = new PullSerializer(chunk_size,
-                                     number_of_chunks,
-                                     NewCompressor(compressor));
+    std::string const compressor_name = compressor;
+    if (compressor_name.empty()) {
+      *serializer = new PullSerializer(chunk_size,
+                                       number_of_chunks,
+                                       /*compressor=*/nullptr);
+    } else {
+      // The chunks are compressed in parallel, while the serialization
+      // proceeds.  The result is readable by a |PushDeserializer| with a single
+      // compressor.
+      *serializer = new PullSerializer(
+          chunk_size,
+          number_of_chunks,
+          [compressor_name]() { return NewCompressor(compressor_name); },
+          CompressionThreadPool());
+    }
     not_null<serialization::Plugin*> const message =
         Arena::CreateMessage<serialization::Plugin>(arena);
     plugin->WriteToMessage(message);
@@ -1,7 +1,7 @@
 #include "ksp_plugin/interface.hpp"
 
-#include <limits>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -10,7 +10,6 @@
 #include "journal/method.hpp"
 #include "journal/profiles.hpp"
 #include "ksp_plugin/frames.hpp"
-#include "physics/apsides.hpp"
 #include "physics/discrete_trajectory.hpp"
 
 namespace principia {
@@ -22,7 +21,6 @@ using namespace principia::geometry::_r3_element;
 using namespace principia::ksp_plugin::_flight_plan;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_vessel;
-using namespace principia::physics::_apsides;
 using namespace principia::physics::_body_centred_non_rotating_reference_frame;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_oblate_body;
@@ -35,6 +33,84 @@ Status* OK() {
   return ok;
 }
 
+// Returns the motion from |body_centred_inertial| to the world coordinates
+// centred on its body.
+// NOTE(egg): it is correct to use the orthogonal map at the current time,
+// because |body_centred_inertial| does not rotate with respect to
+// |Barycentric|, so the orthogonal map does not depend on time.
+RigidMotion<Navigation, World> ToWorldBodyCentredInertial(
+    Plugin const& plugin,
+    NavigationFrame const& body_centred_inertial) {
+  return RigidMotion<Navigation, World>(
+      RigidTransformation<Navigation, World>(
+          Navigation::origin,
+          World::origin,
+          plugin.renderer().BarycentricToWorld(plugin.PlanetariumRotation()) *
+              body_centred_inertial.FromThisFrameAtTime(
+                  plugin.CurrentTime()).orthogonal_map()),
+      Navigation::nonrotating,
+      Navigation::unmoving);
+}
+
+absl::Status CheckFlowFreefallArguments(Plugin const* const plugin,
+                                        int const central_body_index,
+                                        double const t_initial,
+                                        double const t_final) {
+  if (plugin == nullptr) {
+    return absl::InvalidArgumentError("|plugin| must not be null");
+  }
+  if (!plugin->HasCelestial(central_body_index)) {
+    return absl::NotFoundError(
+        absl::StrCat("No celestial with index ", central_body_index));
+  }
+  if (!(t_initial <= t_final)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("|t_final| ", t_final, " is before |t_initial| ",
+                     t_initial));
+  }
+  return absl::OkStatus();
+}
+
+// Integrates the free fall of the bodies with the given world body-centred
+// initial degrees of freedom and returns their world body-centred final degrees
+// of freedom.  The arguments must have been checked.
+std::vector<absl::StatusOr<QP>> FlowFreefall(
+    Plugin const& plugin,
+    int const central_body_index,
+    std::vector<QP> const& world_body_centred_initial_degrees_of_freedom,
+    double const t_initial,
+    double const t_final) {
+  auto const body_centred_inertial =
+      plugin.NewBodyCentredNonRotatingNavigationFrame(central_body_index);
+  auto const to_world_body_centred_inertial =
+      ToWorldBodyCentredInertial(plugin, *body_centred_inertial);
+  auto const from_world_body_centred_inertial =
+      to_world_body_centred_inertial.Inverse();
+
+  std::vector<DegreesOfFreedom<Navigation>> initial_degrees_of_freedom;
+  for (QP const& qp : world_body_centred_initial_degrees_of_freedom) {
+    initial_degrees_of_freedom.push_back(from_world_body_centred_inertial(
+        FromQP<DegreesOfFreedom<World>>(qp)));
+  }
+  auto const final_degrees_of_freedom =
+      plugin.FlowFreefall(central_body_index,
+                          initial_degrees_of_freedom,
+                          FromGameTime(plugin, t_initial),
+                          FromGameTime(plugin, t_final));
+
+  std::vector<absl::StatusOr<QP>> world_body_centred_final_degrees_of_freedom;
+  for (auto const& degrees_of_freedom : final_degrees_of_freedom) {
+    if (degrees_of_freedom.ok()) {
+      world_body_centred_final_degrees_of_freedom.push_back(
+          ToQP(to_world_body_centred_inertial(*degrees_of_freedom)));
+    } else {
+      world_body_centred_final_degrees_of_freedom.push_back(
+          degrees_of_freedom.status());
+    }
+  }
+  return world_body_centred_final_degrees_of_freedom;
+}
+
 }  // namespace
 
 Status* __cdecl principia__ExternalCelestialGetPosition(
@@ -142,12 +218,77 @@ Status* __cdecl principia__ExternalFlowFreefall(
        t_initial,
        t_final},
       {world_body_centred_final_degrees_of_freedom}};
-  if (plugin == nullptr) {
-    return m.Return(
-        ToNewStatus(absl::InvalidArgumentError("|plugin| must not be null")));
+  if (auto const status = CheckFlowFreefallArguments(
+          plugin, central_body_index, t_initial, t_final);
+      !status.ok()) {
+    return m.Return(ToNewStatus(status));
   }
-  return m.Return(ToNewStatus(absl::UnimplementedError(
-      "|ExternalFlowFreefall| is not yet implemented")));
+  auto const final_degrees_of_freedom =
+      FlowFreefall(*plugin,
+                   central_body_index,
+                   {world_body_centred_initial_degrees_of_freedom},
+                   t_initial,
+                   t_final);
+  auto const& world_body_centred_final = final_degrees_of_freedom.front();
+  if (!world_body_centred_final.ok()) {
+    return m.Return(ToNewStatus(world_body_centred_final.status()));
+  }
+  *world_body_centred_final_degrees_of_freedom = *world_body_centred_final;
+  return m.Return(OK());
+}
+
+Status* __cdecl principia__ExternalFlowFreefallBatch(
+    Plugin const* const plugin,
+    int const central_body_index,
+    QP* const world_body_centred_initial_degrees_of_freedom,
+    int const initial_size,
+    double const t_initial,
+    double const t_final,
+    QP* const world_body_centred_final_degrees_of_freedom,
+    int const final_size,
+    int* const errors,
+    int const errors_size) {
+  journal::Method<journal::ExternalFlowFreefallBatch> m{
+      {plugin,
+       central_body_index,
+       world_body_centred_initial_degrees_of_freedom,
+       initial_size,
+       t_initial,
+       t_final,
+       world_body_centred_final_degrees_of_freedom,
+       final_size,
+       errors,
+       errors_size}};
+  if (auto const status = CheckFlowFreefallArguments(
+          plugin, central_body_index, t_initial, t_final);
+      !status.ok()) {
+    return m.Return(ToNewStatus(status));
+  }
+  if (initial_size < 0 ||
+      final_size != initial_size ||
+      errors_size != initial_size) {
+    return m.Return(ToNewStatus(absl::InvalidArgumentError(absl::StrCat(
+        "Inconsistent sizes: |initial_size| = ", initial_size,
+        ", |final_size| = ", final_size,
+        ", |errors_size| = ", errors_size))));
+  }
+  auto const final_degrees_of_freedom = FlowFreefall(
+      *plugin,
+      central_body_index,
+      std::vector<QP>(world_body_centred_initial_degrees_of_freedom,
+                      world_body_centred_initial_degrees_of_freedom +
+                          initial_size),
+      t_initial,
+      t_final);
+  for (int i = 0; i < initial_size; ++i) {
+    auto const& world_body_centred_final = final_degrees_of_freedom[i];
+    errors[i] = static_cast<int>(world_body_centred_final.status().code());
+    if (world_body_centred_final.ok()) {
+      world_body_centred_final_degrees_of_freedom[i] =
+          *world_body_centred_final;
+    }
+  }
+  return m.Return(OK());
 }
 
 Status* __cdecl principia__ExternalGeopotentialGetCoefficient(
@@ -281,68 +422,28 @@ Status* __cdecl principia__ExternalGetNearestPlannedCoastDegreesOfFreedom(
   }
   auto const body_centred_inertial =
       plugin->NewBodyCentredNonRotatingNavigationFrame(central_body_index);
-  DiscreteTrajectory<Navigation> coast;
-  for (auto const& [time, degrees_of_freedom] :
-       *flight_plan.GetSegment(segment_index)) {
-    coast.Append(
-        time,
-        body_centred_inertial->ToThisFrameAtTime(time)(degrees_of_freedom))
-        .IgnoreError();
-  }
+  // The coast is transformed to |body_centred_inertial| only if it is not
+  // already cached, which is the case as long as the flight plan is unchanged.
+  auto const coast = plugin->planned_coast_cache().GetOrTransform(
+      {.flight_plan_version = flight_plan.version(),
+       .segment_index = segment_index,
+       .central_body_index = central_body_index},
+      flight_plan.GetSegment(segment_index),
+      *body_centred_inertial);
 
-  Instant const current_time = plugin->CurrentTime();
   // The given |World| position and requested |World| degrees of freedom are
   // body-centred inertial, so |body_centred_inertial| up to an orthogonal map
   // to world coordinates.  Do the conversion directly.
-  // NOTE(egg): it is correct to use the orthogonal map at |current_time|,
-  // because |body_centred_inertial| does not rotate with respect to
-  // |Barycentric|, so the orthogonal map does not depend on time.
-  RigidMotion<Navigation, World> to_world_body_centred_inertial(
-      RigidTransformation<Navigation, World>(
-          Navigation::origin,
-          World::origin,
-          plugin->renderer().BarycentricToWorld(plugin->PlanetariumRotation()) *
-              body_centred_inertial->FromThisFrameAtTime(
-                  current_time).orthogonal_map()),
-      Navigation::nonrotating,
-      Navigation::unmoving);
+  auto const to_world_body_centred_inertial =
+      ToWorldBodyCentredInertial(*plugin, *body_centred_inertial);
   auto const from_world_body_centred_inertial =
       to_world_body_centred_inertial.Inverse();
   Position<Navigation> reference_position =
       from_world_body_centred_inertial.rigid_transformation()(
           FromXYZ<Position<World>>(world_body_centred_reference_position));
-  DiscreteTrajectory<Navigation> immobile_reference;
-  immobile_reference.Append(
-      coast.front().time,
-      {reference_position, Navigation::unmoving}).IgnoreError();
-  if (coast.size() > 1) {
-    immobile_reference.Append(
-        coast.back().time,
-        {reference_position, Navigation::unmoving}).IgnoreError();
-  }
-  DiscreteTrajectory<Navigation> apoapsides;
-  DiscreteTrajectory<Navigation> periapsides;
-  ComputeApsides(/*reference=*/immobile_reference,
-                 coast,
-                 coast.begin(), coast.end(),
-                 /*max_points=*/std::numeric_limits<int>::max(),
-                 apoapsides,
-                 periapsides);
-  if (periapsides.empty()) {
-    bool const begin_is_nearest =
-        (coast.front().degrees_of_freedom.position() -
-         reference_position).Norm²() <
-        (coast.back().degrees_of_freedom.position() -
-         reference_position).Norm²();
-    *world_body_centred_nearest_degrees_of_freedom =
-        ToQP(to_world_body_centred_inertial(
-            begin_is_nearest ? coast.front().degrees_of_freedom
-                             : coast.back().degrees_of_freedom));
-  } else {
-    *world_body_centred_nearest_degrees_of_freedom =
-        ToQP(to_world_body_centred_inertial(
-            periapsides.front().degrees_of_freedom));
-  }
+  *world_body_centred_nearest_degrees_of_freedom =
+      ToQP(to_world_body_centred_inertial(
+          coast->NearestDegreesOfFreedom(reference_position)));
   return m.Return(OK());
 }
 
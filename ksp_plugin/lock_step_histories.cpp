@@ -0,0 +1,137 @@
+#include "ksp_plugin/lock_step_histories.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "ksp_plugin/pile_up.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _lock_step_histories {
+namespace internal {
+
+LockStepHistories::LockStepHistories(
+    not_null<Ephemeris<Barycentric>*> const ephemeris,
+    Ephemeris<Barycentric>::FixedStepParameters fixed_step_parameters)
+    : ephemeris_(ephemeris),
+      fixed_step_parameters_(std::move(fixed_step_parameters)) {}
+
+bool LockStepHistories::Add(
+    not_null<PileUp const*> const pile_up,
+    Instant const& time,
+    DegreesOfFreedom<Barycentric> const& degrees_of_freedom,
+    Ephemeris<Barycentric>::FixedStepParameters const& fixed_step_parameters,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const&
+        adaptive_step_parameters) {
+  if (&fixed_step_parameters.integrator() !=
+          &fixed_step_parameters_.integrator() ||
+      fixed_step_parameters.step() != fixed_step_parameters_.step()) {
+    return false;
+  }
+
+  absl::MutexLock l(&lock_);
+  CHECK(!histories_.contains(pile_up)) << pile_up;
+  DiscreteTrajectory<Barycentric> history;
+  CHECK_OK(history.Append(time, degrees_of_freedom));
+  if (!histories_.empty()) {
+    Instant const& group_time = histories_.begin()->second.back().time;
+    if (group_time < time) {
+      return false;
+    } else if (time < group_time) {
+      // The intermediate points are not part of the history, only the one at
+      // |group_time| is.
+      if (!ephemeris_
+               ->FlowWithAdaptiveStep(
+                   &history,
+                   Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+                   group_time,
+                   adaptive_step_parameters,
+                   Ephemeris<Barycentric>::unlimited_max_ephemeris_steps)
+               .ok() ||
+          history.back().time != group_time) {
+        return false;
+      }
+      history.ForgetBefore(group_time);
+    }
+  }
+  histories_.emplace(pile_up, std::move(history));
+  instance_ = nullptr;
+  return true;
+}
+
+void LockStepHistories::Remove(not_null<PileUp const*> const pile_up) {
+  absl::MutexLock l(&lock_);
+  if (histories_.erase(pile_up) > 0) {
+    instance_ = nullptr;
+  }
+}
+
+bool LockStepHistories::Contains(not_null<PileUp const*> const pile_up) const {
+  absl::ReaderMutexLock l(&lock_);
+  return histories_.contains(pile_up);
+}
+
+bool LockStepHistories::FlowHistory(not_null<PileUp const*> const pile_up,
+                                    Instant const& t,
+                                    DiscreteTrajectory<Barycentric>& history) {
+  // The first pile-up to get here integrates the group while the others wait,
+  // since they need the result anyway.
+  {
+    absl::MutexLock l(&lock_);
+    if (!histories_.contains(pile_up)) {
+      return false;
+    }
+    CHECK(!last_flow_time_.has_value() || *last_flow_time_ <= t)
+        << "Flowing to " << t << " after flowing to " << *last_flow_time_;
+
+    if (!last_flow_time_.has_value() || *last_flow_time_ < t) {
+      if (instance_ == nullptr) {
+        std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories;
+        trajectories.reserve(histories_.size());
+        for (auto& [_, trajectory] : histories_) {
+          trajectories.push_back(&trajectory);
+        }
+        instance_ = ephemeris_->NewInstance(
+            trajectories,
+            Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+            fixed_step_parameters_);
+      }
+      if (absl::Status const status =
+              ephemeris_->FlowWithFixedStep(t, *instance_);
+          !status.ok()) {
+        LOG(WARNING) << "Dissolving the lock-step histories of "
+                     << histories_.size() << " pile-ups: " << status;
+        histories_.clear();
+        instance_ = nullptr;
+        last_flow_time_.reset();
+        return false;
+      }
+      last_flow_time_ = t;
+    }
+  }
+
+  // Copy the new points to the history of the pile-up and drop them from the
+  // group.  This only touches the history of |pile_up| in the group, so the
+  // pile-ups of the group do it concurrently.
+  absl::ReaderMutexLock l(&lock_);
+  auto const it = histories_.find(pile_up);
+  if (it == histories_.end()) {
+    // The group was dissolved by another pile-up in the meantime.
+    return false;
+  }
+  DiscreteTrajectory<Barycentric>& group_history = it->second;
+  Instant const history_last = history.back().time;
+  for (auto point = group_history.upper_bound(history_last);
+       point != group_history.end() && point->time <= t;
+       ++point) {
+    CHECK_OK(history.Append(point->time, point->degrees_of_freedom));
+  }
+  group_history.ForgetBefore(history.back().time);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace _lock_step_histories
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+
+#include "absl/synchronization/mutex.h"
+#include "base/macros.hpp"
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "integrators/integrators.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/ephemeris.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+
+FORWARD_DECLARE_FROM(pile_up, class, PileUp);
+
+namespace _lock_step_histories {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::integrators::_integrators;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_pile_up;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_ephemeris;
+
+// The histories of the pile-ups that have no intrinsic acceleration, integrated
+// as a single system with one fixed-step instance.  The ephemeris is evaluated
+// once per stage for all the pile-ups, instead of once per stage for each of
+// them.  The instance is re-created when pile-ups join or leave the group.
+// This class is thread-safe.
+class LockStepHistories {
+ public:
+  LockStepHistories(
+      not_null<Ephemeris<Barycentric>*> ephemeris,
+      Ephemeris<Barycentric>::FixedStepParameters fixed_step_parameters);
+
+  // Adds |pile_up| to the group with the last point of its history, given by
+  // |time| and |degrees_of_freedom|.  If the group is ahead of |time|, the
+  // pile-up is first brought to the time of the group using
+  // |adaptive_step_parameters|.  Returns false and leaves the group unchanged
+  // if the group is behind |time|, if |fixed_step_parameters| are not those of
+  // the group, or if the pile-up cannot be brought to the time of the group; in
+  // that case the pile-up must integrate its history on its own, and may try
+  // again later.  |pile_up| must not be in the group.
+  bool Add(not_null<PileUp const*> pile_up,
+           Instant const& time,
+           DegreesOfFreedom<Barycentric> const& degrees_of_freedom,
+           Ephemeris<Barycentric>::FixedStepParameters const&
+               fixed_step_parameters,
+           Ephemeris<Barycentric>::AdaptiveStepParameters const&
+               adaptive_step_parameters);
+
+  // Removes |pile_up| from the group, if it is there.  The points of its
+  // history that were not yet appended by |FlowHistory| are lost.
+  void Remove(not_null<PileUp const*> pile_up);
+
+  bool Contains(not_null<PileUp const*> pile_up) const;
+
+  // Integrates the histories of all the pile-ups in the group as far as
+  // possible up to |t|, unless another pile-up already did, and appends to
+  // |history| the points of the history of |pile_up| that are after its last
+  // point.  If the integration fails, e.g., because some pile-up collided with
+  // a celestial, the group is dissolved and false is returned: all the
+  // pile-ups must integrate their history on their own, and find out which of
+  // them collided.  |t| must not be before the |t| of any previous call, as
+  // the group cannot go back in time.  The integration is exclusive, but the
+  // pile-ups of the group append their points concurrently.
+  bool FlowHistory(not_null<PileUp const*> pile_up,
+                   Instant const& t,
+                   DiscreteTrajectory<Barycentric>& history);
+
+ private:
+  not_null<Ephemeris<Barycentric>*> const ephemeris_;
+  Ephemeris<Barycentric>::FixedStepParameters const fixed_step_parameters_;
+
+  mutable absl::Mutex lock_;
+
+  // The histories of the pile-ups of the group, which all end at the same
+  // time.  The points that have been appended to the histories of the
+  // pile-ups are dropped, except for the last one.  The nodes of the map are
+  // stable, which makes it possible for the |instance_| to point into them.
+  // A shared lock is sufficient for a pile-up to drop the points of its own
+  // history.
+  std::map<not_null<PileUp const*>, DiscreteTrajectory<Barycentric>> histories_
+      GUARDED_BY(lock_);
+
+  // Null if the group is empty or if it changed since the last integration.
+  std::unique_ptr<Integrator<Ephemeris<Barycentric>::NewtonianMotionEquation>::
+                      Instance> instance_ GUARDED_BY(lock_);
+
+  // The last time passed to |FlowHistory|.
+  std::optional<Instant> last_flow_time_ GUARDED_BY(lock_);
+};
+
+}  // namespace internal
+
+using internal::LockStepHistories;
+
+}  // namespace _lock_step_histories
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -107,26 +107,32 @@ double OrbitAnalyser::progress_of_next_analysis() const {
 absl::Status OrbitAnalyser::AnalyseOrbit(Parameters const& parameters) {
   Analysis analysis{parameters.first_time};
 
-  RotatingBody<Barycentric> const* primary = nullptr;
-  auto smallest_osculating_period = Infinity<Time>;
-  auto const primary_status =
-      FindBodyWithSmallestOsculatingPeriod(parameters,
-                                           primary,
-                                           smallest_osculating_period);
-  RETURN_IF_ERROR(primary_status);
+  if (integration_ == nullptr || !integration_->StartsFrom(parameters)) {
+    integration_.reset();
+    RotatingBody<Barycentric> const* primary = nullptr;
+    auto smallest_osculating_period = Infinity<Time>;
+    auto const primary_status =
+        FindBodyWithSmallestOsculatingPeriod(parameters,
+                                             primary,
+                                             smallest_osculating_period);
+    RETURN_IF_ERROR(primary_status);
+    integration_ = std::make_unique<Integration>(
+        parameters, primary, smallest_osculating_period);
+  }
+  Integration& integration = *integration_;
+  RotatingBody<Barycentric> const* const primary = integration.primary;
 
   if (primary != nullptr) {
-    DiscreteTrajectory<Barycentric> trajectory;
-    trajectory.segments().front().SetDownsampling(
-        OrbitAnalyserDownsamplingParameters());
-
     Time const analysis_duration = std::min(
         parameters.extended_mission_duration.value_or(
             parameters.mission_duration),
-        std::max(2 * smallest_osculating_period, parameters.mission_duration));
-    RETURN_IF_ERROR(
-        FlowWithProgressBar(parameters, analysis_duration, trajectory));
-    analysis.mission_duration_ = trajectory.back().time - parameters.first_time;
+        std::max(2 * integration.smallest_osculating_period,
+                 parameters.mission_duration));
+    RETURN_IF_ERROR(FlowWithProgressBar(analysis_duration, integration));
+    Instant const last_time = std::min(
+        integration.trajectory.back().time,
+        parameters.first_time + analysis_duration);
+    analysis.mission_duration_ = last_time - parameters.first_time;
 
     // TODO(egg): |next_analysis_percentage_| only reflects the progress of
     // the integration, but the analysis itself can take a while; this results
@@ -135,11 +141,25 @@ absl::Status OrbitAnalyser::AnalyseOrbit(Parameters const& parameters) {
 
     BodyCentredNonRotatingReferenceFrame<Barycentric, PrimaryCentred> const
         primary_centred(ephemeris_, primary);
-    auto const status_or_primary_centred_trajectory =
-        ToPrimaryCentred(primary_centred, trajectory);
-    RETURN_IF_ERROR(status_or_primary_centred_trajectory);
+    RETURN_IF_ERROR(ExtendPrimaryCentred(primary_centred, integration));
+
+    // If a previous request went further than this one, only analyse the
+    // points up to the end of this request.
+    std::optional<DiscreteTrajectory<PrimaryCentred>> truncated_trajectory;
+    if (integration.primary_centred_trajectory.back().time > last_time) {
+      truncated_trajectory.emplace();
+      for (auto const& [time, degrees_of_freedom] :
+           integration.primary_centred_trajectory) {
+        if (time > last_time) {
+          break;
+        }
+        truncated_trajectory->Append(time, degrees_of_freedom).IgnoreError();
+      }
+    }
     auto const& primary_centred_trajectory =
-        status_or_primary_centred_trajectory.value();
+        truncated_trajectory.has_value()
+            ? *truncated_trajectory
+            : integration.primary_centred_trajectory;
 
     analysis.primary_ = primary;
     analysis.radial_distance_interval_ =
@@ -163,15 +183,17 @@ absl::Status OrbitAnalyser::AnalyseOrbit(Parameters const& parameters) {
         analysis.closest_recurrence_.reset();
       }
 
-      std::optional<OrbitGroundTrack::MeanSun> mean_sun;
-      RETURN_IF_ERROR(ComputeMeanSunIfPossible(parameters,
-                                               primary_centred,
-                                               mean_sun));
+      if (!integration.mean_sun_computed) {
+        RETURN_IF_ERROR(ComputeMeanSunIfPossible(parameters,
+                                                 primary_centred,
+                                                 integration.mean_sun));
+        integration.mean_sun_computed = true;
+      }
 
       auto ground_track =
           OrbitGroundTrack::ForTrajectory(primary_centred_trajectory,
                                           *primary,
-                                          mean_sun);
+                                          integration.mean_sun);
       RETURN_IF_ERROR(ground_track);
       analysis.ground_track_ = std::move(ground_track).value();
       analysis.ResetRecurrence();
@@ -212,30 +234,37 @@ absl::Status OrbitAnalyser::FindBodyWithSmallestOsculatingPeriod(
 }
 
 absl::Status OrbitAnalyser::FlowWithProgressBar(
-    Parameters const& parameters,
     Time const& analysis_duration,
-    DiscreteTrajectory<Barycentric>& trajectory) {
-  trajectory.Append(parameters.first_time,
-                    parameters.first_degrees_of_freedom).IgnoreError();
-
-  std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories = {
-      &trajectory};
-  auto instance = ephemeris_->StoppableNewInstance(
-      trajectories,
-      Ephemeris<Barycentric>::NoIntrinsicAccelerations,
-      analysed_trajectory_parameters_);
-  RETURN_IF_STOPPED;
+    Integration& integration) {
+  auto& trajectory = integration.trajectory;
+  if (integration.instance == nullptr) {
+    if (trajectory.empty()) {
+      trajectory.Append(integration.first_time,
+                        integration.first_degrees_of_freedom).IgnoreError();
+    }
+    std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories = {
+        &trajectory};
+    auto instance = ephemeris_->StoppableNewInstance(
+        trajectories,
+        Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+        analysed_trajectory_parameters_);
+    RETURN_IF_STOPPED;
+    integration.instance = std::move(instance).value();
+  }
 
   constexpr double progress_bar_steps = 0x1p10;
   for (double n = 0; n <= progress_bar_steps; ++n) {
     Instant const t =
-        parameters.first_time + n / progress_bar_steps * analysis_duration;
-    if (!ephemeris_->FlowWithFixedStep(t, *instance.value()).ok()) {
+        integration.first_time + n / progress_bar_steps * analysis_duration;
+    // The part of the trajectory computed by a previous analysis is skipped.
+    if (t > trajectory.back().time &&
+        !ephemeris_->FlowWithFixedStep(t, *integration.instance).ok()) {
       // TODO(egg): Report that the integration failed.
       break;
     }
-    progress_of_next_analysis_ =
-        (trajectory.back().time - parameters.first_time) / analysis_duration;
+    progress_of_next_analysis_ = std::min(
+        1.0,
+        (trajectory.back().time - integration.first_time) / analysis_duration);
     RETURN_IF_STOPPED;
   }
   return absl::OkStatus();
@@ -293,20 +322,53 @@ OrbitAnalyser::ComputeMeanSunIfPossible(
   return absl::OkStatus();
 }
 
-absl::StatusOr<DiscreteTrajectory<OrbitAnalyser::PrimaryCentred>>
-OrbitAnalyser::ToPrimaryCentred(
+absl::Status OrbitAnalyser::ExtendPrimaryCentred(
     BodyCentredNonRotatingReferenceFrame<Barycentric, PrimaryCentred> const&
         primary_centred,
-    DiscreteTrajectory<Barycentric> const& trajectory) {
-  DiscreteTrajectory<PrimaryCentred> primary_centred_trajectory;
-  for (auto const& [time, degrees_of_freedom] : trajectory) {
+    Integration& integration) {
+  auto& primary_centred_trajectory = integration.primary_centred_trajectory;
+  auto const& trajectory = integration.trajectory;
+
+  // The downsampling of |trajectory| may have removed points that were
+  // converted by a previous analysis.  Keep the converted points up to the
+  // first one that is no longer in |trajectory|, and convert the rest again.
+  auto it = trajectory.begin();
+  auto primary_centred_it = primary_centred_trajectory.begin();
+  while (it != trajectory.end() &&
+         primary_centred_it != primary_centred_trajectory.end() &&
+         it->time == primary_centred_it->time) {
+    ++it;
+    ++primary_centred_it;
+  }
+  primary_centred_trajectory.ForgetAfter(primary_centred_it);
+
+  for (; it != trajectory.end(); ++it) {
     RETURN_IF_STOPPED;
+    auto const& [time, degrees_of_freedom] = *it;
     primary_centred_trajectory
         .Append(time,
                 primary_centred.ToThisFrameAtTime(time)(degrees_of_freedom))
         .IgnoreError();
   }
-  return primary_centred_trajectory;
+  return absl::OkStatus();
+}
+
+OrbitAnalyser::Integration::Integration(
+    Parameters const& parameters,
+    RotatingBody<Barycentric> const* const primary,
+    Time const& smallest_osculating_period)
+    : first_time(parameters.first_time),
+      first_degrees_of_freedom(parameters.first_degrees_of_freedom),
+      primary(primary),
+      smallest_osculating_period(smallest_osculating_period) {
+  trajectory.segments().front().SetDownsampling(
+      OrbitAnalyserDownsamplingParameters());
+}
+
+bool OrbitAnalyser::Integration::StartsFrom(
+    Parameters const& parameters) const {
+  return first_time == parameters.first_time &&
+         first_degrees_of_freedom == parameters.first_degrees_of_freedom;
 }
 
 Instant const& OrbitAnalyser::Analysis::first_time() const {
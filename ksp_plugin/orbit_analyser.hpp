@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <optional>
 #include <thread>
 
@@ -13,6 +14,7 @@
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/interval.hpp"
+#include "integrators/integrators.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "physics/body_centred_non_rotating_reference_frame.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -34,6 +36,7 @@ using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_interval;
+using namespace principia::integrators::_integrators;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::physics::_body_centred_non_rotating_reference_frame;
 using namespace principia::physics::_degrees_of_freedom;
@@ -44,7 +47,9 @@ using namespace principia::quantities::_quantities;
 
 // The |OrbitAnalyser| asynchronously integrates a trajectory, and computes
 // orbital elements, recurrence, and ground track properties of the resulting
-// orbit.
+// orbit.  The integrated trajectory is retained between analyses: a request
+// with the same initial state only integrates the part of the trajectory that
+// was not computed yet.
 class OrbitAnalyser {
  public:
   // The analysis stores the computed orbital characteristics.  It is publicly
@@ -136,6 +141,37 @@ class OrbitAnalyser {
  private:
   using PrimaryCentred = Frame<struct PrimaryCentredTag, NonRotating>;
 
+  // The state of the integration for a given initial state, reused by
+  // subsequent analyses with that initial state.
+  struct Integration {
+    Integration(Parameters const& parameters,
+                RotatingBody<Barycentric> const* primary,
+                Time const& smallest_osculating_period);
+
+    // Whether this integration starts from the initial state of |parameters|.
+    bool StartsFrom(Parameters const& parameters) const;
+
+    Instant const first_time;
+    DegreesOfFreedom<Barycentric> const first_degrees_of_freedom;
+    RotatingBody<Barycentric> const* const primary;
+    Time const smallest_osculating_period;
+
+    DiscreteTrajectory<Barycentric> trajectory;
+    // Null until the first call to |FlowWithProgressBar|.
+    std::unique_ptr<
+        Integrator<Ephemeris<Barycentric>::NewtonianMotionEquation>::Instance>
+        instance;
+
+    // The prefix of |trajectory| that has been converted to the frame centred
+    // on |primary|.
+    DiscreteTrajectory<PrimaryCentred> primary_centred_trajectory;
+
+    // Set once |mean_sun| has been computed, since it only depends on the
+    // initial state.
+    bool mean_sun_computed = false;
+    std::optional<OrbitGroundTrack::MeanSun> mean_sun;
+  };
+
   // Finds the primary body and analyze our orbit around it.
   absl::Status AnalyseOrbit(Parameters const& parameters);
 
@@ -146,14 +182,13 @@ class OrbitAnalyser {
       RotatingBody<Barycentric> const*& primary,
       Time& smallest_osculating_period);
 
-  // Flows the |trajectory| with a fixed step integrator using the given
-  // |parameters|.  This is done in small increments and
+  // Flows the trajectory of the |integration| with a fixed step integrator
+  // until |analysis_duration| after its first time, continuing any previous
+  // integration.  This is done in small increments and
   // |progress_of_next_analysis_| is updated after each increment to be able to
   // display a progress bar.  This function may be stopped.
-  absl::Status FlowWithProgressBar(
-      Parameters const& parameters,
-      Time const& analysis_duration,
-      DiscreteTrajectory<Barycentric>& trajectory);
+  absl::Status FlowWithProgressBar(Time const& analysis_duration,
+                                   Integration& integration);
 
   // If we can find a sun, computes its mean motion around the primary if it
   // doesn't require too long an integration.  If there is no sun, or the
@@ -164,12 +199,13 @@ class OrbitAnalyser {
           primary_centred,
       std::optional<OrbitGroundTrack::MeanSun>& mean_sun);
 
-  // Converts the |trajectory| to the given |primary_centred| frame.  This
-  // function may be stopped.
-  static absl::StatusOr<DiscreteTrajectory<PrimaryCentred>> ToPrimaryCentred(
+  // Converts to the given |primary_centred| frame the points of the trajectory
+  // of the |integration| that have not been converted yet.  This function may
+  // be stopped.
+  static absl::Status ExtendPrimaryCentred(
       BodyCentredNonRotatingReferenceFrame<Barycentric, PrimaryCentred> const&
           primary_centred,
-      DiscreteTrajectory<Barycentric> const& trajectory);
+      Integration& integration);
 
   not_null<Ephemeris<Barycentric>*> const ephemeris_;
   Ephemeris<Barycentric>::FixedStepParameters const
@@ -179,6 +215,10 @@ class OrbitAnalyser {
 
   std::optional<Analysis> analysis_;
 
+  // Only accessed by the |analyser_| thread; successive threads are serialized
+  // since a new one is only started once the previous one is idle.
+  std::unique_ptr<Integration> integration_;
+
   mutable absl::Mutex lock_;
   jthread analyser_;
   // The |analyser_| is idle:
@@ -1,20 +1,27 @@
 #include "ksp_plugin/pile_up.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "base/flags.hpp"
 #include "base/map_util.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/identity.hpp"
 #include "geometry/space.hpp"
 #include "ksp_plugin/integrators.hpp"
 #include "ksp_plugin/part.hpp"
 #include "numerics/davenport_q_method.hpp"
+#include "physics/kepler_orbit.hpp"
+#include "physics/massive_body.hpp"
 #include "quantities/parser.hpp"
 
 namespace principia {
@@ -25,8 +32,10 @@ namespace internal {
 using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
+using namespace principia::base::_flags;
 using namespace principia::base::_map_util;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
@@ -41,6 +50,8 @@ using namespace principia::geometry::_space;
 using namespace principia::ksp_plugin::_integrators;
 using namespace principia::numerics::_davenport_q_method;
 using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_kepler_orbit;
+using namespace principia::physics::_massive_body;
 using namespace principia::physics::_rigid_motion;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
@@ -52,6 +63,21 @@ const auto part_x = Vector<double, RigidPart>({1, 0, 0});
 const auto part_y = Vector<double, RigidPart>({0, 1, 0});
 const auto part_z = Vector<double, RigidPart>({0, 0, 1});
 
+constexpr std::size_t parts_per_chunk = 64;
+
+// If this flag is present, pile-ups in inertial motion are propagated along
+// their osculating Keplerian orbit when the perturbations are negligible.
+constexpr std::string_view kepler_coast_flag = "kepler_coast";
+
+// The pool on which the parts of large pile-ups are processed.  It must be
+// distinct from the pool on which the pile-ups are advanced, since the tasks of
+// that pool wait for the tasks of this one.
+ThreadPool<void>& PartsThreadPool() {
+  static auto* const thread_pool = new ThreadPool<void>(
+      /*pool_size=*/HardwareConcurrency());
+  return *thread_pool;
+}
+
 PileUp::PileUp(
     std::list<not_null<Part*>> parts,
     Instant const& t,
@@ -61,6 +87,7 @@ PileUp::PileUp(
     std::function<void()> deletion_callback)
     : lock_(make_not_null_unique<absl::Mutex>()),
       parts_(std::move(parts)),
+      flat_parts_(parts_.begin(), parts_.end()),
       ephemeris_(ephemeris),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
       fixed_step_parameters_(std::move(fixed_step_parameters)),
@@ -92,6 +119,7 @@ PileUp::PileUp(
 
 PileUp::~PileUp() {
   LOG(INFO) << "Destroying pile up at " << this;
+  LeaveLockStepHistories();
   if (deletion_callback_ != nullptr) {
     deletion_callback_();
   }
@@ -165,6 +193,15 @@ void PileUp::RecomputeFromParts() {
   }
 }
 
+void PileUp::SetLockStepHistories(
+    LockStepHistories* const lock_step_histories) {
+  absl::MutexLock l(lock_.get());
+  if (lock_step_histories != lock_step_histories_) {
+    LeaveLockStepHistories();
+    lock_step_histories_ = lock_step_histories;
+  }
+}
+
 void PileUp::WriteToMessage(not_null<serialization::PileUp*> message) const {
   for (not_null<Part*> const part : parts_) {
     message->add_part_id(part->part_id());
@@ -398,6 +435,7 @@ PileUp::PileUp(
     std::function<void()> deletion_callback)
     : lock_(make_not_null_unique<absl::Mutex>()),
       parts_(std::move(parts)),
+      flat_parts_(parts_.begin(), parts_.end()),
       ephemeris_(ephemeris),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
       fixed_step_parameters_(std::move(fixed_step_parameters)),
@@ -441,13 +479,20 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
         euler_solver_->MotionAt(
             t, {NonRotatingPileUp::origin, NonRotatingPileUp::unmoving});
 
-    for (auto& [part, actual_rigid_motion] : actual_part_rigid_motion_) {
-      actual_rigid_motion =
-          pile_up_motion * RigidMotion<RigidPart, PileUpPrincipalAxes>(
-                               rigid_pile_up_.at(part),
-                               PileUpPrincipalAxes::nonrotating,
-                               PileUpPrincipalAxes::unmoving);
-    }
+    // The structure of the maps doesn't change, so the chunks may update
+    // their values concurrently.
+    ProcessPartsInChunks(
+        [this, &pile_up_motion](std::size_t const begin,
+                                std::size_t const end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            not_null<Part*> const part = flat_parts_[i];
+            actual_part_rigid_motion_.at(part) =
+                pile_up_motion * RigidMotion<RigidPart, PileUpPrincipalAxes>(
+                                     rigid_pile_up_.at(part),
+                                     PileUpPrincipalAxes::nonrotating,
+                                     PileUpPrincipalAxes::unmoving);
+          }
+        });
     return;
   }
   // A consistency check that |SetPartApparentDegreesOfFreedom| was called for
@@ -486,26 +531,31 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
 
   // Compute the canonical axes of all the parts using their apparent and actual
   // motions.
-  std::vector<Vector<double, Apparent>> apparent_directions;
-  std::vector<Vector<double, NonRotatingPileUp>> actual_directions;
-  std::vector<Mass> masses;
-  apparent_directions.reserve(parts_.size());
-  actual_directions.reserve(parts_.size());
-  for (not_null<Part*> const part : parts_) {
-    auto const& apparent_part_orthogonal_map =
-        apparent_part_rigid_motion_.at(part).orthogonal_map();
-    auto const& actual_part_orthogonal_map =
-        actual_part_rigid_motion_.at(part).orthogonal_map();
-    apparent_directions.push_back(apparent_part_orthogonal_map(part_x));
-    apparent_directions.push_back(apparent_part_orthogonal_map(part_y));
-    apparent_directions.push_back(apparent_part_orthogonal_map(part_z));
-    actual_directions.push_back(actual_part_orthogonal_map(part_x));
-    actual_directions.push_back(actual_part_orthogonal_map(part_y));
-    actual_directions.push_back(actual_part_orthogonal_map(part_z));
-    for (int d = 1; d <= 3; ++d) {
-      masses.push_back(part->mass());
-    }
-  }
+  std::vector<Vector<double, Apparent>> apparent_directions(
+      3 * flat_parts_.size());
+  std::vector<Vector<double, NonRotatingPileUp>> actual_directions(
+      3 * flat_parts_.size());
+  std::vector<Mass> masses(3 * flat_parts_.size());
+  ProcessPartsInChunks(
+      [this, &apparent_directions, &actual_directions, &masses](
+          std::size_t const begin, std::size_t const end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          not_null<Part*> const part = flat_parts_[i];
+          auto const& apparent_part_orthogonal_map =
+              apparent_part_rigid_motion_.at(part).orthogonal_map();
+          auto const& actual_part_orthogonal_map =
+              actual_part_rigid_motion_.at(part).orthogonal_map();
+          apparent_directions[3 * i] = apparent_part_orthogonal_map(part_x);
+          apparent_directions[3 * i + 1] = apparent_part_orthogonal_map(part_y);
+          apparent_directions[3 * i + 2] = apparent_part_orthogonal_map(part_z);
+          actual_directions[3 * i] = actual_part_orthogonal_map(part_x);
+          actual_directions[3 * i + 1] = actual_part_orthogonal_map(part_y);
+          actual_directions[3 * i + 2] = actual_part_orthogonal_map(part_z);
+          for (int d = 0; d < 3; ++d) {
+            masses[3 * i + d] = part->mass();
+          }
+        }
+      });
 
   // Use Davenport's Q Method to figure out how the game rotated the pile-up
   // overall.  The parts are weighted by their masses, so if a tiny antenna
@@ -561,18 +611,35 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
 
   // Now update the motions of the parts in the pile-up frame, and keep their
   // orientations with respect to the principal axes in case we warp.
+  // The motions are computed in parallel and inserted in the maps afterwards.
+  std::vector<std::optional<RigidMotion<RigidPart, NonRotatingPileUp>>>
+      actual_rigid_motions(flat_parts_.size());
+  std::vector<
+      std::optional<RigidTransformation<RigidPart, PileUpPrincipalAxes>>>
+      rigid_transformations(flat_parts_.size());
+  auto const actual_pile_up_to_principal_axes =
+      actual_pile_up_motion.rigid_transformation().Inverse();
+  ProcessPartsInChunks(
+      [this,
+       &actual_pile_up_to_principal_axes,
+       &actual_rigid_motions,
+       &correction,
+       &rigid_transformations](std::size_t const begin,
+                               std::size_t const end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          auto const& actual_rigid_motion = actual_rigid_motions[i].emplace(
+              correction * apparent_part_rigid_motion_.at(flat_parts_[i]));
+          rigid_transformations[i].emplace(
+              actual_pile_up_to_principal_axes *
+              actual_rigid_motion.rigid_transformation());
+        }
+      });
+
   actual_part_rigid_motion_.clear();
   rigid_pile_up_.clear();
-  for (auto const& [part, apparent_part_rigid_motion] :
-       apparent_part_rigid_motion_) {
-    RigidMotion<RigidPart, NonRotatingPileUp> const actual_rigid_motion =
-        correction * apparent_part_rigid_motion;
-
-    actual_part_rigid_motion_.emplace(part, actual_rigid_motion);
-    rigid_pile_up_.emplace(
-        part,
-        actual_pile_up_motion.rigid_transformation().Inverse() *
-            actual_rigid_motion.rigid_transformation());
+  for (std::size_t i = 0; i < flat_parts_.size(); ++i) {
+    actual_part_rigid_motion_.emplace(flat_parts_[i], *actual_rigid_motions[i]);
+    rigid_pile_up_.emplace(flat_parts_[i], *rigid_transformations[i]);
   }
   apparent_part_rigid_motion_.clear();
 }
@@ -583,30 +650,50 @@ absl::Status PileUp::AdvanceTime(Instant const& t) {
   if (intrinsic_force_ == Vector<Force, Barycentric>{}) {
     // Remove the fork.
     trajectory_.DeleteSegments(psychohistory_);
-    if (fixed_instance_ == nullptr) {
-      fixed_instance_ = ephemeris_->NewInstance(
-          {&trajectory_},
-          Ephemeris<Barycentric>::NoIntrinsicAccelerations,
-          fixed_step_parameters_);
-    }
     CHECK_LT(history_->back().time, t);
-    status = ephemeris_->FlowWithFixedStep(t, *fixed_instance_);
-    psychohistory_ = trajectory_.NewSegment();
-    if (history_->back().time < t) {
-      // Do not clear the |fixed_instance_| here, we will use it for the next
-      // fixed-step integration.
-      status.Update(
-          ephemeris_->FlowWithAdaptiveStep(
-              &trajectory_,
-              Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-              t,
-              adaptive_step_parameters_,
-              Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
+    if (FlowKeplerianIfUnperturbed(t)) {
+      // The fixed instance and the group don't know about the points that we
+      // just appended.  The instance will be re-created from the end of the
+      // history as needed.
+      fixed_instance_ = nullptr;
+      LeaveLockStepHistories();
+    } else {
+      if (JoinLockStepHistoriesIfPossible() &&
+          lock_step_histories_->FlowHistory(this, t, trajectory_)) {
+        // The fixed instance would not know about the points appended by the
+        // group.
+        fixed_instance_ = nullptr;
+      } else {
+        if (fixed_instance_ == nullptr) {
+          fixed_instance_ = ephemeris_->NewInstance(
+              {&trajectory_},
+              Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+              fixed_step_parameters_);
+        }
+        status = ephemeris_->FlowWithFixedStep(t, *fixed_instance_);
+      }
+      psychohistory_ = trajectory_.NewSegment();
+      if (history_->back().time < t) {
+        // Do not clear the |fixed_instance_| here, we will use it for the next
+        // fixed-step integration.
+        status.Update(
+            ephemeris_->FlowWithAdaptiveStep(
+                &trajectory_,
+                Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+                t,
+                adaptive_step_parameters_,
+                Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
+      }
     }
   } else {
     // Destroy the fixed instance, it wouldn't be correct to use it the next
-    // time we go through this function.  It will be re-created as needed.
+    // time we go through this function.  It will be re-created as needed.  For
+    // the same reason, leave the group, we'll join it again once coasting.
     fixed_instance_ = nullptr;
+    LeaveLockStepHistories();
+    // The next coast starts with a fresh error budget.
+    kepler_coast_position_error_ = Length();
+    kepler_coast_velocity_error_ = Speed();
     // We make the |psychohistory_|, if any, authoritative, i.e. append it to
     // the end of the |history_|.  We integrate on top of it.  Note how we skip
     // the first point of the psychohistory, which is already present in the
@@ -636,19 +723,112 @@ absl::Status PileUp::AdvanceTime(Instant const& t) {
   // anymore.
   auto const history_end = history_->end();
   auto const psychohistory_end = psychohistory_->end();
-  for (auto it = trajectory_.upper_bound(history_last);
-       it != history_end;
-       ++it) {
-    AppendToPart<&Part::AppendToHistory>(it);
-  }
-  for (auto it = history_end; it != psychohistory_end; ++it) {
-    AppendToPart<&Part::AppendToPsychohistory>(it);
-  }
+  AppendToParts<&Part::AppendToHistory>(trajectory_.upper_bound(history_last),
+                                        history_end);
+  AppendToParts<&Part::AppendToPsychohistory>(history_end, psychohistory_end);
   trajectory_.ForgetBefore(psychohistory_->front().time);
 
   return status;
 }
 
+bool PileUp::FlowKeplerianIfUnperturbed(Instant const& t) {
+  if (!Flags::IsPresent(kepler_coast_flag) || !ephemeris_->Prolong(t).ok()) {
+    return false;
+  }
+  Instant const t0 = history_->back().time;
+  DegreesOfFreedom<Barycentric> const degrees_of_freedom0 =
+      history_->back().degrees_of_freedom;
+
+  // The primary is the body that exerts the largest acceleration at the
+  // beginning of the interval.
+  not_null<MassiveBody const*> primary = ephemeris_->bodies().front();
+  Acceleration largest_acceleration;
+  for (not_null<MassiveBody const*> const body : ephemeris_->bodies()) {
+    Acceleration const acceleration =
+        body->gravitational_parameter() /
+        (ephemeris_->trajectory(body)->EvaluatePosition(t0) -
+         degrees_of_freedom0.position()).Norm²();
+    if (acceleration > largest_acceleration) {
+      primary = body;
+      largest_acceleration = acceleration;
+    }
+  }
+  auto const primary_trajectory = ephemeris_->trajectory(primary);
+  KeplerOrbit<Barycentric> const orbit(
+      *primary,
+      MasslessBody{},
+      degrees_of_freedom0 - primary_trajectory->EvaluateDegreesOfFreedom(t0),
+      t0);
+
+  // The perturbation is the difference between the acceleration of the pile-up
+  // relative to the primary and the two-body acceleration.  It is sampled at
+  // the ends and in the middle of the interval, and taken to be constant over
+  // it to bound the deviation from the Keplerian orbit.
+  Time const Δt = t - t0;
+  Acceleration largest_perturbation;
+  for (Instant const& s : {t0, t0 + 0.5 * Δt, t}) {
+    Displacement<Barycentric> const r = orbit.StateVectors(s).displacement();
+    Vector<Acceleration, Barycentric> const two_body_acceleration =
+        -primary->gravitational_parameter() * r / Pow<3>(r.Norm());
+    Vector<Acceleration, Barycentric> const perturbation =
+        ephemeris_->ComputeGravitationalAccelerationOnMasslessBody(
+            primary_trajectory->EvaluatePosition(s) + r, s) -
+        ephemeris_->ComputeGravitationalAccelerationOnMassiveBody(primary, s) -
+        two_body_acceleration;
+    largest_perturbation = std::max(largest_perturbation, perturbation.Norm());
+  }
+  // The deviations of the consecutive Keplerian arcs of this coast add up, and
+  // the velocity deviation carries over to the position.
+  if (kepler_coast_position_error_ + kepler_coast_velocity_error_ * Δt +
+              0.5 * largest_perturbation * Pow<2>(Δt) >
+          adaptive_step_parameters_.length_integration_tolerance() ||
+      kepler_coast_velocity_error_ + largest_perturbation * Δt >
+          adaptive_step_parameters_.speed_integration_tolerance()) {
+    return false;
+  }
+
+  auto const keplerian_degrees_of_freedom = [&orbit, primary_trajectory](
+                                                Instant const& s) {
+    return primary_trajectory->EvaluateDegreesOfFreedom(s) +
+           orbit.StateVectors(s);
+  };
+  Time const step = fixed_step_parameters_.step();
+  for (std::int64_t n = 1; t0 + n * step <= t; ++n) {
+    Instant const s = t0 + n * step;
+    CHECK_OK(trajectory_.Append(s, keplerian_degrees_of_freedom(s)));
+  }
+  // Only the history is authoritative, the psychohistory will be recomputed.
+  Time const Δt_history = history_->back().time - t0;
+  kepler_coast_position_error_ += kepler_coast_velocity_error_ * Δt_history +
+                                  0.5 * largest_perturbation *
+                                      Pow<2>(Δt_history);
+  kepler_coast_velocity_error_ += largest_perturbation * Δt_history;
+
+  psychohistory_ = trajectory_.NewSegment();
+  if (history_->back().time < t) {
+    CHECK_OK(trajectory_.Append(t, keplerian_degrees_of_freedom(t)));
+  }
+  return true;
+}
+
+bool PileUp::JoinLockStepHistoriesIfPossible() {
+  if (lock_step_histories_ == nullptr) {
+    return false;
+  }
+  return lock_step_histories_->Contains(this) ||
+         lock_step_histories_->Add(this,
+                                   history_->back().time,
+                                   history_->back().degrees_of_freedom,
+                                   fixed_step_parameters_,
+                                   adaptive_step_parameters_);
+}
+
+void PileUp::LeaveLockStepHistories() {
+  if (lock_step_histories_ != nullptr) {
+    lock_step_histories_->Remove(this);
+  }
+}
+
 void PileUp::NudgeParts() const {
   auto const actual_centre_of_mass = psychohistory_->back().degrees_of_freedom;
 
@@ -660,32 +840,82 @@ void PileUp::NudgeParts() const {
       Barycentric::nonrotating,
       actual_centre_of_mass.velocity()};
   auto const pile_up_to_barycentric = barycentric_to_pile_up.Inverse();
-  for (not_null<Part*> const part : parts_) {
-    RigidMotion<RigidPart, Barycentric> const actual_part_rigid_motion =
-        pile_up_to_barycentric * FindOrDie(actual_part_rigid_motion_, part);
-    part->set_rigid_motion(actual_part_rigid_motion);
+  ProcessPartsInChunks(
+      [this, &pile_up_to_barycentric](std::size_t const begin,
+                                       std::size_t const end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          not_null<Part*> const part = flat_parts_[i];
+          RigidMotion<RigidPart, Barycentric> const actual_part_rigid_motion =
+              pile_up_to_barycentric *
+              FindOrDie(actual_part_rigid_motion_, part);
+          part->set_rigid_motion(actual_part_rigid_motion);
+        }
+      });
+}
+
+void PileUp::ProcessPartsInChunks(
+    std::function<void(std::size_t begin, std::size_t end)> const& process)
+    const {
+  std::size_t const number_of_parts = flat_parts_.size();
+  if (number_of_parts < min_parts_for_parallelism_) {
+    process(0, number_of_parts);
+    return;
+  }
+  std::vector<std::future<void>> futures;
+  for (std::size_t begin = 0; begin < number_of_parts;
+       begin += parts_per_chunk) {
+    std::size_t const end = std::min(begin + parts_per_chunk, number_of_parts);
+    futures.push_back(PartsThreadPool().Add(
+        [&process, begin, end]() { process(begin, end); }));
+  }
+  for (auto& future : futures) {
+    future.wait();
   }
 }
 
 template<PileUp::AppendToPartTrajectory append_to_part_trajectory>
-void PileUp::AppendToPart(DiscreteTrajectory<Barycentric>::iterator it) const {
-  auto const& pile_up_dof = it->degrees_of_freedom;
-  RigidMotion<Barycentric, NonRotatingPileUp> const barycentric_to_pile_up(
-      RigidTransformation<Barycentric, NonRotatingPileUp>(
-          pile_up_dof.position(),
-          NonRotatingPileUp::origin,
-          OrthogonalMap<Barycentric, NonRotatingPileUp>::Identity()),
-      Barycentric::nonrotating,
-      pile_up_dof.velocity());
-  auto const pile_up_to_barycentric = barycentric_to_pile_up.Inverse();
-  for (not_null<Part*> const part : parts_) {
-    DegreesOfFreedom<NonRotatingPileUp> const actual_part_degrees_of_freedom =
-        FindOrDie(actual_part_rigid_motion_, part)({RigidPart::origin,
-                                                    RigidPart::unmoving});
-    (static_cast<Part*>(part)->*append_to_part_trajectory)(
-        it->time,
-        pile_up_to_barycentric(actual_part_degrees_of_freedom));
+void PileUp::AppendToParts(
+    DiscreteTrajectory<Barycentric>::iterator const begin,
+    DiscreteTrajectory<Barycentric>::iterator const end) const {
+  if (begin == end) {
+    return;
   }
+
+  // The motions of the pile-up at the points to append, shared by all the
+  // parts.
+  std::vector<Instant> times;
+  std::vector<RigidMotion<NonRotatingPileUp, Barycentric>>
+      pile_up_to_barycentric;
+  for (auto it = begin; it != end; ++it) {
+    auto const& pile_up_dof = it->degrees_of_freedom;
+    RigidMotion<Barycentric, NonRotatingPileUp> const barycentric_to_pile_up(
+        RigidTransformation<Barycentric, NonRotatingPileUp>(
+            pile_up_dof.position(),
+            NonRotatingPileUp::origin,
+            OrthogonalMap<Barycentric, NonRotatingPileUp>::Identity()),
+        Barycentric::nonrotating,
+        pile_up_dof.velocity());
+    times.push_back(it->time);
+    pile_up_to_barycentric.push_back(barycentric_to_pile_up.Inverse());
+  }
+
+  // Each chunk appends all the points to its own parts.
+  ProcessPartsInChunks(
+      [this, &pile_up_to_barycentric, &times](std::size_t const parts_begin,
+                                              std::size_t const parts_end) {
+        for (std::size_t i = parts_begin; i < parts_end; ++i) {
+          not_null<Part*> const part = flat_parts_[i];
+          DegreesOfFreedom<NonRotatingPileUp> const
+              actual_part_degrees_of_freedom =
+                  FindOrDie(actual_part_rigid_motion_, part)(
+                      {RigidPart::origin, RigidPart::unmoving});
+          for (std::size_t j = 0; j < times.size(); ++j) {
+            (static_cast<Part*>(part)->*append_to_part_trajectory)(
+                times[j],
+                pile_up_to_barycentric[j](actual_part_degrees_of_freedom));
+          }
+        }
+      });
 }
 
 PileUpFuture::PileUpFuture(not_null<PileUp const*> const pile_up,
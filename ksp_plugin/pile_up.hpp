@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <list>
@@ -7,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
@@ -26,6 +28,7 @@
 #include "quantities/named_quantities.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/lock_step_histories.hpp"
 #include "serialization/ksp_plugin.pb.h"
 
 namespace principia {
@@ -45,6 +48,7 @@ using namespace principia::geometry::_instant;
 using namespace principia::integrators::_integrators;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
+using namespace principia::ksp_plugin::_lock_step_histories;
 using namespace principia::ksp_plugin::_part;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
@@ -122,6 +126,12 @@ class PileUp {
   // Recomputes the state of motion of the pile-up based on that of its parts.
   void RecomputeFromParts();
 
+  // If |lock_step_histories| is not null, the history of this pile-up is
+  // integrated as part of that group whenever it has no intrinsic
+  // acceleration.  If it is null, the pile-up integrates its history on its
+  // own.  The group must outlive this object.
+  void SetLockStepHistories(LockStepHistories* lock_step_histories);
+
   // We'd like to return |not_null<std::shared_ptr<PileUp>> const&|, but the
   // compiler gets confused when defining the corresponding lambda, and thinks
   // that we return a local variable even though we capture by reference.
@@ -176,19 +186,55 @@ class PileUp {
   // and of its parts have a (possibly ahistorical) final point exactly at |t|.
   absl::Status AdvanceTime(Instant const& t);
 
+  // If the flag |kepler_coast| is set and the perturbations of the osculating
+  // Keplerian orbit around the body that dominates the motion of the pile-up
+  // are negligible until |t|, appends the points of that orbit to the
+  // |history_| at the fixed step, creates a |psychohistory_| ending at |t|, and
+  // returns true.  Otherwise returns false and leaves |trajectory_| unchanged.
+  // The perturbations are negligible if, added to the deviations accumulated
+  // since the beginning of the coast, they remain within the tolerances of the
+  // |adaptive_step_parameters_|; once they don't, the rest of the coast is
+  // integrated.  Must only be called when there is no intrinsic force and no
+  // |psychohistory_|.
+  bool FlowKeplerianIfUnperturbed(Instant const& t);
+
+  // Returns true if this pile-up is part of the |lock_step_histories_|,
+  // joining it if possible.
+  bool JoinLockStepHistoriesIfPossible();
+
+  // Leaves the |lock_step_histories_|, if any.
+  void LeaveLockStepHistories();
+
   // Adjusts the degrees of freedom of all parts in this pile up based on the
   // degrees of freedom of the pile-up computed by |AdvanceTime| and on the
   // |NonRotatingPileUp| degrees of freedom of the parts, as set by
   // |DeformPileUpIfNeeded|.
   void NudgeParts() const;
 
+  // Calls |process(begin, end)| on consecutive chunks covering the indices
+  // [0, flat_parts_.size()[, in parallel if there are at least
+  // |min_parts_for_parallelism_| parts.  The calls must be independent of one
+  // another.
+  void ProcessPartsInChunks(
+      std::function<void(std::size_t begin, std::size_t end)> const& process)
+      const;
+
+  // Appends the points of the pile-up trajectory in [begin, end[ to the
+  // trajectories of all the parts.  Large pile-ups are processed in parallel.
   template<AppendToPartTrajectory append_to_part_trajectory>
-  void AppendToPart(DiscreteTrajectory<Barycentric>::iterator it) const;
+  void AppendToParts(DiscreteTrajectory<Barycentric>::iterator begin,
+                     DiscreteTrajectory<Barycentric>::iterator end) const;
 
   // Wrapped in a |unique_ptr| to be moveable.
   not_null<std::unique_ptr<absl::Mutex>> lock_;
 
   std::list<not_null<Part*>> parts_;
+  // The elements of |parts_|, in the same order, for indexed access when the
+  // per-part work is split in chunks.
+  std::vector<not_null<Part*>> flat_parts_;
+  // Pile-ups with fewer parts than this are processed on the calling thread.
+  // Not serialized; only changed by tests, to compare with a serial run.
+  std::size_t min_parts_for_parallelism_ = 128;
   not_null<Ephemeris<Barycentric>*> ephemeris_;
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
   Ephemeris<Barycentric>::FixedStepParameters fixed_step_parameters_;
@@ -234,6 +280,16 @@ class PileUp {
       Ephemeris<Barycentric>::NewtonianMotionEquation>::Instance>
       fixed_instance_;
 
+  // Bounds on the deviation of the history from the integrated trajectory
+  // accumulated by the Keplerian arcs of |FlowKeplerianIfUnperturbed| since the
+  // last intrinsic force.  Not serialized.
+  Length kepler_coast_position_error_;
+  Speed kepler_coast_velocity_error_;
+
+  // When not null, this pile-up integrates its history as part of this group
+  // instead of using |fixed_instance_| whenever it can.  Not serialized.
+  LockStepHistories* lock_step_histories_ = nullptr;
+
   PartTo<RigidMotion<RigidPart, NonRotatingPileUp>> actual_part_rigid_motion_;
   PartTo<RigidMotion<RigidPart, Apparent>> apparent_part_rigid_motion_;
 
@@ -1,6 +1,7 @@
 #include "ksp_plugin/planetarium.hpp"
 
 #include <algorithm>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -50,6 +51,140 @@ Planetarium::Planetarium(
       plotting_frame_(plotting_frame),
       plotting_to_scaled_space_(std::move(plotting_to_scaled_space)) {}
 
+Planetarium::PlottableSpheres::PlottableSpheres(
+    std::vector<Sphere<Navigation>> spheres,
+    Perspective<Navigation, Camera> const& perspective,
+    Length const& field_of_view_radius)
+    : spheres_(std::move(spheres)) {
+  bounding_boxes_.reserve(spheres_.size());
+  for (int i = 0; i < spheres_.size(); ++i) {
+    bounding_boxes_.push_back(perspective.SphereBoundingBox(spheres_[i]));
+    auto const& bounding_box = bounding_boxes_.back();
+    if (!bounding_box.has_value()) {
+      unbounded_.push_back(i);
+    } else if (!grid_box_.has_value()) {
+      grid_box_ = bounding_box;
+    } else {
+      grid_box_->first = RP2Point<Length, Camera>(
+          std::min(grid_box_->first.x(), bounding_box->first.x()),
+          std::min(grid_box_->first.y(), bounding_box->first.y()),
+          /*z=*/1);
+      grid_box_->second = RP2Point<Length, Camera>(
+          std::max(grid_box_->second.x(), bounding_box->second.x()),
+          std::max(grid_box_->second.y(), bounding_box->second.y()),
+          /*z=*/1);
+    }
+  }
+  if (!grid_box_.has_value()) {
+    return;
+  }
+
+  // Spheres far outside of the field of view would make the cells
+  // uselessly large.  Clamping is harmless, since the cell indices are
+  // clamped too.
+  grid_box_->first = RP2Point<Length, Camera>(
+      std::max(grid_box_->first.x(), -field_of_view_radius),
+      std::max(grid_box_->first.y(), -field_of_view_radius),
+      /*z=*/1);
+  grid_box_->second = RP2Point<Length, Camera>(
+      std::min(grid_box_->second.x(), field_of_view_radius),
+      std::min(grid_box_->second.y(), field_of_view_radius),
+      /*z=*/1);
+
+  cells_.resize(grid_size * grid_size);
+  for (int i = 0; i < spheres_.size(); ++i) {
+    auto const& bounding_box = bounding_boxes_[i];
+    if (!bounding_box.has_value()) {
+      continue;
+    }
+    int const column_min = CellIndex(bounding_box->first.x(),
+                                     grid_box_->first.x(),
+                                     grid_box_->second.x());
+    int const column_max = CellIndex(bounding_box->second.x(),
+                                     grid_box_->first.x(),
+                                     grid_box_->second.x());
+    int const row_min = CellIndex(bounding_box->first.y(),
+                                  grid_box_->first.y(),
+                                  grid_box_->second.y());
+    int const row_max = CellIndex(bounding_box->second.y(),
+                                  grid_box_->first.y(),
+                                  grid_box_->second.y());
+    for (int row = row_min; row <= row_max; ++row) {
+      for (int column = column_min; column <= column_max; ++column) {
+        cells_[row * grid_size + column].push_back(i);
+      }
+    }
+  }
+}
+
+void Planetarium::PlottableSpheres::FillCandidates(
+    Segment<Navigation> const& segment,
+    Perspective<Navigation, Camera> const& perspective,
+    std::vector<int>& indices,
+    std::vector<Sphere<Navigation>>& candidates) const {
+  candidates.clear();
+  if (spheres_.empty()) {
+    return;
+  }
+
+  // The segment is behind the focal plane, so its projection is the segment
+  // joining the projections of its extremities.  A sphere may only hide it if
+  // the bounding boxes of their projections intersect.
+  auto const rp2_first = perspective(segment.first);
+  auto const rp2_second = perspective(segment.second);
+  Length const x_min = std::min(rp2_first.x(), rp2_second.x());
+  Length const x_max = std::max(rp2_first.x(), rp2_second.x());
+  Length const y_min = std::min(rp2_first.y(), rp2_second.y());
+  Length const y_max = std::max(rp2_first.y(), rp2_second.y());
+
+  indices.clear();
+  indices.insert(indices.end(), unbounded_.begin(), unbounded_.end());
+  if (grid_box_.has_value()) {
+    int const column_min =
+        CellIndex(x_min, grid_box_->first.x(), grid_box_->second.x());
+    int const column_max =
+        CellIndex(x_max, grid_box_->first.x(), grid_box_->second.x());
+    int const row_min =
+        CellIndex(y_min, grid_box_->first.y(), grid_box_->second.y());
+    int const row_max =
+        CellIndex(y_max, grid_box_->first.y(), grid_box_->second.y());
+    for (int row = row_min; row <= row_max; ++row) {
+      for (int column = column_min; column <= column_max; ++column) {
+        for (int const i : cells_[row * grid_size + column]) {
+          auto const& bounding_box = *bounding_boxes_[i];
+          if (bounding_box.first.x() <= x_max &&
+              x_min <= bounding_box.second.x() &&
+              bounding_box.first.y() <= y_max &&
+              y_min <= bounding_box.second.y()) {
+            indices.push_back(i);
+          }
+        }
+      }
+    }
+  }
+
+  // A sphere may be found in several cells.  The order of the spheres must be
+  // preserved because it determines the order of the visible segments.
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  for (int const i : indices) {
+    candidates.push_back(spheres_[i]);
+  }
+}
+
+int Planetarium::PlottableSpheres::CellIndex(Length const& coordinate,
+                                             Length const& min,
+                                             Length const& max) {
+  if (!(coordinate > min)) {
+    return 0;
+  } else if (!(coordinate < max)) {
+    return grid_size - 1;
+  }
+  return std::min(static_cast<int>(grid_size * ((coordinate - min) /
+                                                (max - min))),
+                  grid_size - 1);
+}
+
 RP2Lines<Length, Camera> Planetarium::PlotMethod0(
     DiscreteTrajectory<Barycentric> const& trajectory,
     DiscreteTrajectory<Barycentric>::iterator const begin,
@@ -58,8 +193,8 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod0(
     bool const /*reverse*/) const {
   auto const plottable_begin = trajectory.lower_bound(plotting_frame_->t_min());
   auto const plottable_end = trajectory.lower_bound(plotting_frame_->t_max());
-  auto const plottable_spheres = ComputePlottableSpheres(now);
-  auto const plottable_segments = ComputePlottableSegments(plottable_spheres,
+  auto const plottable_spheres = GetPlottableSpheres(now);
+  auto const plottable_segments = ComputePlottableSegments(*plottable_spheres,
                                                            plottable_begin,
                                                            plottable_end);
 
@@ -161,7 +296,9 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
     bool const reverse,
     Length* const minimal_distance) const {
   RP2Lines<Length, Camera> lines;
-  auto const plottable_spheres = ComputePlottableSpheres(now);
+  auto const plottable_spheres = GetPlottableSpheres(now);
+  std::vector<int> indices;
+  std::vector<Sphere<Navigation>> candidates;
   double const tan²_angular_resolution =
       Pow<2>(parameters_.tan_angular_resolution_);
   auto const final_time = reverse ? first_time : last_time;
@@ -251,9 +388,10 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
                    perspective_.SquaredDistanceFromCamera(position));
     }
 
-    auto const visible_segments = perspective_.VisibleSegments(
-                                      *segment_behind_focal_plane,
-                                      plottable_spheres);
+    auto const visible_segments = VisibleSegments(*segment_behind_focal_plane,
+                                                  *plottable_spheres,
+                                                  indices,
+                                                  candidates);
     for (auto const& segment : visible_segments) {
       if (last_endpoint != segment.first) {
         lines.emplace_back();
@@ -495,14 +633,30 @@ std::vector<Sphere<Navigation>> Planetarium::ComputePlottableSpheres(
   return plottable_spheres;
 }
 
+std::shared_ptr<Planetarium::PlottableSpheres const>
+Planetarium::GetPlottableSpheres(Instant const& now) const {
+  absl::MutexLock l(&lock_);
+  if (plottable_spheres_ == nullptr || plottable_spheres_time_ != now) {
+    plottable_spheres_ = std::make_shared<PlottableSpheres const>(
+        ComputePlottableSpheres(now),
+        perspective_,
+        /*field_of_view_radius=*/perspective_.focal() *
+            parameters_.tan_field_of_view_);
+    plottable_spheres_time_ = now;
+  }
+  return plottable_spheres_;
+}
+
 Segments<Navigation> Planetarium::ComputePlottableSegments(
-    const std::vector<Sphere<Navigation>>& plottable_spheres,
+    PlottableSpheres const& plottable_spheres,
     DiscreteTrajectory<Barycentric>::iterator const begin,
     DiscreteTrajectory<Barycentric>::iterator const end) const {
   Segments<Navigation> all_segments;
   if (begin == end) {
     return all_segments;
   }
+  std::vector<int> indices;
+  std::vector<Sphere<Navigation>> candidates;
   auto it1 = begin;
   Instant t1 = it1->time;
   SimilarMotion<Barycentric, Navigation> similar_motion_at_t1 =
@@ -529,8 +683,10 @@ Segments<Navigation> Planetarium::ComputePlottableSegments(
     if (segment_behind_focal_plane) {
       // Find the part(s) of the segment that are not hidden by spheres.  These
       // are the ones we want to plot.
-      auto segments = perspective_.VisibleSegments(*segment_behind_focal_plane,
-                                                   plottable_spheres);
+      auto segments = VisibleSegments(*segment_behind_focal_plane,
+                                      plottable_spheres,
+                                      indices,
+                                      candidates);
       std::move(segments.begin(),
                 segments.end(),
                 std::back_inserter(all_segments));
@@ -545,6 +701,18 @@ Segments<Navigation> Planetarium::ComputePlottableSegments(
   return all_segments;
 }
 
+Segments<Navigation> Planetarium::VisibleSegments(
+    Segment<Navigation> const& segment,
+    PlottableSpheres const& plottable_spheres,
+    std::vector<int>& indices,
+    std::vector<Sphere<Navigation>>& candidates) const {
+  plottable_spheres.FillCandidates(segment, perspective_, indices, candidates);
+  if (candidates.empty()) {
+    return {segment};
+  }
+  return perspective_.VisibleSegments(segment, candidates);
+}
+
 }  // namespace internal
 }  // namespace _planetarium
 }  // namespace ksp_plugin
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
+#include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -156,23 +160,87 @@ class Planetarium {
       Length* minimal_distance = nullptr) const;
 
  private:
+  // The spheres that may hide trajectories, together with a uniform grid of
+  // the focal plane that records, for each cell, the spheres whose projection
+  // intersects it.  This makes it possible to test each segment against the
+  // few spheres that are projected near it instead of against all of them.
+  class PlottableSpheres final {
+   public:
+    PlottableSpheres(std::vector<Sphere<Navigation>> spheres,
+                     Perspective<Navigation, Camera> const& perspective,
+                     Length const& field_of_view_radius);
+
+    // Fills |candidates| with the spheres that may hide |segment|, which must
+    // be behind the focal plane, in the order in which they were given at
+    // construction.  |indices| is used as scratch space.
+    void FillCandidates(Segment<Navigation> const& segment,
+                        Perspective<Navigation, Camera> const& perspective,
+                        std::vector<int>& indices,
+                        std::vector<Sphere<Navigation>>& candidates) const;
+
+   private:
+    // The bounding box of the projection of a sphere, as its lower-left and
+    // upper-right corners.
+    using BoundingBox =
+        std::pair<RP2Point<Length, Camera>, RP2Point<Length, Camera>>;
+
+    static constexpr int grid_size = 16;
+
+    // Returns the index, in [0, grid_size[, of the column or row that contains
+    // |coordinate|, clamping if it is outside of the grid.
+    static int CellIndex(Length const& coordinate,
+                         Length const& min,
+                         Length const& max);
+
+    std::vector<Sphere<Navigation>> const spheres_;
+    // Parallel to |spheres_|.  Empty for spheres whose projection is
+    // unbounded.
+    std::vector<std::optional<BoundingBox>> bounding_boxes_;
+    // The spheres whose projection is unbounded, in increasing order.
+    std::vector<int> unbounded_;
+    // The extent of the grid.  Nullopt if there are no bounded spheres.
+    std::optional<BoundingBox> grid_box_;
+    // For each cell, in row-major order, the spheres whose bounding box
+    // intersects it, in increasing order.
+    std::vector<std::vector<int>> cells_;
+  };
+
   // Computes the coordinates of the spheres that represent the |ephemeris_|
   // bodies.  These coordinates are in the |plotting_frame_| at time |now|.
   std::vector<Sphere<Navigation>> ComputePlottableSpheres(
       Instant const& now) const;
 
+  // Returns the |PlottableSpheres| at time |now|.  They are only computed once
+  // for a given |now|, and shared by all the plots of this object.
+  std::shared_ptr<PlottableSpheres const> GetPlottableSpheres(
+      Instant const& now) const;
+
   // Computes the segments of the trajectory defined by |begin| and |end| that
   // are not hidden by the |plottable_spheres|.
   Segments<Navigation> ComputePlottableSegments(
-      const std::vector<Sphere<Navigation>>& plottable_spheres,
+      PlottableSpheres const& plottable_spheres,
       DiscreteTrajectory<Barycentric>::iterator begin,
       DiscreteTrajectory<Barycentric>::iterator end) const;
 
+  // Returns the (sub)segments of |segment|, which must be behind the focal
+  // plane, that are not hidden by the |plottable_spheres|.  |indices| and
+  // |candidates| are used as scratch space.
+  Segments<Navigation> VisibleSegments(
+      Segment<Navigation> const& segment,
+      PlottableSpheres const& plottable_spheres,
+      std::vector<int>& indices,
+      std::vector<Sphere<Navigation>>& candidates) const;
+
   Parameters const parameters_;
   Perspective<Navigation, Camera> const perspective_;
   not_null<Ephemeris<Barycentric> const*> const ephemeris_;
   not_null<PlottingFrame const*> const plotting_frame_;
   PlottingToScaledSpaceConversion plotting_to_scaled_space_;
+
+  mutable absl::Mutex lock_;
+  mutable std::optional<Instant> plottable_spheres_time_ GUARDED_BY(lock_);
+  mutable std::shared_ptr<PlottableSpheres const> plottable_spheres_
+      GUARDED_BY(lock_);
 };
 
 inline ScaledSpacePoint ScaledSpacePoint::FromCoordinates(
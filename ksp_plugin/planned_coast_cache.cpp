@@ -0,0 +1,154 @@
+#include "ksp_plugin/planned_coast_cache.hpp"
+
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "geometry/grassmann.hpp"
+#include "geometry/sign.hpp"
+#include "glog/logging.h"
+#include "physics/apsides.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _planned_coast_cache {
+namespace internal {
+
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_sign;
+using namespace principia::physics::_apsides;
+
+PlannedCoastCache::Coast::Coast(DiscreteTrajectory<Navigation> trajectory)
+    : trajectory_(std::move(trajectory)) {
+  CHECK(!trajectory_.empty());
+  times_.reserve(trajectory_.size());
+  positions_.reserve(trajectory_.size());
+  velocities_.reserve(trajectory_.size());
+  for (auto const& [time, degrees_of_freedom] : trajectory_) {
+    times_.push_back(time);
+    positions_.push_back(degrees_of_freedom.position());
+    velocities_.push_back(degrees_of_freedom.velocity());
+  }
+}
+
+DiscreteTrajectory<Navigation> const&
+PlannedCoastCache::Coast::trajectory() const {
+  return trajectory_;
+}
+
+DegreesOfFreedom<Navigation>
+PlannedCoastCache::Coast::NearestDegreesOfFreedom(
+    Position<Navigation> const& reference_position) const {
+  // The derivative of the squared distance to the reference, computed as in
+  // |ComputeApsides|.
+  auto const squared_distance_derivative = [this, &reference_position](
+                                               std::int64_t const i) {
+    return 2.0 * InnerProduct(positions_[i] - reference_position,
+                              velocities_[i]);
+  };
+
+  std::int64_t const size = times_.size();
+  std::optional<Sign> previous_sign;
+  for (std::int64_t i = 0; i < size; ++i) {
+    Sign const sign(squared_distance_derivative(i));
+    // A change from decreasing to increasing distance brackets a periapsis.
+    if (previous_sign.has_value() && previous_sign->is_negative() &&
+        !sign.is_negative()) {
+      DiscreteTrajectory<Navigation> immobile_reference;
+      CHECK_OK(immobile_reference.Append(
+          times_[i - 1], {reference_position, Navigation::unmoving}));
+      CHECK_OK(immobile_reference.Append(
+          times_[i], {reference_position, Navigation::unmoving}));
+      auto const begin = trajectory_.find(times_[i - 1]);
+      DiscreteTrajectory<Navigation> apoapsides;
+      DiscreteTrajectory<Navigation> periapsides;
+      ComputeApsides(/*reference=*/immobile_reference,
+                     trajectory_,
+                     begin, std::next(begin, 2),
+                     /*max_points=*/std::numeric_limits<int>::max(),
+                     apoapsides,
+                     periapsides);
+      if (!periapsides.empty()) {
+        return periapsides.front().degrees_of_freedom;
+      }
+      // The apsis could not be located, |ComputeApsides| would have given up.
+      break;
+    }
+    previous_sign = sign;
+  }
+
+  bool const begin_is_nearest =
+      (positions_.front() - reference_position).Norm²() <
+      (positions_.back() - reference_position).Norm²();
+  return begin_is_nearest ? trajectory_.front().degrees_of_freedom
+                          : trajectory_.back().degrees_of_freedom;
+}
+
+double PlannedCoastCache::Statistics::hit_rate() const {
+  std::int64_t const lookups = hits + misses;
+  return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+PlannedCoastCache::PlannedCoastCache(std::int64_t const max_entries)
+    : max_entries_(max_entries) {
+  CHECK_LE(1, max_entries_);
+}
+
+not_null<std::shared_ptr<PlannedCoastCache::Coast const>>
+PlannedCoastCache::GetOrTransform(
+    Key const& key,
+    DiscreteTrajectorySegmentIterator<Barycentric> const segment,
+    NavigationFrame const& body_centred_inertial) {
+  {
+    absl::MutexLock l(&lock_);
+    if (auto const it = entries_by_key_.find(key);
+        it != entries_by_key_.end()) {
+      ++statistics_.hits;
+      // Mark the entry as most recently used.
+      Entries::iterator const entry = it->second;
+      entries_.splice(entries_.begin(), entries_, entry);
+      return entry->coast;
+    }
+    ++statistics_.misses;
+  }
+
+  // Transform the coast without holding the lock, so that the queries for other
+  // coasts are not delayed.
+  DiscreteTrajectory<Navigation> trajectory;
+  for (auto const& [time, degrees_of_freedom] : *segment) {
+    CHECK_OK(trajectory.Append(
+        time,
+        body_centred_inertial.ToThisFrameAtTime(time)(degrees_of_freedom)));
+  }
+  not_null<std::shared_ptr<Coast const>> const coast =
+      make_not_null_shared<Coast const>(std::move(trajectory));
+
+  absl::MutexLock l(&lock_);
+  // Another thread may have inserted the same coast in the meantime, in which
+  // case the entry is refreshed; both coasts are identical.
+  if (auto const it = entries_by_key_.find(key);
+      it != entries_by_key_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->coast;
+  }
+  entries_.push_front({.key = key, .coast = coast});
+  entries_by_key_.emplace(key, entries_.begin());
+  while (entries_by_key_.size() > max_entries_) {
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++statistics_.evictions;
+  }
+  return coast;
+}
+
+PlannedCoastCache::Statistics PlannedCoastCache::statistics() const {
+  absl::MutexLock l(&lock_);
+  return statistics_;
+}
+
+}  // namespace internal
+}  // namespace _planned_coast_cache
+}  // namespace ksp_plugin
+}  // namespace principia
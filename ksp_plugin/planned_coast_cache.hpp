@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/discrete_trajectory_segment_iterator.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _planned_coast_cache {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_discrete_trajectory_segment_iterator;
+
+// A cache of the coasts of the flight plans transformed to the body-centred
+// non-rotating frame of some celestial, for the nearest-approach queries of the
+// external interface.  A coast is identified by the version of its flight plan,
+// so any edit of the flight plan makes its cached coasts unreachable; they are
+// then evicted as the least recently used entries.  This class is thread-safe.
+class PlannedCoastCache {
+ public:
+  struct Key {
+    std::int64_t flight_plan_version;
+    int segment_index;
+    int central_body_index;
+
+    friend bool operator==(Key const& left, Key const& right) = default;
+
+    template<typename H>
+    friend H AbslHashValue(H h, Key const& key) {
+      return H::combine(std::move(h),
+                        key.flight_plan_version,
+                        key.segment_index,
+                        key.central_body_index);
+    }
+  };
+
+  // A coast in a body-centred non-rotating frame.
+  class Coast {
+   public:
+    explicit Coast(DiscreteTrajectory<Navigation> trajectory);
+
+    DiscreteTrajectory<Navigation> const& trajectory() const;
+
+    // Returns the degrees of freedom at the first periapsis of this coast with
+    // respect to |reference_position|, or, if there is no periapsis, at the
+    // endpoint of this coast nearest to |reference_position|.
+    DegreesOfFreedom<Navigation> NearestDegreesOfFreedom(
+        Position<Navigation> const& reference_position) const;
+
+   private:
+    DiscreteTrajectory<Navigation> const trajectory_;
+    // The points of |trajectory_|, stored contiguously so that the interval
+    // containing the first periapsis may be found by a linear scan.  Only that
+    // interval is then passed to |ComputeApsides|.
+    std::vector<Instant> times_;
+    std::vector<Position<Navigation>> positions_;
+    std::vector<Velocity<Navigation>> velocities_;
+  };
+
+  struct Statistics {
+    std::int64_t hits = 0;
+    std::int64_t misses = 0;
+    std::int64_t evictions = 0;
+
+    // The fraction of the calls to |GetOrTransform| that found a coast, or 0
+    // if there was no such call.
+    double hit_rate() const;
+  };
+
+  explicit PlannedCoastCache(std::int64_t max_entries);
+
+  // Returns the coast for |key|.  If it is not in the cache, it is obtained by
+  // transforming the points of |segment| to |body_centred_inertial|, which
+  // must be the frame of the central body of |key|.
+  not_null<std::shared_ptr<Coast const>> GetOrTransform(
+      Key const& key,
+      DiscreteTrajectorySegmentIterator<Barycentric> segment,
+      NavigationFrame const& body_centred_inertial);
+
+  Statistics statistics() const;
+
+ private:
+  struct Entry {
+    Key key;
+    not_null<std::shared_ptr<Coast const>> coast;
+  };
+  using Entries = std::list<Entry>;
+
+  std::int64_t const max_entries_;
+
+  mutable absl::Mutex lock_;
+  // Most recently used first.
+  Entries entries_ GUARDED_BY(lock_);
+  absl::flat_hash_map<Key, Entries::iterator> entries_by_key_ GUARDED_BY(lock_);
+  Statistics statistics_ GUARDED_BY(lock_);
+};
+
+}  // namespace internal
+
+using internal::PlannedCoastCache;
+
+}  // namespace _planned_coast_cache
+}  // namespace ksp_plugin
+}  // namespace principia
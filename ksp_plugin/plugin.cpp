@@ -4,6 +4,8 @@
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <ios>
 #include <limits>
 #include <list>
@@ -11,7 +13,6 @@
 #include <optional>
 #include <set>
 #include <string>
-#include <thread>
 #include <utility>
 #include <vector>
 
@@ -21,6 +22,7 @@
 #include "astronomy/stabilize_ksp.hpp"
 #include "astronomy/time_scales.hpp"
 #include "base/file.hpp"
+#include "base/flags.hpp"
 #include "base/hexadecimal.hpp"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
@@ -64,6 +66,7 @@ using namespace principia::astronomy::_solar_system_fingerprints;
 using namespace principia::astronomy::_stabilize_ksp;
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_file;
+using namespace principia::base::_flags;
 using namespace principia::base::_fingerprint2011;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_map_util;
@@ -101,15 +104,30 @@ using namespace principia::quantities::_si;
 
 // Keep this consistent with |prediction_steps_| in |main_window.cs|.
 constexpr std::int64_t max_steps_in_prediction = 1 << 24;
+// Beyond this number of objects waiting for their destruction, the main thread
+// destroys the objects that it drops itself.
+constexpr std::int64_t max_graveyard_backlog = 100;
+// Enough for the coasts of a few manœuvres of the flight plans of the active
+// vessel and of the target, with respect to a couple of celestials.
+constexpr std::int64_t max_planned_coasts = 16;
+// The polynomials of the ephemeris that end more than this before the current
+// time are compressed, as they are rarely evaluated.
+constexpr Time ephemeris_compression_horizon = 30 * Day;
+// The free fall of the external bodies may prolong the ephemeris by at most
+// this duration, so that an external call cannot stall the game.
+constexpr Time max_freefall_prolongation = 365 * Day;
 
 Plugin::Plugin(std::string const& game_epoch,
                std::string const& solar_system_epoch,
                Angle const& planetarium_rotation)
-    : history_downsampling_parameters_(DefaultDownsamplingParameters()),
+    : graveyard_(/*number_of_threads=*/1, max_graveyard_backlog),
+      prediction_scheduler_(/*number_of_workers=*/std::max(
+          2, static_cast<int>(HardwareConcurrency()) / 2)),
+      planned_coast_cache_(max_planned_coasts),
+      history_downsampling_parameters_(DefaultDownsamplingParameters()),
       history_fixed_step_parameters_(DefaultHistoryParameters()),
       psychohistory_parameters_(DefaultPsychohistoryParameters()),
-      vessel_thread_pool_(
-          /*pool_size=*/2 * std::thread::hardware_concurrency()),
+      vessel_thread_pool_(/*pool_size=*/2 * HardwareConcurrency()),
       planetarium_rotation_(planetarium_rotation),
       game_epoch_(ParseTT(game_epoch)),
       current_time_(ParseTT(solar_system_epoch)) {
@@ -125,6 +143,10 @@ Plugin::~Plugin() {
   // destroyed, and therefore to destroy the pile-ups, which want to remove
   // themselves from |pile_up_|, which also exists.
   vessels_.clear();
+  // The objects buried by the vessels may refer to the ephemeris.
+  graveyard_.Flush();
+  LOG(INFO) << "Prediction scheduler statistics:\n"
+            << prediction_scheduler_.statistics();
 }
 
 void Plugin::InsertCelestialAbsoluteCartesian(
@@ -394,6 +416,10 @@ void Plugin::InsertOrKeepVessel(GUID const& vessel_guid,
     inserted = false;
   }
   not_null<Vessel*> const vessel = vit->second.get();
+  if (inserted) {
+    vessel->SetPredictionScheduler(&prediction_scheduler_);
+    vessel->SetGraveyard(&graveyard_);
+  }
   if (vessel->name() != vessel_name) {
     vessel->set_name(vessel_name);
   }
@@ -765,6 +791,8 @@ void Plugin::AdvanceTime(Instant const& t, Angle const& planetarium_rotation) {
   current_time_ = t;
   planetarium_rotation_ = planetarium_rotation;
   ephemeris_->Prolong(current_time_).IgnoreError();
+  ephemeris_->CompressTrajectoriesBefore(current_time_ -
+                                         ephemeris_compression_horizon);
   UpdatePlanetariumRotation();
   loaded_vessels_.clear();
 }
@@ -773,8 +801,10 @@ void Plugin::CatchUpLaggingVessels(VesselSet& collided_vessels) {
   CHECK(!initializing_);
 
   // Start all the integrations in parallel.
+  LockStepHistories* const lock_step_histories = this->lock_step_histories();
   std::vector<PileUpFuture> pile_up_futures;
   for (auto* const pile_up : pile_ups_) {
+    pile_up->SetLockStepHistories(lock_step_histories);
     pile_up_futures.emplace_back(
         pile_up,
         vessel_thread_pool_.Add([this, pile_up]() {
@@ -792,7 +822,8 @@ void Plugin::CatchUpLaggingVessels(VesselSet& collided_vessels) {
 
   // Update the vessels.
   for (auto const& [_, vessel] : vessels_) {
-    if (vessel->psychohistory()->back().time < current_time_) {
+    // Don't deserialize the trajectories of the vessels that were just loaded.
+    if (vessel->last_psychohistory_point().time < current_time_) {
       if (Contains(collided_vessels, vessel.get())) {
         vessel->DisableDownsampling();
       }
@@ -811,6 +842,7 @@ not_null<std::unique_ptr<PileUpFuture>> Plugin::CatchUpVessel(
   vessel.ForSomePart([&pile_up](Part& part) {
     pile_up = part.containing_pile_up();
   });
+  pile_up->SetLockStepHistories(lock_step_histories());
 
   return make_not_null_unique<PileUpFuture>(
       pile_up,
@@ -859,7 +891,7 @@ RelativeDegreesOfFreedom<AliceSun> Plugin::VesselFromParent(
     vessel->set_parent(parent);
   }
   RelativeDegreesOfFreedom<Barycentric> const barycentric_result =
-      vessel->psychohistory()->back().degrees_of_freedom -
+      vessel->last_psychohistory_point().degrees_of_freedom -
       vessel->parent()->current_degrees_of_freedom(current_time_);
   RelativeDegreesOfFreedom<AliceSun> const result =
       PlanetariumRotation()(barycentric_result);
@@ -917,17 +949,34 @@ void Plugin::SetPredictionAdaptiveStepParameters(
 
 void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
   CHECK(!initializing_);
+  Vessel* const target_vessel = renderer_->HasTargetVessel()
+                                   ? &renderer_->GetTargetVessel()
+                                   : nullptr;
   std::set<not_null<Vessel*>> predicted_vessels;
-  for (auto const& guid : vessel_guids) {
-    predicted_vessels.insert(FindOrDie(vessels_, guid).get());
+  for (int i = 0; i < vessel_guids.size(); ++i) {
+    not_null<Vessel*> const vessel = FindOrDie(vessels_, vessel_guids[i]).get();
+    predicted_vessels.insert(vessel);
+    if (i == 0) {
+      vessel->set_prediction_priority(
+          PredictionScheduler::Priority::ActiveVessel);
+    } else if (vessel == target_vessel) {
+      vessel->set_prediction_priority(PredictionScheduler::Priority::Target);
+    } else if (vessel->has_flight_plan()) {
+      vessel->set_prediction_priority(
+          PredictionScheduler::Priority::FlightPlan);
+    } else {
+      vessel->set_prediction_priority(PredictionScheduler::Priority::Visible);
+    }
   }
-  Vessel* target_vessel = nullptr;
 
   // If there is a target vessel, ensure that the prediction of the
   // |predicted_vessels| is not longer than that of the target vessel.  This is
   // necessary to build the targeting frame.
-  if (renderer_->HasTargetVessel()) {
-    target_vessel = &renderer_->GetTargetVessel();
+  if (target_vessel != nullptr) {
+    if (!Contains(predicted_vessels, target_vessel)) {
+      target_vessel->set_prediction_priority(
+          PredictionScheduler::Priority::Target);
+    }
     target_vessel->RefreshPrediction();
     for (auto const vessel : predicted_vessels) {
       vessel->RefreshPrediction(target_vessel->prediction()->back().time);
@@ -945,6 +994,84 @@ void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
   }
 }
 
+PredictionScheduler::Statistics
+Plugin::prediction_scheduler_statistics() const {
+  return prediction_scheduler_.statistics();
+}
+
+std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>>
+Plugin::FlowFreefall(
+    Index const central_body_index,
+    std::vector<DegreesOfFreedom<Navigation>> const& initial_degrees_of_freedom,
+    Instant const& t_initial,
+    Instant const& t_final) const {
+  CHECK(!initializing_);
+  CHECK_LE(t_initial, t_final);
+  std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>>
+      final_degrees_of_freedom(initial_degrees_of_freedom.size());
+  if (t_initial < ephemeris_->t_min()) {
+    for (auto& degrees_of_freedom : final_degrees_of_freedom) {
+      degrees_of_freedom = absl::OutOfRangeError(
+          "The initial time is before the beginning of the ephemeris");
+    }
+    return final_degrees_of_freedom;
+  }
+  if (t_final > ephemeris_->t_max() + max_freefall_prolongation) {
+    for (auto& degrees_of_freedom : final_degrees_of_freedom) {
+      degrees_of_freedom = absl::OutOfRangeError(
+          "The final time is too far beyond the end of the ephemeris");
+    }
+    return final_degrees_of_freedom;
+  }
+
+  // Prolong the ephemeris beforehand, so that the integrations share the
+  // evaluation of the trajectories of the celestials instead of contending to
+  // prolong them.  The check above bounds this prolongation.
+  ephemeris_->Prolong(t_final).IgnoreError();
+  auto const body_centred_inertial =
+      NewBodyCentredNonRotatingNavigationFrame(central_body_index);
+  auto const adaptive_step_parameters = DefaultPredictionParameters();
+
+  // The changes of frame happen on this thread, each integration only touches
+  // its own trajectory.
+  std::vector<DiscreteTrajectory<Barycentric>> trajectories(
+      initial_degrees_of_freedom.size());
+  std::vector<std::future<absl::Status>> integrations;
+  for (int i = 0; i < initial_degrees_of_freedom.size(); ++i) {
+    auto& trajectory = trajectories[i];
+    CHECK_OK(trajectory.Append(
+        t_initial,
+        body_centred_inertial->FromThisFrameAtTime(t_initial)(
+            initial_degrees_of_freedom[i])));
+    integrations.push_back(vessel_thread_pool_.Add(
+        [this, &adaptive_step_parameters, t_final, &trajectory]() {
+          return ephemeris_->FlowWithAdaptiveStep(
+              &trajectory,
+              Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+              t_final,
+              adaptive_step_parameters,
+              Ephemeris<Barycentric>::unlimited_max_ephemeris_steps);
+        }));
+  }
+
+  auto const to_body_centred_inertial =
+      body_centred_inertial->ToThisFrameAtTime(t_final);
+  for (int i = 0; i < integrations.size(); ++i) {
+    absl::Status const status = integrations[i].get();
+    if (status.ok()) {
+      final_degrees_of_freedom[i] = to_body_centred_inertial(
+          trajectories[i].back().degrees_of_freedom);
+    } else {
+      final_degrees_of_freedom[i] = status;
+    }
+  }
+  return final_degrees_of_freedom;
+}
+
+PlannedCoastCache& Plugin::planned_coast_cache() const {
+  return planned_coast_cache_;
+}
+
 void Plugin::CreateFlightPlan(GUID const& vessel_guid,
                               Instant const& final_time,
                               Mass const& initial_mass) const {
@@ -1379,6 +1506,10 @@ GeometricPotentialPlotter const& Plugin::geometric_potential_plotter() const {
   return *geometric_potential_plotter_;
 }
 
+void Plugin::SetParallelSerialization(bool const parallel) {
+  parallel_serialization_ = parallel;
+}
+
 void Plugin::WriteToMessage(
     not_null<serialization::Plugin*> const message) const {
   LOG(INFO) << __FUNCTION__;
@@ -1414,13 +1545,41 @@ void Plugin::WriteToMessage(
         return serialization_index_to_pile_up.at(pile_up);
       };
 
+  // The vessels, the ephemeris and the pile-ups are independent and are
+  // serialized in parallel.  The submessages are created on this thread, in the
+  // same order as a sequential serialization, and each task only writes to its
+  // own submessage.
+  std::vector<std::future<absl::Status>> serializations;
+  auto const serialize = [this](std::function<absl::Status()> task) {
+    if (parallel_serialization_) {
+      return vessel_thread_pool_.Add(std::move(task));
+    } else {
+      std::promise<absl::Status> promise;
+      promise.set_value(task());
+      return promise.get_future();
+    }
+  };
+
+  // Deserializing a trajectory prolongs the ephemeris, which must not happen
+  // while it is being serialized.  Do it now for the trajectories that must be
+  // deserialized; the others are written as they were read.
+  for (auto const& [_, vessel] : vessels_) {
+    vessel->PrepareForSerialization();
+  }
+
   std::map<not_null<Vessel const*>, GUID const> vessel_to_guid;
   for (auto const& [guid, vessel] : vessels_) {
     vessel_to_guid.emplace(vessel.get(), guid);
     auto* const vessel_message = message->add_vessel();
     vessel_message->set_guid(guid);
-    vessel->WriteToMessage(vessel_message->mutable_vessel(),
-                           serialization_index_for_pile_up);
+    serializations.push_back(serialize(
+        [&serialization_index_for_pile_up,
+         vessel = vessel.get(),
+         serialized_vessel = vessel_message->mutable_vessel()]() {
+          vessel->WriteToMessage(serialized_vessel,
+                                 serialization_index_for_pile_up);
+          return absl::OkStatus();
+        }));
     Index const parent_index = FindOrDie(celestial_to_index, vessel->parent());
     vessel_message->set_parent_index(parent_index);
     vessel_message->set_loaded(Contains(loaded_vessels_, vessel.get()));
@@ -1436,7 +1595,11 @@ void Plugin::WriteToMessage(
     parameters.WriteToMessage(zombie_message->mutable_prediction_parameters());
   }
 
-  ephemeris_->WriteToMessage(message->mutable_ephemeris());
+  serializations.push_back(serialize(
+      [this, serialized_ephemeris = message->mutable_ephemeris()]() {
+        ephemeris_->WriteToMessage(serialized_ephemeris);
+        return absl::OkStatus();
+      }));
 
   // |history_downsampling_parameters_| is not persisted.
   history_fixed_step_parameters_.WriteToMessage(
@@ -1452,7 +1615,15 @@ void Plugin::WriteToMessage(
   renderer_->WriteToMessage(message->mutable_renderer());
 
   for (auto* const pile_up : pile_ups_) {
-    pile_up->WriteToMessage(message->add_pile_up());
+    serializations.push_back(serialize(
+        [pile_up, serialized_pile_up = message->add_pile_up()]() {
+          pile_up->WriteToMessage(serialized_pile_up);
+          return absl::OkStatus();
+        }));
+  }
+
+  for (auto& serialization : serializations) {
+    CHECK_OK(serialization.get());
   }
 }
 
@@ -1523,6 +1694,8 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
             PartId const part_id) {
           CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
         });
+    vessel->SetPredictionScheduler(&plugin->prediction_scheduler_);
+    vessel->SetGraveyard(&plugin->graveyard_);
 
     if (vessel_message.loaded()) {
       plugin->loaded_vessels_.insert(vessel.get());
@@ -1606,6 +1779,14 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
                                              pile_up_for_serialization_index);
   }
 
+  // The trajectories of the vessels are deserialized lazily.  Get a head start
+  // on the ones that will be needed first, i.e., those of the loaded vessels.
+  // The others are deserialized when first accessed, so that they don't queue
+  // up ahead of the tasks of the first frames on the vessel thread pool.
+  for (not_null<Vessel*> const vessel : plugin->loaded_vessels_) {
+    vessel->RequestTrajectoryDeserialization(plugin->vessel_thread_pool_);
+  }
+
   plugin->initializing_.Flop();
   return plugin;
 }
@@ -1614,11 +1795,14 @@ Plugin::Plugin(
     Ephemeris<Barycentric>::FixedStepParameters history_parameters,
     Ephemeris<Barycentric>::AdaptiveStepParameters
         psychohistory_parameters)
-    : history_downsampling_parameters_(DefaultDownsamplingParameters()),
+    : graveyard_(/*number_of_threads=*/1, max_graveyard_backlog),
+      prediction_scheduler_(/*number_of_workers=*/std::max(
+          2, static_cast<int>(HardwareConcurrency()) / 2)),
+      planned_coast_cache_(max_planned_coasts),
+      history_downsampling_parameters_(DefaultDownsamplingParameters()),
       history_fixed_step_parameters_(std::move(history_parameters)),
       psychohistory_parameters_(std::move(psychohistory_parameters)),
-      vessel_thread_pool_(
-          /*pool_size=*/2 * std::thread::hardware_concurrency()) {}
+      vessel_thread_pool_(/*pool_size=*/2 * HardwareConcurrency()) {}
 
 void Plugin::InitializeIndices(std::string const& name,
                                Index const celestial_index,
@@ -1720,6 +1904,17 @@ bool Plugin::is_loaded(not_null<Vessel*> vessel) const {
   return Contains(loaded_vessels_, vessel);
 }
 
+LockStepHistories* Plugin::lock_step_histories() {
+  if (!Flags::IsPresent("lock_step_histories")) {
+    return nullptr;
+  }
+  if (lock_step_histories_ == nullptr) {
+    lock_step_histories_ = std::make_unique<LockStepHistories>(
+        ephemeris_.get(), history_fixed_step_parameters_);
+  }
+  return lock_step_histories_.get();
+}
+
 }  // namespace internal
 }  // namespace _plugin
 }  // namespace ksp_plugin
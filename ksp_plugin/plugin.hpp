@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "base/graveyard.hpp"
 #include "base/monostable.hpp"
 #include "base/thread_pool.hpp"
 #include "geometry/affine_map.hpp"
@@ -23,8 +25,11 @@
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/geometric_potential_plotter.hpp"
+#include "ksp_plugin/lock_step_histories.hpp"
 #include "ksp_plugin/manœuvre.hpp"
 #include "ksp_plugin/planetarium.hpp"
+#include "ksp_plugin/planned_coast_cache.hpp"
+#include "ksp_plugin/prediction_scheduler.hpp"
 #include "ksp_plugin/renderer.hpp"
 #include "ksp_plugin/vessel.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
@@ -56,6 +61,7 @@ namespace _plugin {
 namespace internal {
 
 using namespace principia::base::_disjoint_sets;
+using namespace principia::base::_graveyard;
 using namespace principia::base::_monostable;
 using namespace principia::base::_not_null;
 using namespace principia::base::_thread_pool;
@@ -72,8 +78,11 @@ using namespace principia::ksp_plugin::_celestial;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_geometric_potential_plotter;
 using namespace principia::ksp_plugin::_identification;
+using namespace principia::ksp_plugin::_lock_step_histories;
+using namespace principia::ksp_plugin::_prediction_scheduler;
 using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_planned_coast_cache;
 using namespace principia::ksp_plugin::_renderer;
 using namespace principia::ksp_plugin::_vessel;
 using namespace principia::physics::_body;
@@ -339,9 +348,34 @@ class Plugin {
       Ephemeris<Barycentric>::AdaptiveStepParameters const&
           prediction_adaptive_step_parameters) const;
 
-  // Updates the prediction for the vessels with guids in |vessel_guids|.
+  // Updates the prediction for the vessels with guids in |vessel_guids|.  The
+  // first one is the active vessel, and gets the highest priority.
   void UpdatePrediction(std::vector<GUID> const& vessel_guids) const;
 
+  // The queue depth and latencies of the computation of the predictions.
+  PredictionScheduler::Statistics prediction_scheduler_statistics() const;
+
+  // Integrates the free fall of massless bodies having the given
+  // |initial_degrees_of_freedom| at |t_initial| until |t_final|, which must not
+  // be before |t_initial|.  The degrees of freedom are in the body-centred
+  // non-rotating frame of the celestial with index |central_body_index|.  The
+  // ephemeris is prolonged once for all the bodies, which are then integrated
+  // in parallel, with the default prediction parameters.  For each body,
+  // returns its degrees of freedom at |t_final|, or an error if its integration
+  // failed, e.g., because it collided with a celestial or exceeded the maximum
+  // number of steps of a prediction.  All the bodies fail if |t_final| is too
+  // far beyond the end of the ephemeris.
+  std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>> FlowFreefall(
+      Index central_body_index,
+      std::vector<DegreesOfFreedom<Navigation>> const&
+          initial_degrees_of_freedom,
+      Instant const& t_initial,
+      Instant const& t_final) const;
+
+  // The body-centred coasts of the flight plans used by the nearest-approach
+  // queries.  The cache is thread-safe, so it may be used on a const plugin.
+  PlannedCoastCache& planned_coast_cache() const;
+
   virtual void CreateFlightPlan(GUID const& vessel_guid,
                                 Instant const& final_time,
                                 Mass const& initial_mass) const;
@@ -460,6 +494,11 @@ class Plugin {
   virtual GeometricPotentialPlotter& geometric_potential_plotter();
   virtual GeometricPotentialPlotter const& geometric_potential_plotter() const;
 
+  // If |parallel| is false, |WriteToMessage| serializes the vessels, the
+  // ephemeris and the pile-ups on the calling thread instead of on
+  // |vessel_thread_pool_|.  Serialization is parallel by default.
+  void SetParallelSerialization(bool parallel);
+
   // Must be called after initialization.
   virtual void WriteToMessage(not_null<serialization::Plugin*> message) const;
   static not_null<std::unique_ptr<Plugin>> ReadFromMessage(
@@ -510,6 +549,11 @@ class Plugin {
   // Whether |loaded_vessels_| contains |vessel|.
   bool is_loaded(not_null<Vessel*> vessel) const;
 
+  // Returns the group in which the coasting pile-ups integrate their histories
+  // if the flag |lock_step_histories| is set, null otherwise.  Must be called
+  // after initialization.
+  LockStepHistories* lock_step_histories();
+
   // Initialization objects.
   Monostable initializing_;
   serialization::GravityModel gravity_model_;
@@ -527,6 +571,20 @@ class Plugin {
   std::optional<Ephemeris<Barycentric>::FixedStepParameters>
       ephemeris_fixed_step_parameters_;
 
+  // Declared before |vessels_| because it must outlive the pile-ups.  Created
+  // lazily.
+  std::unique_ptr<LockStepHistories> lock_step_histories_;
+
+  // Destroys the large objects dropped by the vessels, and the trajectories of
+  // the vessels that are removed.  Declared before |vessels_| because it must
+  // outlive them.  Flushed when the plugin is destroyed, before the ephemeris.
+  Graveyard graveyard_;
+
+  // Declared before |vessels_| because it must outlive them.
+  mutable PredictionScheduler prediction_scheduler_;
+
+  mutable PlannedCoastCache planned_coast_cache_;
+
   GUIDToOwnedVessel vessels_;
   // For each part, the vessel that this part belongs to. The part is guaranteed
   // to be in the parts() map of the vessel, and owned by it.
@@ -542,8 +600,12 @@ class Plugin {
   Ephemeris<Barycentric>::FixedStepParameters history_fixed_step_parameters_;
   Ephemeris<Barycentric>::AdaptiveStepParameters psychohistory_parameters_;
 
-  // The thread pool for advancing vessels.
-  ThreadPool<absl::Status> vessel_thread_pool_;
+  // The thread pool for advancing vessels, for serializing them, and for
+  // deserializing their trajectories in the background after a load.  It is
+  // mutable because |WriteToMessage| uses it; its tasks only read the state of
+  // the plugin, and each writes to its own part of the message.
+  mutable ThreadPool<absl::Status> vessel_thread_pool_;
+  bool parallel_serialization_ = true;
 
   Angle planetarium_rotation_;
   std::optional<Rotation<Barycentric, AliceSun>> cached_planetarium_rotation_;
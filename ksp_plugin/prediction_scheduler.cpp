@@ -0,0 +1,186 @@
+#include "ksp_plugin/prediction_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _prediction_scheduler {
+namespace internal {
+
+PredictionScheduler::PredictionScheduler(int const number_of_workers) {
+  CHECK_LT(0, number_of_workers);
+  absl::MutexLock l(&lock_);
+  for (int worker = 0; worker < number_of_workers; ++worker) {
+    workers_.push_back(
+        MakeStoppableThread([this, worker]() { RunRequests(worker); }));
+  }
+}
+
+PredictionScheduler::~PredictionScheduler() {
+  std::vector<jthread> workers;
+  {
+    absl::MutexLock l(&lock_);
+    for (auto& worker : workers_) {
+      worker.request_stop();
+    }
+    workers.swap(workers_);
+  }
+  // The workers are joined here, without holding the lock, since they need it
+  // to observe that they were stopped.
+}
+
+void PredictionScheduler::Submit(not_null<Vessel const*> const vessel,
+                                 Priority const priority,
+                                 Task task) {
+  absl::MutexLock l(&lock_);
+  Client& client = clients_[vessel];
+  if (client.pending.has_value()) {
+    ++statistics_.latencies[static_cast<int>(client.pending->priority)]
+          .superseded;
+    if (!client.worker.has_value()) {
+      queue_.erase(MakeQueueKey(*client.pending, vessel));
+    }
+    client.pending->priority = priority;
+    client.pending->task = std::move(task);
+  } else {
+    client.pending =
+        Request{.priority = priority,
+                .sequence_number = next_sequence_number_++,
+                .submission_time = std::chrono::steady_clock::now(),
+                .task = std::move(task)};
+  }
+  // If the client is running, its request will be queued when it completes.
+  if (!client.worker.has_value()) {
+    queue_.insert(MakeQueueKey(*client.pending, vessel));
+  }
+}
+
+void PredictionScheduler::Cancel(not_null<Vessel const*> const vessel) {
+  absl::MutexLock l(&lock_);
+  auto const it = clients_.find(vessel);
+  if (it == clients_.end()) {
+    return;
+  }
+  Client& client = it->second;
+  if (client.pending.has_value()) {
+    if (!client.worker.has_value()) {
+      queue_.erase(MakeQueueKey(*client.pending, vessel));
+    }
+    client.pending.reset();
+  }
+  if (client.worker.has_value()) {
+    int const worker = *client.worker;
+    workers_[worker].request_stop();
+    auto const completed = [&client]() { return !client.worker.has_value(); };
+    lock_.Await(absl::Condition(&completed));
+    // The stopped worker exits without taking the lock again, so it may be
+    // joined (by the assignment) while holding the lock.
+    workers_[worker] =
+        MakeStoppableThread([this, worker]() { RunRequests(worker); });
+    // A request may have been submitted while we were waiting.
+    if (client.pending.has_value()) {
+      queue_.erase(MakeQueueKey(*client.pending, vessel));
+    }
+  }
+  clients_.erase(it);
+}
+
+PredictionScheduler::Statistics PredictionScheduler::statistics() const {
+  absl::ReaderMutexLock l(&lock_);
+  Statistics statistics = statistics_;
+  statistics.queue_depth = std::count_if(
+      clients_.begin(), clients_.end(), [](auto const& pair) {
+        return pair.second.pending.has_value();
+      });
+  return statistics;
+}
+
+PredictionScheduler::QueueKey PredictionScheduler::MakeQueueKey(
+    Request const& request,
+    not_null<Vessel const*> const vessel) {
+  return {request.priority, request.sequence_number, vessel};
+}
+
+void PredictionScheduler::RunRequests(int const worker) {
+  // The condition may be evaluated on another thread, so it must not call
+  // |this_stoppable_thread::get_stop_token|.
+  stop_token const stop_token = this_stoppable_thread::get_stop_token();
+  for (;;) {
+    Vessel const* vessel;
+    Request request;
+
+    // Wait until either there is a pending request or this worker is stopped.
+    {
+      absl::MutexLock l(&lock_);
+      auto const has_requests_or_stopped = [this, &stop_token]() {
+        return stop_token.stop_requested() || !queue_.empty();
+      };
+      lock_.Await(absl::Condition(&has_requests_or_stopped));
+      if (stop_token.stop_requested()) {
+        return;
+      }
+      vessel = std::get<Vessel const*>(*queue_.begin());
+      queue_.erase(queue_.begin());
+      Client& client = clients_.at(vessel);
+      request = std::move(*client.pending);
+      client.pending.reset();
+      client.worker = worker;
+    }
+
+    // Run the request without holding the |lock_| as it might take some time.
+    // If the worker is stopped, the request fails with a status that it is
+    // expected to ignore.
+    request.task();
+
+    {
+      absl::MutexLock l(&lock_);
+      auto const latency =
+          std::chrono::steady_clock::now() - request.submission_time;
+      auto& latencies =
+          statistics_.latencies[static_cast<int>(request.priority)];
+      ++latencies.completed;
+      latencies.total_latency += latency;
+      latencies.max_latency = std::max(latencies.max_latency, latency);
+
+      Client& client = clients_.at(vessel);
+      client.worker.reset();
+      if (client.pending.has_value()) {
+        queue_.insert(MakeQueueKey(*client.pending, vessel));
+      }
+      if (stop_token.stop_requested()) {
+        return;
+      }
+    }
+  }
+}
+
+std::ostream& operator<<(std::ostream& out,
+                         PredictionScheduler::Statistics const& statistics) {
+  static constexpr char const* priority_names[] = {
+      "active vessel", "target", "flight plan", "visible"};
+  out << "queue depth: " << statistics.queue_depth;
+  for (int i = 0; i < PredictionScheduler::number_of_priorities; ++i) {
+    auto const& latencies = statistics.latencies[i];
+    auto const milliseconds =
+        [](std::chrono::steady_clock::duration const duration) {
+          return std::chrono::duration<double, std::milli>(duration).count();
+        };
+    out << "\n" << priority_names[i] << ": " << latencies.completed
+        << " completed, " << latencies.superseded << " superseded";
+    if (latencies.completed > 0) {
+      out << ", mean latency "
+          << milliseconds(latencies.total_latency) / latencies.completed
+          << " ms, max latency " << milliseconds(latencies.max_latency)
+          << " ms";
+    }
+  }
+  return out;
+}
+
+}  // namespace internal
+}  // namespace _prediction_scheduler
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "base/jthread.hpp"
+#include "base/macros.hpp"
+#include "base/not_null.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+
+FORWARD_DECLARE_FROM(vessel, class, Vessel);
+
+namespace _prediction_scheduler {
+namespace internal {
+
+using namespace principia::base::_jthread;
+using namespace principia::base::_not_null;
+using namespace principia::ksp_plugin::_vessel;
+
+// A plugin-wide scheduler for the computation of the predictions of the
+// vessels, which runs them on a fixed number of worker threads instead of on a
+// thread per vessel.  Each vessel has at most one pending request: a request
+// supersedes the one previously submitted by the same vessel if that one hasn't
+// started yet.  The pending requests are run by priority, and in order of
+// submission for a given priority.  The requests of a vessel never run
+// concurrently.  This class is thread-safe.
+class PredictionScheduler {
+ public:
+  // The requests with a lower priority run first.
+  enum class Priority {
+    ActiveVessel = 0,
+    Target = 1,
+    FlightPlan = 2,
+    Visible = 3,
+  };
+  static constexpr int number_of_priorities = 4;
+
+  struct LatencyStatistics {
+    // The number of requests that completed.
+    std::int64_t completed = 0;
+    // The number of requests that were superseded before they started.
+    std::int64_t superseded = 0;
+    // The time between the submission of a request (or of the first request
+    // that it superseded) and its completion.
+    std::chrono::steady_clock::duration total_latency{};
+    std::chrono::steady_clock::duration max_latency{};
+  };
+
+  struct Statistics {
+    // The number of pending requests.
+    int queue_depth = 0;
+    // Indexed by |Priority|.
+    std::array<LatencyStatistics, number_of_priorities> latencies;
+  };
+
+  using Task = std::function<void()>;
+
+  // Constructs a scheduler with the given number of worker threads.
+  explicit PredictionScheduler(int number_of_workers);
+
+  // Stops the running requests and waits for them to complete.  The pending
+  // requests are dropped.
+  ~PredictionScheduler();
+
+  // Submits a request to run |task| on behalf of |vessel|.  If |vessel| has a
+  // pending request, it is superseded by this one, which takes its place in the
+  // order of submission.
+  void Submit(not_null<Vessel const*> vessel, Priority priority, Task task);
+
+  // Drops the pending request of |vessel|, if any.  If a request of |vessel| is
+  // running, it is stopped and this function waits for it to complete.
+  void Cancel(not_null<Vessel const*> vessel);
+
+  Statistics statistics() const;
+
+ private:
+  struct Request {
+    Priority priority;
+    std::int64_t sequence_number;
+    std::chrono::steady_clock::time_point submission_time;
+    Task task;
+  };
+
+  struct Client {
+    std::optional<Request> pending;
+    // The index of the worker that runs a request of this client, if any.
+    std::optional<int> worker;
+  };
+
+  // The key of a pending request in |queue_|.
+  using QueueKey = std::tuple<Priority, std::int64_t, Vessel const*>;
+
+  static QueueKey MakeQueueKey(Request const& request,
+                               not_null<Vessel const*> vessel);
+
+  // The loop executed by the worker with the given index, until its stop token
+  // is stopped.
+  void RunRequests(int worker);
+
+  mutable absl::Mutex lock_;
+  std::int64_t next_sequence_number_ GUARDED_BY(lock_) = 0;
+  std::map<not_null<Vessel const*>, Client> clients_ GUARDED_BY(lock_);
+  // The requests that are pending and whose client is not running.
+  std::set<QueueKey> queue_ GUARDED_BY(lock_);
+  Statistics statistics_ GUARDED_BY(lock_);
+
+  // A worker whose request is cancelled is stopped, and replaced by a new one.
+  std::vector<jthread> workers_ GUARDED_BY(lock_);
+};
+
+std::ostream& operator<<(
+    std::ostream& out,
+    PredictionScheduler::Statistics const& statistics);
+
+}  // namespace internal
+
+using internal::PredictionScheduler;
+
+}  // namespace _prediction_scheduler
+}  // namespace ksp_plugin
+}  // namespace principia
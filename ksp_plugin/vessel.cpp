@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <set>
@@ -38,19 +39,48 @@ using namespace std::chrono_literals;
 
 // TODO(phl): Move this to some kind of parameters.
 constexpr std::int64_t max_points_to_serialize = 20'000;
+// The number of points that |AdvanceTime| may record for a |history_| that
+// hasn't been deserialized yet before it forces the deserialization.
+constexpr std::int64_t max_backstory_points_before_deserialization = 1'000;
+
+bool SameAdaptiveStepParameters(
+    Ephemeris<Barycentric>::AdaptiveStepParameters const& left,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const& right) {
+  return &left.integrator() == &right.integrator() &&
+         left.max_steps() == right.max_steps() &&
+         left.length_integration_tolerance() ==
+             right.length_integration_tolerance() &&
+         left.speed_integration_tolerance() ==
+             right.speed_integration_tolerance();
+}
+
+// Returns the time after which points may be appended to |segment|, see the
+// comments in |Vessel::AdvanceTime|.
+Instant LastTime(DiscreteTrajectorySegment<Barycentric> const& segment) {
+  return segment.empty() ? InfinitePast : segment.back().time;
+}
+
+// Returns the last point of the segment at |position| in |message|, which must
+// not be empty.  The extremities of the segments are always exact.
+DiscreteTrajectory<Barycentric>::value_type LastPointOfSegment(
+    serialization::DiscreteTrajectory const& message,
+    int const position) {
+  CHECK_NE(serialization::DiscreteTrajectory::MISSING_TRACKED_POSITION,
+           position);
+  auto const& segment = message.segment(position);
+  CHECK_LT(0, segment.exact_size());
+  auto const& last = segment.exact(segment.exact_size() - 1);
+  return {Instant::ReadFromMessage(last.instant()),
+          DegreesOfFreedom<Barycentric>::ReadFromMessage(
+              last.degrees_of_freedom())};
+}
 
 bool operator!=(Vessel::PrognosticatorParameters const& left,
                 Vessel::PrognosticatorParameters const& right) {
   return left.first_time != right.first_time ||
          left.first_degrees_of_freedom != right.first_degrees_of_freedom ||
-         &left.adaptive_step_parameters.integrator() !=
-             &right.adaptive_step_parameters.integrator() ||
-         left.adaptive_step_parameters.max_steps() !=
-             right.adaptive_step_parameters.max_steps() ||
-         left.adaptive_step_parameters.length_integration_tolerance() !=
-             right.adaptive_step_parameters.length_integration_tolerance() ||
-         left.adaptive_step_parameters.speed_integration_tolerance() !=
-             right.adaptive_step_parameters.speed_integration_tolerance();
+         !SameAdaptiveStepParameters(left.adaptive_step_parameters,
+                                     right.adaptive_step_parameters);
 }
 
 Vessel::Vessel(
@@ -78,22 +108,27 @@ Vessel::Vessel(
             return Reanimate(desired_t_min);
           },
           20ms),  // 50 Hz.
-      reanimator_clientele_(/*default_value=*/InfiniteFuture),
-      backstory_(trajectory_.segments().begin()),
-      psychohistory_(trajectory_.segments().end()),
-      prediction_(trajectory_.segments().end()),
-      prognosticator_(
-          [this](PrognosticatorParameters const& parameters) {
-            return FlowPrognostication(parameters);
-          },
-          20ms)  // 50 Hz.
-{}
+      reanimator_clientele_(/*default_value=*/InfiniteFuture) {}
 
 Vessel::~Vessel() {
   LOG(INFO) << "Destroying vessel " << ShortDebugString();
+  // Make sure that a pending deserialization doesn't touch this object.  This
+  // waits for the deserialization if it is running.
+  if (pending_deserialization_ != nullptr) {
+    absl::MutexLock l(&pending_deserialization_->lock);
+    pending_deserialization_->vessel = nullptr;
+  }
   // Ask the prognosticator to shut down.  This may take a while.
   StopPrognosticator();
   reanimator_.Stop();
+  // The parts are destroyed with this object, because their destruction has
+  // side effects on the pile-ups.  The trajectory and the flight plans are
+  // self-contained and may be destroyed asynchronously.  There is no point in
+  // deserializing the |history_| just to destroy it.
+  Bury(std::move(history_.trajectory));
+  for (auto& flight_plan : flight_plans_) {
+    Bury(std::move(flight_plan));
+  }
 }
 
 GUID const& Vessel::guid() const {
@@ -184,13 +219,16 @@ void Vessel::DetectCollapsibilityChange() {
   // is long enough to have been downsampled.  If downsampling is disabled,
   // surely this is not going to happen so no point in waiting for Godot.
   bool const collapsibility_changes = is_collapsible_ != will_be_collapsible;
-  bool const becomes_non_collapsible = collapsibility_changes &&
-                                       !will_be_collapsible;
+  if (!collapsibility_changes) {
+    // The common case, which must not deserialize the |history_|.
+    return;
+  }
+  History& history = this->history();
+  bool const becomes_non_collapsible = !will_be_collapsible;
   bool const awaits_first_downsampling = downsampling_parameters_.has_value() &&
-                                         !backstory_->was_downsampled();
+                                         !history.backstory->was_downsampled();
 
-  if (collapsibility_changes &&
-      (becomes_non_collapsible || !awaits_first_downsampling)) {
+  if (becomes_non_collapsible || !awaits_first_downsampling) {
     // If collapsibility changes, we create a new history segment.  This ensures
     // that downsampling does not change collapsibility boundaries.
 
@@ -207,7 +245,7 @@ void Vessel::DetectCollapsibilityChange() {
       // to reconstruct it, so we must serialize it in a checkpoint.  Note that
       // the last point of the backstory specifies the initial conditions of the
       // next (collapsible) segment.
-      Instant const checkpoint = backstory_->back().time;
+      Instant const checkpoint = history.backstory->back().time;
 
       // In some cornercases we might try to create multiple checkpoints at the
       // same time, see #3280.  The checkpointer doesn't support that.
@@ -241,24 +279,26 @@ void Vessel::DetectCollapsibilityChange() {
       }
     }
 
-    auto psychohistory = trajectory_.DetachSegments(psychohistory_);
+    auto psychohistory =
+        history.trajectory.DetachSegments(history.psychohistory);
     switch (segment_action) {
       case Create: {
-        backstory_ = trajectory_.NewSegment();
+        history.backstory = history.trajectory.NewSegment();
         if (downsampling_parameters_.has_value()) {
-          backstory_->SetDownsampling(downsampling_parameters_.value());
+          history.backstory->SetDownsampling(downsampling_parameters_.value());
         }
         break;
       }
       case Delete: {
         // Let's hope that no-one has kept an iterator to the deleted backstory.
-        trajectory_.DeleteSegments(backstory_);
-        CHECK(!trajectory_.segments().empty());
-        backstory_ = std::prev(trajectory_.segments().end());
+        history.trajectory.DeleteSegments(history.backstory);
+        CHECK(!history.trajectory.segments().empty());
+        history.backstory = std::prev(history.trajectory.segments().end());
         break;
       }
     };
-    psychohistory_ = trajectory_.AttachSegments(std::move(psychohistory));
+    history.psychohistory =
+        history.trajectory.AttachSegments(std::move(psychohistory));
 
     // Not updated if we chose to append to the current segment.
     is_collapsible_ = will_be_collapsible;
@@ -267,7 +307,12 @@ void Vessel::DetectCollapsibilityChange() {
 
 void Vessel::CreateTrajectoryIfNeeded(Instant const& t) {
   CHECK(!parts_.empty());
-  if (trajectory_.empty()) {
+  // A serialized trajectory is never empty.
+  if (WithSerializedHistory([](SerializedHistory&) {})) {
+    return;
+  }
+  History& history = this->history();
+  if (history.trajectory.empty()) {
     LOG(INFO) << "Preparing history of vessel " << ShortDebugString()
               << " at " << t;
     BarycentreCalculator<DegreesOfFreedom<Barycentric>, Mass> calculator;
@@ -276,18 +321,18 @@ void Vessel::CreateTrajectoryIfNeeded(Instant const& t) {
           part.rigid_motion()({RigidPart::origin, RigidPart::unmoving}),
           part.mass());
     });
-    CHECK(psychohistory_ == trajectory_.segments().end());
+    CHECK(history.psychohistory == history.trajectory.segments().end());
     if (downsampling_parameters_.has_value()) {
-      backstory_->SetDownsampling(downsampling_parameters_.value());
+      history.backstory->SetDownsampling(downsampling_parameters_.value());
     }
-    trajectory_.Append(t, calculator.Get()).IgnoreError();
-    psychohistory_ = trajectory_.NewSegment();
-    prediction_ = trajectory_.NewSegment();
+    history.trajectory.Append(t, calculator.Get()).IgnoreError();
+    history.psychohistory = history.trajectory.NewSegment();
+    history.prediction = history.trajectory.NewSegment();
   }
 }
 
 void Vessel::DisableDownsampling() {
-  backstory_->ClearDownsampling();
+  history().backstory->ClearDownsampling();
   // From now on, no downsampling will happen.
   downsampling_parameters_ = std::nullopt;
 }
@@ -308,15 +353,27 @@ void Vessel::ForAllParts(std::function<void(Part&)> action) const {
 }
 
 DiscreteTrajectory<Barycentric> const& Vessel::trajectory() const {
-  return trajectory_;
+  return history().trajectory;
 }
 
 DiscreteTrajectorySegmentIterator<Barycentric> Vessel::psychohistory() const {
-  return psychohistory_;
+  return history().psychohistory;
 }
 
 DiscreteTrajectorySegmentIterator<Barycentric> Vessel::prediction() const {
-  return prediction_;
+  return history().prediction;
+}
+
+DiscreteTrajectory<Barycentric>::value_type
+Vessel::last_psychohistory_point() const {
+  std::optional<DiscreteTrajectory<Barycentric>::value_type> result;
+  if (WithSerializedHistory(
+          [&result](SerializedHistory& serialized_history) {
+            result = serialized_history.psychohistory_back;
+          })) {
+    return *result;
+  }
+  return history().psychohistory->back();
 }
 
 void Vessel::set_prediction_adaptive_step_parameters(
@@ -362,24 +419,68 @@ void Vessel::ReadFlightPlanFromMessage() {
     auto const& message =
         std::get<serialization::FlightPlan>(selected_flight_plan());
     selected_flight_plan() = FlightPlan::ReadFromMessage(message, ephemeris_);
+    flight_plan().SetGraveyard(graveyard_);
   }
 }
 
 void Vessel::AdvanceTime() {
+  // If the |history_| hasn't been deserialized yet, record the new points to
+  // append them when it is.  There is no prognostication to attach, as it would
+  // have been requested by |RefreshPrediction|, which deserializes the
+  // |history_|.  The recorded points are not downsampled, so once there are too
+  // many of them the |history_| is deserialized.
+  bool must_deserialize = false;
+  if (WithSerializedHistory([this, &must_deserialize](
+                                SerializedHistory& serialized_history) {
+        auto& backstory_points = serialized_history.backstory_points;
+        for (auto const& point :
+             PartsBarycentres(&Part::history_begin,
+                              &Part::history_end,
+                              serialized_history.backstory_back.time)) {
+          backstory_points.push_back(point);
+        }
+        if (!backstory_points.empty()) {
+          serialized_history.backstory_back = backstory_points.back();
+        }
+        serialized_history.psychohistory_points =
+            PartsBarycentres(&Part::psychohistory_begin,
+                             &Part::psychohistory_end,
+                             serialized_history.backstory_back.time);
+        serialized_history.psychohistory_back =
+            serialized_history.psychohistory_points.empty()
+                ? serialized_history.backstory_back
+                : serialized_history.psychohistory_points.back();
+        must_deserialize = static_cast<std::int64_t>(backstory_points.size()) >
+                           max_backstory_points_before_deserialization;
+      })) {
+    coasting_along_prediction_ = false;
+    for (auto const& [_, part] : parts_) {
+      part->ClearHistory();
+    }
+    if (must_deserialize) {
+      DeserializeHistoryIfNeeded();
+    }
+    return;
+  }
+
+  History& history = this->history();
   // Squirrel away the prediction so that we can reattach it if we don't have a
   // prognostication.
-  auto prediction = trajectory_.DetachSegments(prediction_);
-  prediction_ = trajectory_.segments().end();
+  auto prediction = history.trajectory.DetachSegments(history.prediction);
+  history.prediction = history.trajectory.segments().end();
 
   // Read the wall of text below and realize that this can happen for the
   // history as well as the psychohistory, if the history of the part was
   // obtained using an adaptive step integrator, which is the case during a
   // burn.  See #2931.
-  trajectory_.DeleteSegments(psychohistory_);
-  AppendToVesselTrajectory(&Part::history_begin,
-                           &Part::history_end,
-                           *backstory_);
-  psychohistory_ = trajectory_.NewSegment();
+  history.trajectory.DeleteSegments(history.psychohistory);
+  for (auto const& [time, degrees_of_freedom] :
+       PartsBarycentres(&Part::history_begin,
+                        &Part::history_end,
+                        LastTime(*history.backstory))) {
+    history.trajectory.Append(time, degrees_of_freedom).IgnoreError();
+  }
+  history.psychohistory = history.trajectory.NewSegment();
 
   // The reason why we may want to skip the start of the psychohistory is
   // subtle.  Say that we have a vessel A with points at t₀, t₀ + 10 s,
@@ -393,18 +494,34 @@ void Vessel::AdvanceTime() {
   // multiple points, say one at t₀ + 21 s and one at t₀ + 24 s.  In this case
   // trying to insert the point at t₀ + 21 s would put us before the last point
   // of the history of B and would fail a check.  Therefore, we just ignore that
-  // point.  See #2507 and the |last_time| in AppendToVesselTrajectory.
-  AppendToVesselTrajectory(&Part::psychohistory_begin,
-                           &Part::psychohistory_end,
-                           *psychohistory_);
-
-  // Attach the prognostication, if there is one.  Otherwise fall back to the
-  // pre-existing prediction.
-  auto optional_prognostication = prognosticator_.Get();
-  if (optional_prognostication.has_value()) {
-    AttachPrediction(std::move(optional_prognostication.value()));
+  // point.  See #2507 and the |last_time| in PartsBarycentres.
+  for (auto const& [time, degrees_of_freedom] :
+       PartsBarycentres(&Part::psychohistory_begin,
+                        &Part::psychohistory_end,
+                        LastTime(*history.psychohistory))) {
+    history.trajectory.Append(time, degrees_of_freedom).IgnoreError();
+  }
+
+  // Attach the prognostication, if there is one and it is not an extension.
+  // Otherwise fall back to the pre-existing prediction, and extend it if
+  // possible.  In both cases, find out if the vessel coasted along the
+  // trajectory that becomes the prediction, before the latter is truncated to
+  // start at the end of the psychohistory.
+  auto optional_prognostication = TakePrognostication();
+  if (optional_prognostication.has_value() &&
+      !optional_prognostication->is_extension) {
+    coasting_along_prediction_ = PsychohistoryLiesOn(
+        optional_prognostication->trajectory,
+        optional_prognostication->adaptive_step_parameters);
+    AttachPrognostication(std::move(optional_prognostication).value());
+    Bury(std::move(prediction));
   } else {
-    AttachPrediction(std::move(prediction));
+    coasting_along_prediction_ =
+        PsychohistoryLiesOn(prediction, prediction_parameters_);
+    AttachPrediction(std::move(prediction), history);
+    if (optional_prognostication.has_value()) {
+      AttachPrognostication(std::move(optional_prognostication).value());
+    }
   }
 
   for (auto const& [_, part] : parts_) {
@@ -413,6 +530,8 @@ void Vessel::AdvanceTime() {
 }
 
 void Vessel::RequestReanimation(Instant const& desired_t_min) {
+  // The reanimator needs the deserialized |history_|.
+  history();
   reanimator_.Start();
 
   // No locking here because vessel reanimation is only invoked from the main
@@ -470,7 +589,7 @@ void Vessel::CreateFlightPlan(
         flight_plan_adaptive_step_parameters,
     Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
         flight_plan_generalized_adaptive_step_parameters) {
-  auto const flight_plan_start = backstory_->back();
+  auto const flight_plan_start = history().backstory->back();
   flight_plans_.emplace_back(make_not_null_unique<FlightPlan>(
       initial_mass,
       /*initial_time=*/flight_plan_start.time,
@@ -480,6 +599,7 @@ void Vessel::CreateFlightPlan(
       flight_plan_adaptive_step_parameters,
       flight_plan_generalized_adaptive_step_parameters));
   selected_flight_plan_index_ = flight_plans_.size() - 1;
+  flight_plan().SetGraveyard(graveyard_);
 }
 
 void Vessel::DuplicateFlightPlan() {
@@ -506,6 +626,7 @@ void Vessel::DuplicateFlightPlan() {
 }
 
 void Vessel::DeleteFlightPlan() {
+  Bury(std::move(selected_flight_plan()));
   flight_plans_.erase(flight_plans_.begin() + selected_flight_plan_index_);
   if (selected_flight_plan_index_ == flight_plans_.size()) {
     --selected_flight_plan_index_;
@@ -516,7 +637,8 @@ absl::Status Vessel::RebaseFlightPlan(Mass const& initial_mass) {
   CHECK(has_deserialized_flight_plan());
   auto& flight_plan =
       std::get<not_null<std::unique_ptr<FlightPlan>>>(selected_flight_plan());
-  Instant const new_initial_time = backstory_->back().time;
+  auto const [new_initial_time, new_initial_degrees_of_freedom] =
+      history().backstory->back();
   int first_manœuvre_kept = 0;
   for (int i = 0; i < flight_plan->number_of_manœuvres(); ++i) {
     auto const& manœuvre = flight_plan->GetManœuvre(i);
@@ -528,7 +650,7 @@ absl::Status Vessel::RebaseFlightPlan(Mass const& initial_mass) {
       }
     }
   }
-  not_null<std::unique_ptr<FlightPlan>> const original_flight_plan =
+  not_null<std::unique_ptr<FlightPlan>> original_flight_plan =
       std::move(flight_plan);
   Instant const new_desired_final_time =
       new_initial_time >= original_flight_plan->desired_final_time()
@@ -538,7 +660,7 @@ absl::Status Vessel::RebaseFlightPlan(Mass const& initial_mass) {
   flight_plan = make_not_null_unique<FlightPlan>(
       initial_mass,
       /*initial_time=*/new_initial_time,
-      /*initial_degrees_of_freedom=*/backstory_->back().degrees_of_freedom,
+      /*initial_degrees_of_freedom=*/new_initial_degrees_of_freedom,
       new_desired_final_time,
       ephemeris_,
       original_flight_plan->adaptive_step_parameters(),
@@ -549,44 +671,117 @@ absl::Status Vessel::RebaseFlightPlan(Mass const& initial_mass) {
     auto const& manœuvre = original_flight_plan->GetManœuvre(i);
     flight_plan->Insert(manœuvre.burn(), i - first_manœuvre_kept).IgnoreError();
   }
+  flight_plan->SetGraveyard(graveyard_);
+  Bury(std::move(original_flight_plan));
   return absl::OkStatus();
 }
 
 void Vessel::RefreshPrediction() {
+  History const& history = this->history();
   // The |prognostication| is a trajectory which is computed asynchronously and
-  // may be used as a prediction;
-  std::optional<DiscreteTrajectory<Barycentric>> prognostication;
+  // may be used as a prediction or as an extension of the prediction.
+  std::optional<Prognostication> prognostication;
 
   // Note that we know that |RefreshPrediction| is called on the main thread,
   // therefore the ephemeris currently covers the last time of the
   // psychohistory.  Were this to change, this code might have to change.
   PrognosticatorParameters prognosticator_parameters{
-      psychohistory_->back().time,
-      psychohistory_->back().degrees_of_freedom,
+      history.psychohistory->back().time,
+      history.psychohistory->back().degrees_of_freedom,
       prediction_adaptive_step_parameters_};
-  if (synchronous_) {
+
+  // If the vessel coasted along a prediction computed with the current
+  // parameters, the points of the prediction are still valid, and we only need
+  // to extend it at the far end, with the steps that are left in the budget of
+  // the prediction.
+  bool const is_extension =
+      coasting_along_prediction_ &&
+      history.prediction != history.trajectory.segments().end() &&
+      !history.prediction->empty() &&
+      prediction_parameters_.has_value() &&
+      SameAdaptiveStepParameters(*prediction_parameters_,
+                                 prediction_adaptive_step_parameters_);
+  if (is_extension) {
+    std::int64_t const remaining_steps =
+        prediction_adaptive_step_parameters_.max_steps() -
+        (history.prediction->size() - 1);
+    if (remaining_steps <= 0) {
+      return;
+    }
+    prognosticator_parameters.first_time = history.prediction->back().time;
+    prognosticator_parameters.first_degrees_of_freedom =
+        history.prediction->back().degrees_of_freedom;
+    prognosticator_parameters.adaptive_step_parameters.set_max_steps(
+        remaining_steps);
+  }
+
+  if (synchronous_ || prediction_scheduler_ == nullptr) {
     auto status_or_prognostication =
-        FlowPrognostication(std::move(prognosticator_parameters));
+        FlowPrognostication(prognosticator_parameters);
     if (status_or_prognostication.ok()) {
-      prognostication = std::move(status_or_prognostication).value();
+      prognostication = Prognostication{
+          .trajectory = std::move(status_or_prognostication).value(),
+          .adaptive_step_parameters = prediction_adaptive_step_parameters_,
+          .is_extension = is_extension};
     }
   } else {
-    prognosticator_.Put(std::move(prognosticator_parameters));
-    prognosticator_.Start();
-    prognostication = prognosticator_.Get();
+    prediction_scheduler_->Submit(
+        this,
+        prediction_priority_,
+        [this,
+         prognosticator_parameters,
+         adaptive_step_parameters = prediction_adaptive_step_parameters_,
+         is_extension]() {
+          auto status_or_prognostication =
+              FlowPrognostication(prognosticator_parameters);
+          // If the request was cancelled, there is no prognostication.
+          if (status_or_prognostication.ok()) {
+            absl::MutexLock l(&prognostication_lock_);
+            prognostication_ = Prognostication{
+                .trajectory = std::move(status_or_prognostication).value(),
+                .adaptive_step_parameters = adaptive_step_parameters,
+                .is_extension = is_extension};
+          }
+        });
+    prognostication = TakePrognostication();
   }
   if (prognostication.has_value()) {
-    AttachPrediction(std::move(prognostication).value());
+    AttachPrognostication(std::move(prognostication).value());
   }
 }
 
 void Vessel::RefreshPrediction(Instant const& time) {
   RefreshPrediction();
-  trajectory_.ForgetAfter(trajectory_.upper_bound(time));
+  auto& trajectory = history().trajectory;
+  trajectory.ForgetAfter(trajectory.upper_bound(time));
 }
 
 void Vessel::StopPrognosticator() {
-  prognosticator_.Stop();
+  if (prediction_scheduler_ != nullptr) {
+    prediction_scheduler_->Cancel(this);
+  }
+}
+
+void Vessel::SetPredictionScheduler(
+    PredictionScheduler* const prediction_scheduler) {
+  StopPrognosticator();
+  prediction_scheduler_ = prediction_scheduler;
+}
+
+void Vessel::set_prediction_priority(
+    PredictionScheduler::Priority const priority) {
+  prediction_priority_ = priority;
+}
+
+void Vessel::SetGraveyard(Graveyard* const graveyard) {
+  graveyard_ = graveyard;
+  for (auto& flight_plan : flight_plans_) {
+    if (std::holds_alternative<not_null<std::unique_ptr<FlightPlan>>>(
+            flight_plan)) {
+      std::get<not_null<std::unique_ptr<FlightPlan>>>(flight_plan)
+          ->SetGraveyard(graveyard);
+    }
+  }
 }
 
 void Vessel::RequestOrbitAnalysis(Time const& mission_duration) {
@@ -603,9 +798,10 @@ void Vessel::RequestOrbitAnalysis(Time const& mission_duration) {
           mission_duration) {
     orbit_analyser_->Interrupt();
   }
+  auto const& [time, degrees_of_freedom] = history().psychohistory->back();
   orbit_analyser_->RequestAnalysis(
-      {.first_time = psychohistory_->back().time,
-       .first_degrees_of_freedom = psychohistory_->back().degrees_of_freedom,
+      {.first_time = time,
+       .first_degrees_of_freedom = degrees_of_freedom,
        .mission_duration = mission_duration});
 }
 
@@ -634,6 +830,17 @@ std::string Vessel::ShortDebugString() const {
   return name_ + " (" + guid_ + ")";
 }
 
+void Vessel::PrepareForSerialization() const {
+  bool modified = false;
+  WithSerializedHistory([&modified](SerializedHistory& serialized_history) {
+    modified = !serialized_history.backstory_points.empty() ||
+               !serialized_history.psychohistory_points.empty();
+  });
+  if (modified) {
+    DeserializeHistoryIfNeeded();
+  }
+}
+
 void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
                             PileUp::SerializationIndexForPileUp const&
                                 serialization_index_for_pile_up) const {
@@ -658,27 +865,21 @@ void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
     message->add_kept_parts(part_id);
   }
 
-  // If the vessel is collapsible, we serialize at most the last
-  // |max_points_to_serialize| of the part of the trajectory that ends at the
-  // |backstory_|.  If it is not, however, we must serialize at least the entire
-  // |backstory_| otherwise we'd lose the beginning of a non-collapsible
-  // segment.
-  std::int64_t const history_size = backstory_->end() - trajectory_.begin();
-  std::int64_t const max_points_to_serialize_present_in_history =
-      std::min(max_points_to_serialize, history_size);
-  std::int64_t const serialized_points =
-      is_collapsible_ ? max_points_to_serialize_present_in_history
-                      : std::max(max_points_to_serialize_present_in_history,
-                                 backstory_->size());
-
-  // Starting with Gateaux we don't save the prediction, see #2685.  Instead we
-  // just save its first point and re-read as if it was the whole prediction.
-  trajectory_.WriteToMessage(
-      message->mutable_history(),
-      /*begin=*/backstory_->end() - serialized_points,
-      /*end=*/std::next(prediction_->begin()),
-      /*tracked=*/{backstory_, psychohistory_, prediction_},
-      /*exact=*/{});
+  // A trajectory that hasn't been deserialized is written back as it was read,
+  // which is what we would write after deserializing it.  This avoids
+  // prolonging the ephemeris.
+  bool wrote_serialized_history = false;
+  WithSerializedHistory([message, &wrote_serialized_history](
+                            SerializedHistory& serialized_history) {
+    if (serialized_history.backstory_points.empty() &&
+        serialized_history.psychohistory_points.empty()) {
+      *message->mutable_history() = serialized_history.trajectory;
+      wrote_serialized_history = true;
+    }
+  });
+  if (!wrote_serialized_history) {
+    WriteHistoryToMessage(message);
+  }
   for (auto const& flight_plan : flight_plans_) {
     if (std::holds_alternative<serialization::FlightPlan>(flight_plan)) {
       *message->add_flight_plans() =
@@ -699,6 +900,35 @@ void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
             << NAMED(message->ByteSize());
 }
 
+void Vessel::WriteHistoryToMessage(
+    not_null<serialization::Vessel*> const message) const {
+  History const& history = this->history();
+
+  // If the vessel is collapsible, we serialize at most the last
+  // |max_points_to_serialize| of the part of the trajectory that ends at the
+  // |backstory|.  If it is not, however, we must serialize at least the entire
+  // |backstory| otherwise we'd lose the beginning of a non-collapsible segment.
+  std::int64_t const history_size =
+      history.backstory->end() - history.trajectory.begin();
+  std::int64_t const max_points_to_serialize_present_in_history =
+      std::min(max_points_to_serialize, history_size);
+  std::int64_t const serialized_points =
+      is_collapsible_ ? max_points_to_serialize_present_in_history
+                      : std::max(max_points_to_serialize_present_in_history,
+                                 history.backstory->size());
+
+  // Starting with Gateaux we don't save the prediction, see #2685.  Instead we
+  // just save its first point and re-read as if it was the whole prediction.
+  history.trajectory.WriteToMessage(
+      message->mutable_history(),
+      /*begin=*/history.backstory->end() - serialized_points,
+      /*end=*/std::next(history.prediction->begin()),
+      /*tracked=*/{history.backstory,
+                   history.psychohistory,
+                   history.prediction},
+      /*exact=*/{});
+}
+
 not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
     serialization::Vessel const& message,
     not_null<Celestial const*> const parent,
@@ -746,63 +976,64 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
   }
 
   if (is_pre_cesàro) {
+    History& history = vessel->history();
     auto const psychohistory =
         DiscreteTrajectory<Barycentric>::ReadFromMessage(message.history(),
                                                          /*tracked=*/{});
-    // The |backstory_| has been created by the constructor above.  Reconstruct
+    // The |backstory| has been created by the constructor above.  Reconstruct
     // it from the |psychohistory|.
     for (auto it = psychohistory.begin(); it != psychohistory.end();) {
       auto const& [time, degrees_of_freedom] = *it;
       ++it;
       if (it == psychohistory.end() &&
           !message.psychohistory_is_authoritative()) {
-        vessel->psychohistory_ = vessel->trajectory_.NewSegment();
+        history.psychohistory = history.trajectory.NewSegment();
       }
-      vessel->trajectory_.Append(time, degrees_of_freedom).IgnoreError();
+      history.trajectory.Append(time, degrees_of_freedom).IgnoreError();
     }
     if (message.psychohistory_is_authoritative()) {
-      vessel->psychohistory_ = vessel->trajectory_.NewSegment();
+      history.psychohistory = history.trajectory.NewSegment();
     }
-    vessel->backstory_ = std::prev(vessel->psychohistory_);
-    vessel->prediction_ = vessel->trajectory_.NewSegment();
+    history.backstory = std::prev(history.psychohistory);
+    history.prediction = history.trajectory.NewSegment();
     vessel->downsampling_parameters_ = DefaultDownsamplingParameters();
   } else if (is_pre_chasles) {
-    vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+    History& history = vessel->history();
+    history.trajectory = DiscreteTrajectory<Barycentric>::ReadFromMessage(
         message.history(),
-        /*tracked=*/{&vessel->psychohistory_});
-    vessel->backstory_ = vessel->trajectory_.segments().begin();
-    CHECK(vessel->backstory_ == std::prev(vessel->psychohistory_));
-    vessel->prediction_ = vessel->trajectory_.NewSegment();
+        /*tracked=*/{&history.psychohistory});
+    history.backstory = history.trajectory.segments().begin();
+    CHECK(history.backstory == std::prev(history.psychohistory));
+    history.prediction = history.trajectory.NewSegment();
     vessel->downsampling_parameters_ = DefaultDownsamplingParameters();
   } else if (is_pre_hamilton) {
-    vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+    History& history = vessel->history();
+    history.trajectory = DiscreteTrajectory<Barycentric>::ReadFromMessage(
         message.history(),
-        /*tracked=*/{&vessel->psychohistory_, &vessel->prediction_});
-    vessel->backstory_ = vessel->trajectory_.segments().begin();
-    CHECK(vessel->backstory_ == std::prev(vessel->psychohistory_));
+        /*tracked=*/{&history.psychohistory, &history.prediction});
+    history.backstory = history.trajectory.segments().begin();
+    CHECK(history.backstory == std::prev(history.psychohistory));
     vessel->downsampling_parameters_ = DefaultDownsamplingParameters();
   } else if (is_pre_हरीश_चंद्र) {
-    DiscreteTrajectorySegmentIterator<Barycentric> history;
-    vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+    History& history = vessel->history();
+    DiscreteTrajectorySegmentIterator<Barycentric> first_segment;
+    history.trajectory = DiscreteTrajectory<Barycentric>::ReadFromMessage(
         message.history(),
-        /*tracked=*/{&history,
-                     &vessel->psychohistory_,
-                     &vessel->prediction_});
-    vessel->backstory_ = std::prev(vessel->psychohistory_);
+        /*tracked=*/{&first_segment,
+                     &history.psychohistory,
+                     &history.prediction});
+    history.backstory = std::prev(history.psychohistory);
     vessel->downsampling_parameters_ = DefaultDownsamplingParameters();
   } else {
-    vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
-        message.history(),
-        /*tracked=*/{&vessel->backstory_,
-                     &vessel->psychohistory_,
-                     &vessel->prediction_});
-    vessel->is_collapsible_ = message.is_collapsible();
-
+    // Starting with हरीश चंद्र we deserialize the trajectory lazily, but the
+    // checkpoints, the collapsibility and the downsampling parameters are
+    // cheap to read eagerly.
     vessel->checkpointer_ =
         Checkpointer<serialization::Vessel>::ReadFromMessage(
             vessel->MakeCheckpointerWriter(),
             vessel->MakeCheckpointerReader(),
             message.checkpoint());
+    vessel->is_collapsible_ = message.is_collapsible();
     if (message.has_downsampling_parameters()) {
       vessel->downsampling_parameters_ =
           DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters{
@@ -813,14 +1044,24 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
     } else {
       vessel->downsampling_parameters_ = std::nullopt;
     }
-  }
 
-  // Necessary after Εὔδοξος because the ephemeris has not been prolonged
-  // during deserialization.
-  ephemeris->Prolong(vessel->prediction_->back().time).IgnoreError();
+    // The history is tracked as |backstory|, |psychohistory|, |prediction|,
+    // see |WriteToMessage|.
+    auto const& trajectory = message.history();
+    CHECK_EQ(3, trajectory.tracked_position_size());
+    absl::MutexLock l(&vessel->serialized_history_lock_);
+    vessel->serialized_history_ =
+        std::make_unique<SerializedHistory>(SerializedHistory{
+            .trajectory = trajectory,
+            .backstory_back =
+                LastPointOfSegment(trajectory, trajectory.tracked_position(0)),
+            .psychohistory_back = LastPointOfSegment(
+                trajectory, trajectory.tracked_position(1))});
+    vessel->history_deserialized_ = false;
+  }
 
   if (is_pre_陈景润) {
-    vessel->backstory_->SetDownsamplingUnconditionally(
+    vessel->history().backstory->SetDownsamplingUnconditionally(
         DefaultDownsamplingParameters());
   }
 
@@ -832,44 +1073,9 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
       is_pre_hilbert ? static_cast<int>(vessel->flight_plans_.size()) - 1
                      : message.selected_flight_plan_index();
 
-  // Figure out which was the last checkpoint to be "reanimated" by reading the
-  // end of the trajectory from the serialized form.  Interestingly enough, that
-  // checkpoint (that is, the non-collapsible segment) may overlap the beginning
-  // of the trajectory that we just deserialized, in which case we must rebuild
-  // the front part of the non-collapsible segment to make sure that the
-  // trajectory doesn't start in the middle of a non-collapsible segment (the
-  // integration of the preceding collapsible segment would not end at the right
-  // time if it did).
-  Instant const checkpoint =
-      vessel->checkpointer_->checkpoint_at_or_after(
-          vessel->trajectory().t_min());
-  if (checkpoint != InfiniteFuture) {
-    CHECK_OK(vessel->checkpointer_->ReadFromCheckpointAt(
-        checkpoint,
-        [checkpoint, &vessel](
-            serialization::Vessel::Checkpoint const& message) {
-          // This code is similar to the one in ReanimateOneCheckpoint except
-          // that (1) we never need to reconstruct a collapsible segment; (2) we
-          // may actually have to truncate the non-collapsible segment obtained
-          // from the checkpoint.
-          LOG(INFO) << "Restoring " << vessel->ShortDebugString()
-                    << " to initial checkpoint at " << checkpoint;
-
-          DiscreteTrajectorySegmentIterator<Barycentric> unused;
-          auto reanimated_trajectory =
-              DiscreteTrajectory<Barycentric>::ReadFromMessage(
-                  message.non_collapsible_segment(),
-                  /*tracked=*/{&unused});
-          CHECK(!reanimated_trajectory.empty());
-          CHECK_EQ(checkpoint, reanimated_trajectory.back().time);
-          reanimated_trajectory.ForgetAfter(vessel->trajectory().t_min());
-          if (!reanimated_trajectory.empty()) {
-            vessel->trajectory_.Merge(std::move(reanimated_trajectory));
-          }
-          return absl::OkStatus();
-        }));
+  if (vessel->history_deserialized_) {
+    vessel->RestoreInitialCheckpoint();
   }
-  vessel->oldest_reanimated_checkpoint_ = checkpoint;
 
   return vessel;
 }
@@ -885,6 +1091,26 @@ void Vessel::FillContainingPileUpsFromMessage(
   }
 }
 
+void Vessel::RequestTrajectoryDeserialization(
+    ThreadPool<absl::Status>& thread_pool) {
+  if (history_deserialized_ || pending_deserialization_ != nullptr) {
+    return;
+  }
+  pending_deserialization_ = std::make_shared<PendingDeserialization>();
+  {
+    absl::MutexLock l(&pending_deserialization_->lock);
+    pending_deserialization_->vessel = this;
+  }
+  // The future is not needed: the destructor takes care of synchronization.
+  thread_pool.Add([pending_deserialization = pending_deserialization_]() {
+    absl::MutexLock l(&pending_deserialization->lock);
+    if (pending_deserialization->vessel != nullptr) {
+      pending_deserialization->vessel->DeserializeHistoryIfNeeded();
+    }
+    return absl::OkStatus();
+  });
+}
+
 void Vessel::MakeAsynchronous() {
   synchronous_ = false;
 }
@@ -902,23 +1128,22 @@ Vessel::Vessel()
           /*reader=*/nullptr,
           /*writer=*/nullptr)),
       reanimator_(/*action=*/nullptr, 0ms),
-      reanimator_clientele_(InfiniteFuture),
-      backstory_(trajectory_.segments().begin()),
-      psychohistory_(trajectory_.segments().end()),
-      prediction_(trajectory_.segments().end()),
-      prognosticator_(nullptr, 20ms) {}
+      reanimator_clientele_(InfiniteFuture) {}
 
-Checkpointer<serialization::Vessel>::Writer Vessel::MakeCheckpointerWriter() {
+Checkpointer<serialization::Vessel>::Writer
+Vessel::MakeCheckpointerWriter() const {
   return [this](not_null<serialization::Vessel::Checkpoint*> const message) {
-    // The extremities of the |backstory_| are implicitly exact.  Note that
-    // |backstory_->end()| might cause serialization of a 1-point psychohistory
+    // The extremities of the |backstory| are implicitly exact.  Note that
+    // |backstory->end()| might cause serialization of a 1-point psychohistory
     // or prediction (at the last time of the backstory).  To figure things out
-    // when reading we must track the |backstory_|.
-    trajectory_.WriteToMessage(message->mutable_non_collapsible_segment(),
-                               backstory_->begin(),
-                               backstory_->end(),
-                               /*tracked=*/{backstory_},
-                               /*exact=*/{});
+    // when reading we must track the |backstory|.
+    History const& history = this->history();
+    history.trajectory.WriteToMessage(
+        message->mutable_non_collapsible_segment(),
+        history.backstory->begin(),
+        history.backstory->end(),
+        /*tracked=*/{history.backstory},
+        /*exact=*/{});
 
     // Here the containing pile-up is the one for the collapsible segment.
     ForSomePart([message](Part& first_part) {
@@ -934,6 +1159,120 @@ Checkpointer<serialization::Vessel>::Reader Vessel::MakeCheckpointerReader() {
   };
 }
 
+Vessel::History& Vessel::history() {
+  DeserializeHistoryIfNeeded();
+  return history_;
+}
+
+Vessel::History const& Vessel::history() const {
+  DeserializeHistoryIfNeeded();
+  return history_;
+}
+
+bool Vessel::WithSerializedHistory(
+    std::function<void(SerializedHistory& serialized_history)> const& action)
+    const {
+  if (history_deserialized_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  absl::MutexLock l(&serialized_history_lock_);
+  if (serialized_history_ == nullptr) {
+    // Deserialized by another thread while we were waiting for the lock.
+    return false;
+  }
+  action(*serialized_history_);
+  return true;
+}
+
+void Vessel::DeserializeHistoryIfNeeded() const {
+  if (history_deserialized_.load(std::memory_order_acquire)) {
+    return;
+  }
+  absl::MutexLock l(&serialized_history_lock_);
+  if (serialized_history_ == nullptr) {
+    // Deserialized by another thread while we were waiting for the lock.
+    return;
+  }
+  LOG(INFO) << "Deserializing trajectory of " << ShortDebugString();
+  auto& [trajectory, backstory, psychohistory, prediction] = history_;
+  trajectory = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+      serialized_history_->trajectory,
+      /*tracked=*/{&backstory, &psychohistory, &prediction});
+  RestoreInitialCheckpoint();
+
+  // Apply the changes made by |AdvanceTime| while the |history_| was
+  // serialized, like |AdvanceTime| would have.
+  auto const& backstory_points = serialized_history_->backstory_points;
+  auto const& psychohistory_points = serialized_history_->psychohistory_points;
+  if (!backstory_points.empty() || !psychohistory_points.empty()) {
+    auto detached_prediction = trajectory.DetachSegments(prediction);
+    prediction = trajectory.segments().end();
+    trajectory.DeleteSegments(psychohistory);
+    for (auto const& [time, degrees_of_freedom] : backstory_points) {
+      trajectory.Append(time, degrees_of_freedom).IgnoreError();
+    }
+    psychohistory = trajectory.NewSegment();
+    for (auto const& [time, degrees_of_freedom] : psychohistory_points) {
+      trajectory.Append(time, degrees_of_freedom).IgnoreError();
+    }
+    AttachPrediction(std::move(detached_prediction), history_);
+  }
+  CHECK_EQ(serialized_history_->psychohistory_back.time,
+           psychohistory->back().time);
+
+  serialized_history_.reset();
+  history_deserialized_.store(true, std::memory_order_release);
+}
+
+void Vessel::RestoreInitialCheckpoint() const {
+  // Called while the |history_| is being deserialized, so it must not go
+  // through |history()|.
+  auto& trajectory = history_.trajectory;
+
+  // Necessary after Εὔδοξος because the ephemeris has not been prolonged
+  // during deserialization.
+  ephemeris_->Prolong(history_.prediction->back().time).IgnoreError();
+
+  // Figure out which was the last checkpoint to be "reanimated" by reading the
+  // end of the trajectory from the serialized form.  Interestingly enough, that
+  // checkpoint (that is, the non-collapsible segment) may overlap the beginning
+  // of the trajectory that we just deserialized, in which case we must rebuild
+  // the front part of the non-collapsible segment to make sure that the
+  // trajectory doesn't start in the middle of a non-collapsible segment (the
+  // integration of the preceding collapsible segment would not end at the right
+  // time if it did).
+  Instant const checkpoint =
+      checkpointer_->checkpoint_at_or_after(trajectory.t_min());
+  if (checkpoint != InfiniteFuture) {
+    CHECK_OK(checkpointer_->ReadFromCheckpointAt(
+        checkpoint,
+        [this, checkpoint, &trajectory](
+            serialization::Vessel::Checkpoint const& message) {
+          // This code is similar to the one in ReanimateOneCheckpoint except
+          // that (1) we never need to reconstruct a collapsible segment; (2) we
+          // may actually have to truncate the non-collapsible segment obtained
+          // from the checkpoint.
+          LOG(INFO) << "Restoring " << ShortDebugString()
+                    << " to initial checkpoint at " << checkpoint;
+
+          DiscreteTrajectorySegmentIterator<Barycentric> unused;
+          auto reanimated_trajectory =
+              DiscreteTrajectory<Barycentric>::ReadFromMessage(
+                  message.non_collapsible_segment(),
+                  /*tracked=*/{&unused});
+          CHECK(!reanimated_trajectory.empty());
+          CHECK_EQ(checkpoint, reanimated_trajectory.back().time);
+          reanimated_trajectory.ForgetAfter(trajectory.t_min());
+          if (!reanimated_trajectory.empty()) {
+            trajectory.Merge(std::move(reanimated_trajectory));
+          }
+          return absl::OkStatus();
+        }));
+  }
+  absl::MutexLock l(&lock_);
+  oldest_reanimated_checkpoint_ = checkpoint;
+}
+
 absl::Status Vessel::Reanimate(Instant const desired_t_min) {
   // This method is very similar to Ephemeris::Reanimate.  See the comments
   // there for some of the subtle points.
@@ -942,11 +1281,12 @@ absl::Status Vessel::Reanimate(Instant const desired_t_min) {
   LOG(INFO) << "Reanimating " << ShortDebugString() << " until "
             << desired_t_min;
 
+  auto const& trajectory = history().trajectory;
   Instant t_final;
   {
     absl::ReaderMutexLock l(&lock_);
     if (reanimated_trajectories_.empty()) {
-      t_final = trajectory_.begin()->time;
+      t_final = trajectory.begin()->time;
     } else {
       t_final = reanimated_trajectories_.back().front().time;
     }
@@ -1043,11 +1383,12 @@ bool Vessel::DesiredTMinReachedOrFullyReanimated(
   // This is the only place where the reanimation becomes externally visible,
   // thereby ensuring that the trajectory doesn't change, say, while clients
   // iterate over it.
+  auto& trajectory = history().trajectory;
   while (!reanimated_trajectories_.empty()) {
-    trajectory_.Merge(std::move(reanimated_trajectories_.front()));
+    trajectory.Merge(std::move(reanimated_trajectories_.front()));
     reanimated_trajectories_.pop();
   }
-  return trajectory_.t_min() <= desired_t_min ||
+  return trajectory.t_min() <= desired_t_min ||
          oldest_reanimated_checkpoint_ == checkpointer_->oldest_checkpoint();
 }
 
@@ -1058,12 +1399,15 @@ absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::FlowPrognostication(
       prognosticator_parameters.first_time,
       prognosticator_parameters.first_degrees_of_freedom).IgnoreError();
   absl::Status status;
-  status = ephemeris_->FlowWithAdaptiveStep(
-      &prognostication,
-      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-      ephemeris_->t_max(),
-      prognosticator_parameters.adaptive_step_parameters,
-      FlightPlan::max_ephemeris_steps_per_frame);
+  // An extension of the prediction may start after |t_max|.
+  if (prognosticator_parameters.first_time < ephemeris_->t_max()) {
+    status = ephemeris_->FlowWithAdaptiveStep(
+        &prognostication,
+        Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+        ephemeris_->t_max(),
+        prognosticator_parameters.adaptive_step_parameters,
+        FlightPlan::max_ephemeris_steps_per_frame);
+  }
   bool const reached_t_max = status.ok();
   if (reached_t_max) {
     // This will prolong the ephemeris by |max_ephemeris_steps_per_frame|.
@@ -1087,11 +1431,45 @@ absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::FlowPrognostication(
   }
 }
 
-void Vessel::AppendToVesselTrajectory(
-    TrajectoryIterator const part_trajectory_begin,
-    TrajectoryIterator const part_trajectory_end,
-    DiscreteTrajectorySegment<Barycentric> const& segment) {
+std::optional<Vessel::Prognostication> Vessel::TakePrognostication() {
+  absl::MutexLock l(&prognostication_lock_);
+  std::optional<Prognostication> result;
+  std::swap(result, prognostication_);
+  return result;
+}
+
+bool Vessel::PsychohistoryLiesOn(
+    DiscreteTrajectory<Barycentric> const& trajectory,
+    std::optional<Ephemeris<Barycentric>::AdaptiveStepParameters> const&
+        adaptive_step_parameters) const {
+  if (!adaptive_step_parameters.has_value() ||
+      !SameAdaptiveStepParameters(*adaptive_step_parameters,
+                                  prediction_adaptive_step_parameters_) ||
+      trajectory.empty()) {
+    return false;
+  }
+  auto const& [time, degrees_of_freedom] = history().psychohistory->back();
+  if (time < trajectory.front().time || time > trajectory.back().time) {
+    return false;
+  }
+  DegreesOfFreedom<Barycentric> const expected_degrees_of_freedom =
+      trajectory.EvaluateDegreesOfFreedom(time);
+  return (expected_degrees_of_freedom.position() -
+          degrees_of_freedom.position()).Norm() <=
+             prediction_adaptive_step_parameters_
+                 .length_integration_tolerance() &&
+         (expected_degrees_of_freedom.velocity() -
+          degrees_of_freedom.velocity()).Norm() <=
+             prediction_adaptive_step_parameters_
+                 .speed_integration_tolerance();
+}
+
+std::vector<DiscreteTrajectory<Barycentric>::value_type>
+Vessel::PartsBarycentres(TrajectoryIterator const part_trajectory_begin,
+                         TrajectoryIterator const part_trajectory_end,
+                         Instant const& last_time) const {
   CHECK(!parts_.empty());
+  std::vector<DiscreteTrajectory<Barycentric>::value_type> barycentres;
   std::vector<DiscreteTrajectory<Barycentric>::iterator> its;
   std::vector<DiscreteTrajectory<Barycentric>::iterator> ends;
   its.reserve(parts_.size());
@@ -1101,16 +1479,14 @@ void Vessel::AppendToVesselTrajectory(
     ends.push_back((*part.*part_trajectory_end)());
   }
 
-  // We cannot append a point before this time, see the comments in AdvanceTime.
-  Instant const last_time =
-      segment.empty() ? InfinitePast : segment.back().time;
-
   // Loop over the times of the trajectory.
   for (;;) {
     auto const& it0 = its[0];
     bool const at_end_of_part_trajectory = it0 == ends[0];
     Instant const first_time = at_end_of_part_trajectory ? Instant()
                                                          : it0->time;
+    // We cannot return a point before |last_time|, see the comments in
+    // AdvanceTime.
     bool const can_be_appended = !at_end_of_part_trajectory &&
                                  first_time > last_time;
 
@@ -1129,27 +1505,66 @@ void Vessel::AppendToVesselTrajectory(
     }
 
     if (at_end_of_part_trajectory) {
-      return;
+      return barycentres;
     }
 
-    // Append the parts' barycentre to the trajectory.
     if (can_be_appended) {
-      DegreesOfFreedom<Barycentric> const vessel_degrees_of_freedom =
-          calculator.Get();
-      trajectory_.Append(first_time, vessel_degrees_of_freedom).IgnoreError();
+      barycentres.emplace_back(first_time, calculator.Get());
     }
   }
 }
 
-void Vessel::AttachPrediction(DiscreteTrajectory<Barycentric>&& trajectory) {
-  trajectory.ForgetBefore(psychohistory_->back().time);
+void Vessel::AttachPrediction(DiscreteTrajectory<Barycentric>&& trajectory,
+                              History& history) const {
+  trajectory.ForgetBefore(history.psychohistory->back().time);
   if (trajectory.empty()) {
-    prediction_ = trajectory_.NewSegment();
+    history.prediction = history.trajectory.NewSegment();
   } else {
-    if (prediction_ != trajectory_.segments().end()) {
-      trajectory_.DeleteSegments(prediction_);
+    if (history.prediction != history.trajectory.segments().end()) {
+      Bury(history.trajectory.DetachSegments(history.prediction));
     }
-    prediction_ = trajectory_.AttachSegments(std::move(trajectory));
+    history.prediction =
+        history.trajectory.AttachSegments(std::move(trajectory));
+  }
+}
+
+void Vessel::Bury(DiscreteTrajectory<Barycentric> trajectory) const {
+  if (graveyard_ != nullptr) {
+    graveyard_->Bury(std::make_unique<DiscreteTrajectory<Barycentric>>(
+        std::move(trajectory)));
+  }
+}
+
+void Vessel::Bury(LazilyDeserializedFlightPlan flight_plan) const {
+  if (graveyard_ != nullptr &&
+      std::holds_alternative<not_null<std::unique_ptr<FlightPlan>>>(
+          flight_plan)) {
+    graveyard_->Bury(std::unique_ptr<FlightPlan>(
+        std::get<not_null<std::unique_ptr<FlightPlan>>>(
+            std::move(flight_plan))));
+  }
+}
+
+void Vessel::AttachPrognostication(Prognostication&& prognostication) {
+  History& history = this->history();
+  if (!prognostication.is_extension) {
+    AttachPrediction(std::move(prognostication.trajectory), history);
+    prediction_parameters_ = prognostication.adaptive_step_parameters;
+    return;
+  }
+  auto const& extension = prognostication.trajectory;
+  auto const& prediction = history.prediction;
+  if (prediction == history.trajectory.segments().end() ||
+      prediction->empty() ||
+      extension.empty() ||
+      extension.front().time != prediction->back().time ||
+      extension.front().degrees_of_freedom !=
+          prediction->back().degrees_of_freedom) {
+    return;
+  }
+  // The |prediction| is the last segment of the |trajectory|.
+  for (auto it = std::next(extension.begin()); it != extension.end(); ++it) {
+    history.trajectory.Append(it->time, it->degrees_of_freedom).IgnoreError();
   }
 }
 
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <set>
 #include <string>
@@ -11,14 +14,17 @@
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "base/graveyard.hpp"
 #include "base/jthread.hpp"
 #include "base/recurring_thread.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/instant.hpp"
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/flight_plan.hpp"
 #include "ksp_plugin/orbit_analyser.hpp"
 #include "ksp_plugin/part.hpp"
 #include "ksp_plugin/pile_up.hpp"
+#include "ksp_plugin/prediction_scheduler.hpp"
 #include "physics/checkpointer.hpp"
 #include "physics/clientele.hpp"
 #include "physics/discrete_trajectory.hpp"
@@ -37,8 +43,10 @@ class VesselTest;
 namespace _vessel {
 namespace internal {
 
+using namespace principia::base::_graveyard;
 using namespace principia::base::_not_null;
 using namespace principia::base::_recurring_thread;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::ksp_plugin::_celestial;
@@ -49,6 +57,7 @@ using namespace principia::ksp_plugin::_manœuvre;
 using namespace principia::ksp_plugin::_orbit_analyser;
 using namespace principia::ksp_plugin::_part;
 using namespace principia::ksp_plugin::_pile_up;
+using namespace principia::ksp_plugin::_prediction_scheduler;
 using namespace principia::physics::_checkpointer;
 using namespace principia::physics::_clientele;
 using namespace principia::physics::_degrees_of_freedom;
@@ -128,7 +137,7 @@ class Vessel {
 
   // If the trajectory is empty, appends a single point to it, computed as the
   // barycentre of all parts.  |parts_| must not be empty.  After this call,
-  // |trajectory_| is never empty again and the psychohistory is usable.  Must
+  // the trajectory is never empty again and the psychohistory is usable.  Must
   // be called (at least once) after the creation of the vessel.
   virtual void CreateTrajectoryIfNeeded(Instant const& t);
 
@@ -150,6 +159,12 @@ class Vessel {
   virtual DiscreteTrajectorySegmentIterator<Barycentric> psychohistory() const;
   virtual DiscreteTrajectorySegmentIterator<Barycentric> prediction() const;
 
+  // Returns the last point of the psychohistory.  Unlike |psychohistory()|,
+  // doesn't deserialize the trajectory, so it is cheap to call on all the
+  // vessels after loading a save.
+  virtual DiscreteTrajectory<Barycentric>::value_type
+  last_psychohistory_point() const;
+
   virtual void set_prediction_adaptive_step_parameters(
       Ephemeris<Barycentric>::AdaptiveStepParameters const&
           prediction_adaptive_step_parameters);
@@ -241,6 +256,21 @@ class Vessel {
   // Stop the asynchronous prognosticator as soon as convenient.
   void StopPrognosticator();
 
+  // Makes the prognostications run asynchronously on |prediction_scheduler|,
+  // which must outlive this object.  If |prediction_scheduler| is null, the
+  // prognostications run synchronously.
+  void SetPredictionScheduler(PredictionScheduler* prediction_scheduler);
+
+  // The priority of the prognostications submitted to the prediction
+  // scheduler.  Defaults to |Background|.
+  void set_prediction_priority(PredictionScheduler::Priority priority);
+
+  // Makes the large trajectories and flight plans that this vessel drops, as
+  // well as those that it owns when it is destroyed, be destroyed
+  // asynchronously by |graveyard|, which must outlive this object.  If
+  // |graveyard| is null, they are destroyed synchronously.
+  void SetGraveyard(Graveyard* graveyard);
+
   // Stops any analyser running for a different mission duration and triggers a
   // new analysis.
   void RequestOrbitAnalysis(Time const& mission_duration);
@@ -263,7 +293,15 @@ class Vessel {
   // Returns "vessel_name (GUID)".
   std::string ShortDebugString() const;
 
-  // The vessel must satisfy |is_initialized()|.
+  // Deserializes the trajectory if it was read lazily and has changed since,
+  // so that |WriteToMessage| doesn't have to.  Deserialization prolongs the
+  // ephemeris, so this must be called before serializing the vessel
+  // concurrently with the ephemeris.
+  void PrepareForSerialization() const;
+
+  // The vessel must satisfy |is_initialized()|.  If the trajectory was read
+  // lazily and hasn't changed since, it is written back without being
+  // deserialized.
   virtual void WriteToMessage(not_null<serialization::Vessel*> message,
                               PileUp::SerializationIndexForPileUp const&
                                   serialization_index_for_pile_up) const;
@@ -277,6 +315,14 @@ class Vessel {
       PileUp::PileUpForSerializationIndex const&
           pile_up_for_serialization_index);
 
+  // Starting with हरीश चंद्र, |ReadFromMessage| doesn't deserialize the
+  // trajectory of the vessel: this happens the first time that a member
+  // function needs it.  This method asks |thread_pool| to deserialize it ahead
+  // of time.  It is safe to destroy this object before the deserialization has
+  // run.  Does nothing if there is nothing left to deserialize.
+  void RequestTrajectoryDeserialization(
+      ThreadPool<absl::Status>& thread_pool);
+
   static void MakeAsynchronous();
   static void MakeSynchronous();
 
@@ -293,6 +339,55 @@ class Vessel {
   friend bool operator!=(PrognosticatorParameters const& left,
                          PrognosticatorParameters const& right);
 
+  // The result of a run of the prognosticator.
+  struct Prognostication {
+    DiscreteTrajectory<Barycentric> trajectory;
+    // The parameters of the prediction, as opposed to those that were used for
+    // the run, which may have a smaller |max_steps| for an extension.
+    Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters;
+    // If true, |trajectory| starts at the last point of the |prediction| at
+    // the time of the request, and must be appended to it.  Otherwise it
+    // replaces the |prediction|.
+    bool is_extension;
+  };
+
+  // The trajectory of the vessel and its segments.  The segment iterators
+  // point into |trajectory|, which is never moved out of this object.
+  struct History {
+    // The vessel trajectory is made of a number of history segments ending at
+    // the backstory and (most of the time) the psychohistory and prediction.
+    // The prediction is periodically recomputed by the prognosticator.  Only
+    // grows "backwards" under |lock_|.
+    DiscreteTrajectory<Barycentric> trajectory;
+
+    // The last (most recent) segment of the history prior to the
+    // |psychohistory|.  Always identical to |std::prev(psychohistory)|.
+    DiscreteTrajectorySegmentIterator<Barycentric> backstory =
+        trajectory.segments().begin();
+
+    // The |psychohistory| is the segment following the |backstory| and the
+    // |prediction| is the segment following the |psychohistory|.
+    DiscreteTrajectorySegmentIterator<Barycentric> psychohistory =
+        trajectory.segments().end();
+    DiscreteTrajectorySegmentIterator<Barycentric> prediction =
+        trajectory.segments().end();
+  };
+
+  // What is left of the |History| when it hasn't been deserialized yet: the
+  // serialized trajectory, and the changes that |AdvanceTime| made since it
+  // was read.  The last points of the segments are read eagerly from the
+  // message, as the plugin needs them for all the vessels at every step.
+  struct SerializedHistory {
+    serialization::DiscreteTrajectory trajectory;
+    DiscreteTrajectory<Barycentric>::value_type backstory_back;
+    DiscreteTrajectory<Barycentric>::value_type psychohistory_back;
+    // The points to append to the |backstory| and to the new |psychohistory|
+    // that replaces the deserialized one, all after |backstory_back|.
+    std::vector<DiscreteTrajectory<Barycentric>::value_type> backstory_points;
+    std::vector<DiscreteTrajectory<Barycentric>::value_type>
+        psychohistory_points;
+  };
+
   using TrajectoryIterator =
       DiscreteTrajectory<Barycentric>::iterator (Part::*)();
 
@@ -300,13 +395,45 @@ class Vessel {
       std::variant<not_null<std::unique_ptr<FlightPlan>>,
                    serialization::FlightPlan>;
 
+  // Shared between a vessel and the task that deserializes its trajectory in
+  // the background.  The vessel sets |vessel| to null when it is destroyed.
+  struct PendingDeserialization {
+    absl::Mutex lock;
+    Vessel* vessel GUARDED_BY(lock);
+  };
+
   // Return functions that can be passed to a |Checkpointer| to write this
   // vessel to a checkpoint or read it back.
   Checkpointer<serialization::Vessel>::Writer
-  MakeCheckpointerWriter();
+  MakeCheckpointerWriter() const;
   Checkpointer<serialization::Vessel>::Reader
   MakeCheckpointerReader();
 
+  // Returns the |history_|, deserializing it if needed.  All the accesses to
+  // the |history_| must go through these functions.  Thread-safe.
+  History& history() EXCLUDES(serialized_history_lock_);
+  History const& history() const EXCLUDES(serialized_history_lock_);
+
+  // If the |history_| hasn't been deserialized yet, calls |action| with the
+  // |serialized_history_| and returns true.  Otherwise returns false.  Never
+  // deserializes the |history_|.
+  bool WithSerializedHistory(
+      std::function<void(SerializedHistory& serialized_history)> const& action)
+      const EXCLUDES(serialized_history_lock_);
+
+  // Writes the |history_| to the |history| field of |message|, deserializing
+  // it if needed.
+  void WriteHistoryToMessage(not_null<serialization::Vessel*> message) const;
+
+  // Deserializes the |history_| from the |serialized_history_| if it hasn't
+  // been deserialized yet and applies the changes recorded since.
+  void DeserializeHistoryIfNeeded() const EXCLUDES(serialized_history_lock_);
+
+  // Prolongs the ephemeris to cover the trajectory and restores the initial
+  // checkpoint, if any.  Must be called once the trajectory and the checkpoints
+  // have been read.
+  void RestoreInitialCheckpoint() const;
+
   absl::Status Reanimate(Instant const desired_t_min) EXCLUDES(lock_);
 
   // |t_initial| is the time of the checkpoint, which is the end of the non-
@@ -320,7 +447,8 @@ class Vessel {
 
   // Merges any reanimated trajectories found in the queue and returns true if
   // the reanimation reached |desired_t_min|, or if the vessel is fully
-  // reanimated.
+  // reanimated.  The |history_| must have been deserialized, as deserializing
+  // it takes |lock_|.
   bool DesiredTMinReachedOrFullyReanimated(Instant const& desired_t_min)
       SHARED_LOCKS_REQUIRED(lock_);
 
@@ -329,17 +457,42 @@ class Vessel {
   absl::StatusOr<DiscreteTrajectory<Barycentric>>
   FlowPrognostication(PrognosticatorParameters prognosticator_parameters);
 
-  // Appends to |trajectory_| the centre of mass of the trajectories of the
-  // parts denoted by |part_trajectory_begin| and |part_trajectory_end|.  Only
-  // the points that are strictly after the start of the |segment| are used.
-  void AppendToVesselTrajectory(
+  // Returns the last prognostication computed by the prediction scheduler, if
+  // there is one that hasn't been returned yet.
+  std::optional<Prognostication> TakePrognostication()
+      EXCLUDES(prognostication_lock_);
+
+  // Returns true if the last point of the |psychohistory| lies on
+  // |trajectory|, computed with |adaptive_step_parameters|, within the
+  // integration tolerances of the |prediction_adaptive_step_parameters_|.
+  bool PsychohistoryLiesOn(
+      DiscreteTrajectory<Barycentric> const& trajectory,
+      std::optional<Ephemeris<Barycentric>::AdaptiveStepParameters> const&
+          adaptive_step_parameters) const;
+
+  // Returns the centres of mass of the trajectories of the parts denoted by
+  // |part_trajectory_begin| and |part_trajectory_end|.  Only the points that
+  // are strictly after |last_time| are returned.
+  std::vector<DiscreteTrajectory<Barycentric>::value_type> PartsBarycentres(
       TrajectoryIterator part_trajectory_begin,
       TrajectoryIterator part_trajectory_end,
-      DiscreteTrajectorySegment<Barycentric> const& segment);
+      Instant const& last_time) const;
 
-  // Attaches the given |trajectory| to the end of the |psychohistory_| to
-  // become the new |prediction_|.  If |prediction_| is not null, it is deleted.
-  void AttachPrediction(DiscreteTrajectory<Barycentric>&& trajectory);
+  // Attaches the given |trajectory| to the end of the |psychohistory| of
+  // |history| to become the new |prediction|.  If |prediction| is not null, it
+  // is buried.
+  void AttachPrediction(DiscreteTrajectory<Barycentric>&& trajectory,
+                        History& history) const;
+
+  // Attaches a full |prognostication| using |AttachPrediction|, or appends an
+  // extension to the |prediction|.  An extension that doesn't start at the end
+  // of the |prediction| is stale and is dropped.
+  void AttachPrognostication(Prognostication&& prognostication);
+
+  // Destroys |trajectory| or |flight_plan| asynchronously in the |graveyard_|
+  // if there is one, synchronously otherwise.
+  void Bury(DiscreteTrajectory<Barycentric> trajectory) const;
+  void Bury(LazilyDeserializedFlightPlan flight_plan) const;
 
   // A vessel is collapsible if it is alone in its pile-up and is in inertial
   // motion.
@@ -365,6 +518,18 @@ class Vessel {
 
   mutable absl::Mutex lock_;
 
+  // The |history_| is logically part of the state of this object even when it
+  // is still serialized, so it may be deserialized by const member functions,
+  // hence the |mutable|s.  Use |history()| to access it.
+  mutable History history_;
+  // Null once the |history_| has been deserialized.
+  mutable absl::Mutex serialized_history_lock_;
+  mutable std::unique_ptr<SerializedHistory> serialized_history_
+      GUARDED_BY(serialized_history_lock_);
+  // True if |serialized_history_| is null, lets |history()| skip the lock.
+  mutable std::atomic_bool history_deserialized_ = true;
+  std::shared_ptr<PendingDeserialization> pending_deserialization_;
+
   // When reading a pre-हरीश चंद्र save, the existing history must be
   // non-collapsible as we don't know anything about it.
   bool is_collapsible_ = false;
@@ -372,17 +537,13 @@ class Vessel {
   std::map<PartId, not_null<std::unique_ptr<Part>>> parts_;
   std::set<PartId> kept_parts_;
 
-  // The vessel trajectory is made of a number of history segments ending at the
-  // backstory and (most of the time) the psychohistory and prediction.  The
-  // prediction is periodically recomputed by the prognosticator.  Only grows
-  // "backwards" under |lock_|.
-  DiscreteTrajectory<Barycentric> trajectory_;
-
   not_null<std::unique_ptr<Checkpointer<serialization::Vessel>>> checkpointer_;
 
   // Vessels that are constructed de novo won't ever need reanimation, so all
-  // the checkpoints are animate at birth.
-  Instant oldest_reanimated_checkpoint_ GUARDED_BY(lock_) = InfinitePast;
+  // the checkpoints are animate at birth.  Set when the |history_| is
+  // deserialized.
+  mutable Instant oldest_reanimated_checkpoint_ GUARDED_BY(lock_) =
+      InfinitePast;
 
   // The techniques and terminology follow [Lov22].
   RecurringThread<Instant> reanimator_;
@@ -396,18 +557,23 @@ class Vessel {
   std::queue<DiscreteTrajectory<Barycentric>> reanimated_trajectories_
       GUARDED_BY(lock_);
 
-  // The last (most recent) segment of the |history_| prior to the
-  // |psychohistory_|.  May be identical to |history_|.  Always identical to
-  // |std::prev(psychohistory_)|.
-  DiscreteTrajectorySegmentIterator<Barycentric> backstory_;
-
-  // The |psychohistory_| is the segment following the |backstory_| and the
-  // |prediction_| is the segment following the |psychohistory_|.
-  DiscreteTrajectorySegmentIterator<Barycentric> psychohistory_;
-  DiscreteTrajectorySegmentIterator<Barycentric> prediction_;
-
-  RecurringThread<PrognosticatorParameters,
-                  DiscreteTrajectory<Barycentric>> prognosticator_;
+  Graveyard* graveyard_ = nullptr;
+  PredictionScheduler* prediction_scheduler_ = nullptr;
+  PredictionScheduler::Priority prediction_priority_ =
+      PredictionScheduler::Priority::Visible;
+  // Written by the prognostications that run on the |prediction_scheduler_|.
+  absl::Mutex prognostication_lock_;
+  std::optional<Prognostication> prognostication_
+      GUARDED_BY(prognostication_lock_);
+
+  // The parameters used to compute the |prediction|, or null if they are not
+  // known, e.g., after deserialization.
+  std::optional<Ephemeris<Barycentric>::AdaptiveStepParameters>
+      prediction_parameters_;
+  // Set by |AdvanceTime|: true if the vessel coasted along the |prediction|,
+  // in which case |RefreshPrediction| only extends the |prediction| instead of
+  // recomputing it.
+  bool coasting_along_prediction_ = false;
 
   std::vector<std::variant<not_null<std::unique_ptr<FlightPlan>>,
                            serialization::FlightPlan>> flight_plans_;
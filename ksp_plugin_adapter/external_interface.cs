@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 using System.Security.Authentication;
 
 namespace principia {
@@ -26,6 +27,51 @@ public class ExternalInterface {
     return result;
   }
 
+  public QP FlowFreefall(
+      int central_body_index,
+      QP world_body_centred_initial_degrees_of_freedom,
+      double t_initial,
+      double t_final) {
+    ThrowOnError(
+        adapter_.Plugin().ExternalFlowFreefall(
+            central_body_index, world_body_centred_initial_degrees_of_freedom,
+            t_initial, t_final, out QP result));
+    return result;
+  }
+
+  // Integrates all the |world_body_centred_initial_degrees_of_freedom| in
+  // parallel.  An element of the result is meaningful only if the
+  // corresponding element of |errors| is 0, otherwise it is the error code of
+  // the integration.
+  public QP[] FlowFreefallBatch(
+      int central_body_index,
+      QP[] world_body_centred_initial_degrees_of_freedom,
+      double t_initial,
+      double t_final,
+      out int[] errors) {
+    int size = world_body_centred_initial_degrees_of_freedom.Length;
+    var result = new QP[size];
+    errors = new int[size];
+    GCHandle initial_handle = GCHandle.Alloc(
+        world_body_centred_initial_degrees_of_freedom, GCHandleType.Pinned);
+    GCHandle result_handle = GCHandle.Alloc(result, GCHandleType.Pinned);
+    GCHandle errors_handle = GCHandle.Alloc(errors, GCHandleType.Pinned);
+    try {
+      ThrowOnError(
+          adapter_.Plugin().ExternalFlowFreefallBatch(
+              central_body_index,
+              initial_handle.AddrOfPinnedObject(), size,
+              t_initial, t_final,
+              result_handle.AddrOfPinnedObject(), size,
+              errors_handle.AddrOfPinnedObject(), size));
+    } finally {
+      errors_handle.Free();
+      result_handle.Free();
+      initial_handle.Free();
+    }
+    return result;
+  }
+
   public XY GeopotentialGetCoefficient(int body_index, int degree, int order) {
     ThrowOnError(
         adapter_.Plugin().ExternalGeopotentialGetCoefficient(
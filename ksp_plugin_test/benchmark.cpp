@@ -7,11 +7,17 @@
 #include "base/serialization.hpp"
 #include "benchmark/benchmark.h"
 #include "gtest/gtest.h"
+#include "astronomy/frames.hpp"
 #include "ksp_plugin/interface.hpp"
+#include "ksp_plugin_test/fake_plugin.hpp"
 #include "ksp_plugin_test/plugin_io.hpp"
+#include "physics/kepler_orbit.hpp"
+#include "physics/massless_body.hpp"
+#include "physics/solar_system.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/ksp_plugin.pb.h"
 #include "testing_utilities/serialization.hpp"
+#include "testing_utilities/solar_system_factory.hpp"
 
 namespace principia {
 namespace ksp_plugin {
@@ -23,18 +29,25 @@ using interface::principia__FutureCatchUpVessel;
 using interface::principia__FutureWaitForVesselToCatchUp;
 using interface::principia__IteratorDelete;
 using interface::principia__SerializePlugin;
+using namespace principia::astronomy::_frames;
 using namespace principia::base::_pull_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
+using namespace principia::ksp_plugin::_fake_plugin;
+using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
 using namespace principia::ksp_plugin::_iterators;
 using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::ksp_plugin::_plugin;
 using namespace principia::ksp_plugin::_plugin_io;
+using namespace principia::physics::_kepler_orbit;
+using namespace principia::physics::_massless_body;
+using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 using namespace principia::testing_utilities::_serialization;
+using namespace principia::testing_utilities::_solar_system_factory;
 
 void BM_PluginIntegrationBenchmark(benchmark::State& state) {
   auto const plugin = Plugin::ReadFromMessage(
@@ -99,6 +112,78 @@ void BM_PluginSerializationBenchmark(benchmark::State& state) {
   state.SetBytesProcessed(bytes_processed);
 }
 
+// Measures the end-to-end save of a plugin with |state.range(0)| unloaded
+// vessels in Earth orbit, each having a history of a few days: serialization
+// of the plugin, compression and encoding.  If |state.range(1)| is 0, the
+// vessels, the ephemeris and the pile-ups are serialized sequentially instead
+// of on the vessel thread pool.
+void BM_PluginSaveBenchmark(benchmark::State& state) {
+  int const number_of_vessels = state.range(0);
+  bool const parallel = state.range(1) != 0;
+  char const compressor[] = "gipfeli";
+  char const encoder[] = "hexadecimal";
+
+  FakePlugin plugin(SolarSystem<ICRS>(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt"));
+  for (int i = 0; i < number_of_vessels; ++i) {
+    KeplerianElements<Barycentric> elements;
+    elements.eccentricity = 0.01;
+    elements.semimajor_axis = (6783 + 10 * i) * Kilo(Metre);
+    elements.inclination = i * Degree;
+    elements.longitude_of_ascending_node = 0 * Radian;
+    elements.argument_of_periapsis = 0 * Radian;
+    elements.mean_anomaly = 0 * Radian;
+    KeplerOrbit<Barycentric> const orbit(
+        *plugin.GetCelestial(SolarSystemFactory::Earth).body(),
+        MasslessBody{},
+        elements,
+        plugin.CurrentTime());
+    GUID const vessel_guid = std::to_string(i);
+    bool inserted;
+    plugin.InsertOrKeepVessel(vessel_guid,
+                              "vessel " + vessel_guid,
+                              SolarSystemFactory::Earth,
+                              /*loaded=*/false,
+                              inserted);
+    plugin.InsertUnloadedPart(
+        /*part_id=*/i,
+        "part " + vessel_guid,
+        vessel_guid,
+        plugin.PlanetariumRotation()(
+            orbit.StateVectors(plugin.CurrentTime())));
+  }
+  plugin.PrepareToReportCollisions();
+  plugin.FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+  for (int i = 0; i < 72; ++i) {
+    plugin.AdvanceTime(plugin.CurrentTime() + 1 * Hour,
+                       /*planetarium_rotation=*/0 * Radian);
+    VesselSet collided_vessels;
+    plugin.CatchUpLaggingVessels(collided_vessels);
+  }
+  plugin.SetParallelSerialization(parallel);
+
+  std::int64_t bytes_processed = 0;
+  for (auto _ : state) {
+    PullSerializer* serializer = nullptr;
+    char const* serialization = nullptr;
+    for (;;) {
+      serialization = principia__SerializePlugin(&plugin,
+                                                 &serializer,
+                                                 compressor,
+                                                 encoder);
+      if (serialization == nullptr) {
+        break;
+      }
+      bytes_processed += std::strlen(serialization);
+      delete serialization;
+    }
+  }
+
+  state.SetBytesProcessed(bytes_processed);
+}
+
 void BM_PluginDeserializationBenchmark(benchmark::State& state) {
   char const compressor[] = "gipfeli";
   char const encoder[] = "hexadecimal";
@@ -116,6 +201,10 @@ void BM_PluginDeserializationBenchmark(benchmark::State& state) {
 }
 
 BENCHMARK(BM_PluginSerializationBenchmark)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PluginSaveBenchmark)
+    ->ArgsProduct({{10, 100}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
 BENCHMARK(BM_PluginDeserializationBenchmark)->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_PluginIntegrationBenchmark)->Unit(benchmark::kMillisecond);
 
@@ -1,5 +1,6 @@
 #include "ksp_plugin/flight_plan.hpp"
 
+#include <cstdint>
 #include <limits>
 #include <vector>
 
@@ -587,5 +588,50 @@ TEST_F(FlightPlanTest, Insertion) {
   EXPECT_THAT(inserted_out_of_order, EqualsProto(inserted_in_order));
 }
 
+TEST_F(FlightPlanTest, SegmentCache) {
+  EXPECT_OK(flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second));
+  EXPECT_OK(flight_plan_->Insert(MakeFirstBurn(), 0));
+  EXPECT_OK(flight_plan_->Insert(MakeSecondBurn(), 1));
+  auto const final_point = flight_plan_->GetAllSegments().back();
+  std::int64_t const hits = flight_plan_->segment_cache_statistics().hits;
+
+  // Removing the last manœuvre restores the coast that followed the first one
+  // before the second one was inserted.
+  EXPECT_OK(flight_plan_->Remove(1));
+  EXPECT_EQ(hits + 1, flight_plan_->segment_cache_statistics().hits);
+
+  // Undoing the removal restores the coast, the burn and the final coast
+  // without integration, and yields exactly the same trajectory.
+  EXPECT_OK(flight_plan_->Insert(MakeSecondBurn(), 1));
+  EXPECT_EQ(hits + 4, flight_plan_->segment_cache_statistics().hits);
+  EXPECT_EQ(5, flight_plan_->number_of_segments());
+  EXPECT_EQ(final_point.time, flight_plan_->GetAllSegments().back().time);
+  EXPECT_EQ(final_point.degrees_of_freedom,
+            flight_plan_->GetAllSegments().back().degrees_of_freedom);
+  EXPECT_LT(0, flight_plan_->segment_cache_statistics().hit_rate());
+  EXPECT_LE(flight_plan_->segment_cache_statistics().points,
+            FlightPlan::max_cached_segment_points);
+}
+
+TEST_F(FlightPlanTest, Version) {
+  std::int64_t const initial_version = flight_plan_->version();
+  EXPECT_OK(flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second));
+  std::int64_t const version = flight_plan_->version();
+  EXPECT_NE(initial_version, version);
+
+  // Queries don't change the version.
+  flight_plan_->GetAllSegments();
+  flight_plan_->number_of_segments();
+  EXPECT_EQ(version, flight_plan_->version());
+
+  // Every edit does, even if it is undone.
+  EXPECT_OK(flight_plan_->Insert(MakeFirstBurn(), 0));
+  std::int64_t const version_with_burn = flight_plan_->version();
+  EXPECT_NE(version, version_with_burn);
+  EXPECT_OK(flight_plan_->Remove(0));
+  EXPECT_NE(version, flight_plan_->version());
+  EXPECT_NE(version_with_burn, flight_plan_->version());
+}
+
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -1,6 +1,7 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -16,9 +17,12 @@ namespace principia {
 namespace interface {
 
 using ::testing::AllOf;
+using ::testing::Each;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Gt;
 using ::testing::Lt;
+using ::testing::Not;
 using namespace principia::astronomy::_frames;
 using namespace principia::base::_not_null;
 using namespace principia::ksp_plugin::_fake_plugin;
@@ -91,17 +95,18 @@ TEST_F(InterfaceExternalTest, GetNearestPlannedCoastDegreesOfFreedom) {
   QP result;
   auto const to_world =
       plugin_.renderer().BarycentricToWorld(plugin_.PlanetariumRotation());
+  XYZ const reference_position =
+      ToXYZ(to_world(Displacement<Barycentric>(
+                         {-100'000 * Kilo(Metre), 0 * Metre, 0 * Metre}))
+                .coordinates() /
+            Metre);
   auto const* const status =
       principia__ExternalGetNearestPlannedCoastDegreesOfFreedom(
           &plugin_,
           SolarSystemFactory::Earth,
           vessel_guid,
           /*manoeuvre_index=*/0,
-          /*reference_position=*/
-          ToXYZ(to_world(Displacement<Barycentric>(
-                             {-100'000 * Kilo(Metre), 0 * Metre, 0 * Metre}))
-                    .coordinates() /
-                Metre),
+          reference_position,
           &result);
   EXPECT_THAT(*status, IsOk());
   auto const barycentric_result =
@@ -117,6 +122,142 @@ TEST_F(InterfaceExternalTest, GetNearestPlannedCoastDegreesOfFreedom) {
                                   IsNear(-4.9_(1) * Kilo(Metre) / Second),
                                   AllOf(Gt(-1 * Centi(Metre) / Second),
                                         Lt(1 * Centi(Metre) / Second)))));
+
+  // Repeating the query uses the cached coast and yields the same result.
+  auto const statistics = plugin_.planned_coast_cache().statistics();
+  QP cached_result;
+  auto const* const cached_status =
+      principia__ExternalGetNearestPlannedCoastDegreesOfFreedom(
+          &plugin_,
+          SolarSystemFactory::Earth,
+          vessel_guid,
+          /*manoeuvre_index=*/0,
+          reference_position,
+          &cached_result);
+  EXPECT_THAT(*cached_status, IsOk());
+  EXPECT_TRUE(cached_result == result);
+  EXPECT_EQ(statistics.hits + 1,
+            plugin_.planned_coast_cache().statistics().hits);
+  EXPECT_EQ(statistics.misses,
+            plugin_.planned_coast_cache().statistics().misses);
+
+  // Changing the flight plan causes the coast to be transformed again.
+  EXPECT_OK(vessel_->flight_plan().SetDesiredFinalTime(
+      plugin_.CurrentTime() + 7 * Hour));
+  auto const* const edited_status =
+      principia__ExternalGetNearestPlannedCoastDegreesOfFreedom(
+          &plugin_,
+          SolarSystemFactory::Earth,
+          vessel_guid,
+          /*manoeuvre_index=*/0,
+          reference_position,
+          &cached_result);
+  EXPECT_THAT(*edited_status, IsOk());
+  EXPECT_EQ(statistics.misses + 1,
+            plugin_.planned_coast_cache().statistics().misses);
+}
+
+TEST_F(InterfaceExternalTest, FlowFreefall) {
+  // A circular low orbit; the body-centred world coordinates differ from the
+  // body-centred inertial ones by an orthogonal map, so the orbit is still
+  // circular in these coordinates.
+  QP const initial = {/*q=*/{6783e3, 0, 0}, /*p=*/{0, 0, 7665.8}};
+  double const t_initial = ToGameTime(plugin_, plugin_.CurrentTime());
+  double const t_final = t_initial + 3600;
+  QP result;
+  auto const* const status = principia__ExternalFlowFreefall(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial,
+      t_initial,
+      t_final,
+      &result);
+  EXPECT_THAT(*status, IsOk());
+  auto const final_degrees_of_freedom =
+      FromQP<RelativeDegreesOfFreedom<World>>(result);
+  EXPECT_THAT(final_degrees_of_freedom.displacement().Norm(),
+              AllOf(Gt(6770 * Kilo(Metre)), Lt(6800 * Kilo(Metre))));
+  EXPECT_THAT(final_degrees_of_freedom.velocity().Norm(),
+              AllOf(Gt(7640 * Metre / Second), Lt(7690 * Metre / Second)));
+
+  // The integration cannot go backwards.
+  auto const* const backwards_status = principia__ExternalFlowFreefall(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial,
+      /*t_initial=*/t_final,
+      /*t_final=*/t_initial,
+      &result);
+  EXPECT_THAT(*backwards_status, Not(IsOk()));
+}
+
+TEST_F(InterfaceExternalTest, FlowFreefallBatch) {
+  // The second body starts inside the Earth.
+  std::vector<QP> initial = {{/*q=*/{6783e3, 0, 0}, /*p=*/{0, 0, 7665.8}},
+                             {/*q=*/{1000e3, 0, 0}, /*p=*/{0, 0, 0}},
+                             {/*q=*/{0, 6783e3, 0}, /*p=*/{-7665.8, 0, 0}}};
+  double const t_initial = ToGameTime(plugin_, plugin_.CurrentTime());
+  double const t_final = t_initial + 3600;
+  std::vector<QP> batch_results(initial.size());
+  std::vector<int> errors(initial.size(), -1);
+  auto const* const status = principia__ExternalFlowFreefallBatch(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial.data(),
+      initial.size(),
+      t_initial,
+      t_final,
+      batch_results.data(),
+      batch_results.size(),
+      errors.data(),
+      errors.size());
+  EXPECT_THAT(*status, IsOk());
+  EXPECT_THAT(
+      errors,
+      ElementsAre(0, static_cast<int>(absl::StatusCode::kOutOfRange), 0));
+
+  // The batch gives the same results as separate calls.
+  for (int i : {0, 2}) {
+    QP result;
+    auto const* const status = principia__ExternalFlowFreefall(
+        &plugin_,
+        SolarSystemFactory::Earth,
+        initial[i],
+        t_initial,
+        t_final,
+        &result);
+    EXPECT_THAT(*status, IsOk());
+    EXPECT_TRUE(result == batch_results[i]) << i;
+  }
+
+  // A final time too far in the future fails each body, not the batch.
+  auto const* const far_status = principia__ExternalFlowFreefallBatch(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial.data(),
+      initial.size(),
+      t_initial,
+      t_initial + 1e10,
+      batch_results.data(),
+      batch_results.size(),
+      errors.data(),
+      errors.size());
+  EXPECT_THAT(*far_status, IsOk());
+  EXPECT_THAT(errors,
+              Each(static_cast<int>(absl::StatusCode::kOutOfRange)));
+
+  auto const* const inconsistent_status = principia__ExternalFlowFreefallBatch(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial.data(),
+      initial.size(),
+      t_initial,
+      t_final,
+      batch_results.data(),
+      batch_results.size() - 1,
+      errors.data(),
+      errors.size());
+  EXPECT_THAT(*inconsistent_status, Not(IsOk()));
 }
 
 TEST_F(InterfaceExternalTest, Geopotential) {
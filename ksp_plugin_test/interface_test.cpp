@@ -40,8 +40,10 @@ using ::testing::DoAll;
 using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
 using ::testing::Invoke;
 using ::testing::IsNull;
+using ::testing::Not;
 using ::testing::NotNull;
 using ::testing::Pointee;
 using ::testing::Pointer;
@@ -612,6 +614,25 @@ TEST_F(InterfaceTest, Apocalypse) {
   EXPECT_THAT(details, IsNull());
 }
 
+TEST_F(InterfaceTest, MethodStatistics) {
+  char const* statistics;
+  principia__GetMethodStatistics(/*reset=*/true, &statistics);
+  principia__DeleteString(&statistics);
+
+  EXPECT_CALL(*plugin_, CurrentTime()).Times(2).WillRepeatedly(Return(t0_));
+  principia__CurrentTime(plugin_.get());
+  principia__CurrentTime(plugin_.get());
+  principia__GetMethodStatistics(/*reset=*/true, &statistics);
+  EXPECT_THAT(statistics, HasSubstr("\nCurrentTime\t2\t"));
+  // The call that reset the statistics is part of the new period.
+  EXPECT_THAT(statistics, HasSubstr("\nGetMethodStatistics\t1\t"));
+  principia__DeleteString(&statistics);
+
+  principia__GetMethodStatistics(/*reset=*/false, &statistics);
+  EXPECT_THAT(statistics, Not(HasSubstr("CurrentTime")));
+  principia__DeleteString(&statistics);
+}
+
 TEST_F(InterfaceTest, SerializePlugin) {
   PullSerializer* serializer = nullptr;
   auto const message = ParseFromBytes<principia::serialization::Plugin>(
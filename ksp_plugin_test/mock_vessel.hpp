@@ -30,6 +30,10 @@ class MockVessel : public Vessel {
               prediction,
               (),
               (const, override));
+  MOCK_METHOD(DiscreteTrajectory<Barycentric>::value_type,
+              last_psychohistory_point,
+              (),
+              (const, override));
 
   MOCK_METHOD(FlightPlan&, flight_plan, (), (const, override));
   MOCK_METHOD(bool, has_flight_plan, (), (const, override));
@@ -157,5 +157,70 @@ TEST_F(OrbitAnalyserTest, TOPEXPoséidon) {
                              Property(&OrbitRecurrence::Cᴛₒ, 10))));
 }
 
+TEST_F(OrbitAnalyserTest, IncrementalAnalysis) {
+  OrbitAnalyser analyser(ephemeris_.get(), DefaultHistoryParameters());
+  auto const& arc =
+      *topex_poséidon_.orbit(
+          {StandardProduct3::SatelliteGroup::General, 1}).front();
+  EXPECT_OK(ephemeris_->Prolong(arc.begin()->time));
+  OrbitAnalyser::Parameters parameters{
+      .first_time = arc.begin()->time,
+      .first_degrees_of_freedom = itrs_.FromThisFrameAtTime(arc.begin()->time)(
+          arc.begin()->degrees_of_freedom),
+      .mission_duration = 3 * Hour};
+  auto const analyse = [&analyser](OrbitAnalyser::Parameters const& p) {
+    analyser.RequestAnalysis(p);
+    do {
+      absl::SleepFor(absl::Milliseconds(10));
+      analyser.RefreshAnalysis();
+    } while (analyser.analysis() == nullptr ||
+             analyser.analysis()->mission_duration() <=
+                 p.mission_duration - 1 * Minute ||
+             analyser.analysis()->mission_duration() > p.mission_duration);
+  };
+
+  analyse(parameters);
+  EXPECT_THAT(analyser.analysis()
+                  ->elements()
+                  ->mean_semimajor_axis_interval()
+                  .midpoint(),
+              IsNear(7714_(1) * Kilo(Metre)));
+  auto const& first_elements = *analyser.analysis()->elements();
+  auto const first_semimajor_axis =
+      first_elements.mean_semimajor_axis_interval();
+  auto const first_eccentricity = first_elements.mean_eccentricity_interval();
+  auto const first_inclination = first_elements.mean_inclination_interval();
+  Time const first_nodal_period = first_elements.nodal_period();
+
+  // A longer mission extends the previous integration.
+  parameters.mission_duration = 6 * Hour;
+  analyse(parameters);
+  EXPECT_THAT(analyser.analysis()
+                  ->elements()
+                  ->mean_semimajor_axis_interval()
+                  .midpoint(),
+              IsNear(7714_(1) * Kilo(Metre)));
+
+  // A shorter mission only analyses the beginning of the integration, which
+  // has the same points as the first analysis, and therefore yields the same
+  // elements.
+  parameters.mission_duration = 3 * Hour;
+  analyse(parameters);
+  auto const& elements = *analyser.analysis()->elements();
+  EXPECT_EQ(first_semimajor_axis.min,
+            elements.mean_semimajor_axis_interval().min);
+  EXPECT_EQ(first_semimajor_axis.max,
+            elements.mean_semimajor_axis_interval().max);
+  EXPECT_EQ(first_eccentricity.min, elements.mean_eccentricity_interval().min);
+  EXPECT_EQ(first_eccentricity.max, elements.mean_eccentricity_interval().max);
+  EXPECT_EQ(first_inclination.min, elements.mean_inclination_interval().min);
+  EXPECT_EQ(first_inclination.max, elements.mean_inclination_interval().max);
+  EXPECT_EQ(first_nodal_period, elements.nodal_period());
+  EXPECT_THAT(analyser.analysis()->recurrence(),
+              Optional(AllOf(Property(&OrbitRecurrence::νₒ, 13),
+                             Property(&OrbitRecurrence::Dᴛₒ, -3),
+                             Property(&OrbitRecurrence::Cᴛₒ, 10))));
+}
+
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -1,12 +1,19 @@
 #include "ksp_plugin/pile_up.hpp"
 
+#include <cstddef>
+#include <iterator>
 #include <limits>
+#include <list>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "absl/status/status.h"
+#include "base/flags.hpp"
 #include "ksp_plugin/integrators.hpp"
+#include "ksp_plugin/lock_step_histories.hpp"
 #include "ksp_plugin/part.hpp"
 #include "geometry/r3x3_matrix.hpp"
 #include "geometry/r3_element.hpp"
@@ -27,6 +34,7 @@
 #include "testing_utilities/almost_equals.hpp"
 #include "testing_utilities/componentwise.hpp"
 #include "testing_utilities/matchers.hpp"
+#include "testing_utilities/numerics_matchers.hpp"
 #include "testing_utilities/vanishes_before.hpp"
 
 namespace principia {
@@ -37,12 +45,15 @@ using ::testing::DoAll;
 using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::IsEmpty;
+using ::testing::Lt;
 using ::testing::Matcher;
 using ::testing::MockFunction;
 using ::testing::Return;
+using ::testing::SizeIs;
 using ::testing::ReturnRef;
 using ::testing::_;
 using namespace principia::astronomy::_epoch;
+using namespace principia::base::_flags;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
@@ -57,6 +68,7 @@ using namespace principia::integrators::_symplectic_runge_kutta_nyström_integra
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
 using namespace principia::ksp_plugin::_integrators;
+using namespace principia::ksp_plugin::_lock_step_histories;
 using namespace principia::ksp_plugin::_part;
 using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::physics::_degrees_of_freedom;
@@ -72,6 +84,7 @@ using namespace principia::quantities::_si;
 using namespace principia::testing_utilities::_almost_equals;
 using namespace principia::testing_utilities::_componentwise;
 using namespace principia::testing_utilities::_matchers;
+using namespace principia::testing_utilities::_numerics_matchers;
 using namespace principia::testing_utilities::_vanishes_before;
 
 // A helper class to expose the internal state of a pile-up for testing.
@@ -103,6 +116,10 @@ class TestablePileUp : public PileUp {
   apparent_part_rigid_motion() const {
     return apparent_part_rigid_motion_;
   }
+
+  void set_min_parts_for_parallelism(std::size_t const min_parts) {
+    min_parts_for_parallelism_ = min_parts;
+  }
 };
 
 class PileUpTest : public testing::Test {
@@ -640,6 +657,480 @@ TEST_F(PileUpTest, MidStepIntrinsicForce) {
       AlmostEquals(old_velocity + 0.5 * fixed_step * a, 1));
 }
 
+// Checks that a pile-up large enough to have its parts processed in parallel
+// chunks yields exactly the same motions as when it is processed serially.
+TEST_F(PileUpTest, ParallelParts) {
+  // A tiny body very far, see |MidStepIntrinsicForce|.
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  bodies.emplace_back(make_not_null_unique<MassiveBody>(1 * Kilogram));
+  std::vector<DegreesOfFreedom<Barycentric>> initial_state{
+      DegreesOfFreedom<Barycentric>{
+          Barycentric::origin +
+              Displacement<Barycentric>(
+                  {std::pow(2, 100) * Metre, 0 * Metre, 0 * Metre}),
+          Barycentric::unmoving}};
+  Ephemeris<Barycentric> ephemeris{
+      std::move(bodies),
+      initial_state,
+      /*initial_time=*/J2000,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Metre,
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<Barycentric>::FixedStepParameters{
+          SymplecticRungeKuttaNyströmIntegrator<
+              BlanesMoan2002SRKN6B,
+              Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+          1 * Second}};
+
+  // More than the threshold for parallelism, and not a multiple of the chunk
+  // size, so that the last chunk is partial.
+  constexpr int number_of_parts = 130;
+  std::vector<std::unique_ptr<Part>> parallel_parts;
+  std::vector<std::unique_ptr<Part>> serial_parts;
+  std::list<not_null<Part*>> parallel_pile_up_parts;
+  std::list<not_null<Part*>> serial_pile_up_parts;
+  for (int i = 0; i < number_of_parts; ++i) {
+    DegreesOfFreedom<Barycentric> const degrees_of_freedom(
+        Barycentric::origin +
+            Displacement<Barycentric>(
+                {i * Metre, (i % 7) * Metre, (i % 11) * Metre}),
+        Velocity<Barycentric>({10 * Metre / Second,
+                               (i % 5) * Metre / Second,
+                               (i % 3) * Metre / Second}));
+    for (auto* const parts : {&parallel_parts, &serial_parts}) {
+      parts->push_back(std::make_unique<Part>(
+          part_id1_ + i,
+          "p",
+          mass1_ + (i % 13) * Kilogram,
+          EccentricPart::origin,
+          inertia_tensor1_,
+          RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+              degrees_of_freedom),
+          /*deletion_callback=*/nullptr));
+    }
+    parallel_pile_up_parts.push_back(parallel_parts.back().get());
+    serial_pile_up_parts.push_back(serial_parts.back().get());
+  }
+  TestablePileUp parallel_pile_up(parallel_pile_up_parts,
+                                  J2000,
+                                  DefaultPsychohistoryParameters(),
+                                  DefaultHistoryParameters(),
+                                  &ephemeris,
+                                  /*deletion_callback=*/nullptr);
+  TestablePileUp serial_pile_up(serial_pile_up_parts,
+                                J2000,
+                                DefaultPsychohistoryParameters(),
+                                DefaultHistoryParameters(),
+                                &ephemeris,
+                                /*deletion_callback=*/nullptr);
+  serial_pile_up.set_min_parts_for_parallelism(
+      std::numeric_limits<std::size_t>::max());
+
+  for (int step = 1; step <= 3; ++step) {
+    Instant const t = J2000 + step * 7.5 * Second;
+    // Report slightly deformed apparent motions, identical for both pile-ups,
+    // so that the pile-ups go through the deformation code.
+    for (auto const& parts : {&parallel_parts, &serial_parts}) {
+      TestablePileUp& pile_up =
+          parts == &parallel_parts ? parallel_pile_up : serial_pile_up;
+      for (int i = 0; i < number_of_parts; ++i) {
+        Part& part = *(*parts)[i];
+        auto const degrees_of_freedom =
+            part.rigid_motion()({RigidPart::origin, RigidPart::unmoving});
+        DegreesOfFreedom<Apparent> const apparent_degrees_of_freedom(
+            Apparent::origin +
+                Displacement<Apparent>(
+                    (degrees_of_freedom.position() - Barycentric::origin)
+                        .coordinates()) +
+                Displacement<Apparent>(
+                    {(i % 3) * Milli(Metre), 0 * Metre, step * Milli(Metre)}),
+            Velocity<Apparent>(degrees_of_freedom.velocity().coordinates()));
+        pile_up.SetPartApparentRigidMotion(
+            &part,
+            RigidMotion<RigidPart, Apparent>::MakeNonRotatingMotion(
+                apparent_degrees_of_freedom));
+      }
+    }
+    EXPECT_OK(parallel_pile_up.DeformAndAdvanceTime(t));
+    EXPECT_OK(serial_pile_up.DeformAndAdvanceTime(t));
+
+    for (int i = 0; i < number_of_parts; ++i) {
+      Part& parallel_part = *parallel_parts[i];
+      Part& serial_part = *serial_parts[i];
+      auto const parallel_degrees_of_freedom = parallel_part.rigid_motion()(
+          {RigidPart::origin, RigidPart::unmoving});
+      auto const serial_degrees_of_freedom = serial_part.rigid_motion()(
+          {RigidPart::origin, RigidPart::unmoving});
+      EXPECT_EQ(parallel_degrees_of_freedom.position(),
+                serial_degrees_of_freedom.position()) << i;
+      EXPECT_EQ(parallel_degrees_of_freedom.velocity(),
+                serial_degrees_of_freedom.velocity()) << i;
+      auto const parallel_history_back = std::prev(parallel_part.history_end());
+      auto const serial_history_back = std::prev(serial_part.history_end());
+      EXPECT_EQ(parallel_history_back->time, serial_history_back->time) << i;
+      EXPECT_EQ(parallel_history_back->degrees_of_freedom,
+                serial_history_back->degrees_of_freedom) << i;
+      auto const parallel_psychohistory_back =
+          std::prev(parallel_part.psychohistory_end());
+      auto const serial_psychohistory_back =
+          std::prev(serial_part.psychohistory_end());
+      EXPECT_EQ(parallel_psychohistory_back->time,
+                serial_psychohistory_back->time) << i;
+      EXPECT_EQ(parallel_psychohistory_back->degrees_of_freedom,
+                serial_psychohistory_back->degrees_of_freedom) << i;
+    }
+  }
+}
+
+// A fixture for pile-ups coasting around an Earth, possibly perturbed by a
+// Moon-like body.
+class PileUpCoastTest : public PileUpTest {
+ protected:
+  // Returns an ephemeris with an Earth at the origin and, if
+  // |perturber_distance| is given, a Moon-like body at that distance on the x
+  // axis.
+  not_null<std::unique_ptr<Ephemeris<Barycentric>>> MakeEphemeris(
+      std::optional<Length> const& perturber_distance) const {
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    std::vector<DegreesOfFreedom<Barycentric>> initial_state;
+    bodies.emplace_back(make_not_null_unique<MassiveBody>(μ_));
+    initial_state.emplace_back(Barycentric::origin, Barycentric::unmoving);
+    if (perturber_distance.has_value()) {
+      bodies.emplace_back(make_not_null_unique<MassiveBody>(perturber_μ_));
+      initial_state.emplace_back(
+          Barycentric::origin +
+              Displacement<Barycentric>(
+                  {*perturber_distance, 0 * Metre, 0 * Metre}),
+          Velocity<Barycentric>({0 * Metre / Second,
+                                 Sqrt(μ_ / *perturber_distance),
+                                 0 * Metre / Second}));
+    }
+    return make_not_null_unique<Ephemeris<Barycentric>>(
+        std::move(bodies),
+        initial_state,
+        /*initial_time=*/J2000,
+        /*accuracy_parameters=*/Ephemeris<Barycentric>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Milli(Metre),
+            /*geopotential_tolerance=*/0x1p-24),
+        Ephemeris<Barycentric>::FixedStepParameters(
+            SymplecticRungeKuttaNyströmIntegrator<
+                BlanesMoan2002SRKN6B,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            /*step=*/1 * Minute));
+  }
+
+  // Returns a part on a circular orbit of radius |r_| around the Earth.
+  not_null<std::unique_ptr<Part>> MakePart(PartId const part_id) const {
+    return MakePart(part_id, r_);
+  }
+
+  // Returns a part on a circular orbit of radius |r| around the Earth.
+  not_null<std::unique_ptr<Part>> MakePart(PartId const part_id,
+                                           Length const& r) const {
+    DegreesOfFreedom<Barycentric> const degrees_of_freedom(
+        Barycentric::origin +
+            Displacement<Barycentric>({r, 0 * Metre, 0 * Metre}),
+        Velocity<Barycentric>(
+            {0 * Metre / Second, Sqrt(μ_ / r), 0 * Metre / Second}));
+    return make_not_null_unique<Part>(
+        part_id,
+        "p",
+        mass1_,
+        EccentricPart::origin,
+        inertia_tensor1_,
+        RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+            degrees_of_freedom),
+        /*deletion_callback=*/nullptr);
+  }
+
+  static not_null<std::unique_ptr<TestablePileUp>> MakePileUp(
+      not_null<Part*> const part,
+      not_null<Ephemeris<Barycentric>*> const ephemeris) {
+    return make_not_null_unique<TestablePileUp>(
+        std::list<not_null<Part*>>{part},
+        J2000,
+        DefaultPsychohistoryParameters(),
+        DefaultHistoryParameters(),
+        ephemeris,
+        /*deletion_callback=*/nullptr);
+  }
+
+  // Advances the |pile_ups| together until |t_max| by steps of
+  // |coast_step_|, and then nudges their parts.
+  void Coast(std::vector<not_null<TestablePileUp*>> const& pile_ups,
+             Instant const& t_max) const {
+    for (Instant t = J2000 + coast_step_; t <= t_max; t += coast_step_) {
+      for (not_null<TestablePileUp*> const pile_up : pile_ups) {
+        EXPECT_OK(pile_up->AdvanceTime(t));
+      }
+    }
+    for (not_null<TestablePileUp*> const pile_up : pile_ups) {
+      pile_up->NudgeParts();
+    }
+  }
+
+  static DegreesOfFreedom<Barycentric> PartDegreesOfFreedom(Part const& part) {
+    return part.rigid_motion()({RigidPart::origin, RigidPart::unmoving});
+  }
+
+  GravitationalParameter const μ_ =
+      398600.4418 * Pow<3>(Kilo(Metre)) / Pow<2>(Second);
+  GravitationalParameter const perturber_μ_ =
+      4902.8 * Pow<3>(Kilo(Metre)) / Pow<2>(Second);
+  Length const r_ = 7000 * Kilo(Metre);
+  Time const coast_step_ = 15 * Second;
+};
+
+// Checks that the Keplerian propagation of a pile-up agrees with its
+// integration when there are no perturbations.
+TEST_F(PileUpCoastTest, KeplerCoast) {
+  auto const ephemeris = MakeEphemeris(/*perturber_distance=*/std::nullopt);
+  auto const integrated_part = MakePart(part_id1_);
+  auto const keplerian_part = MakePart(part_id2_);
+  auto const integrated_pile_up =
+      MakePileUp(integrated_part.get(), ephemeris.get());
+  auto const keplerian_pile_up =
+      MakePileUp(keplerian_part.get(), ephemeris.get());
+
+  Coast({integrated_pile_up.get()}, J2000 + 1 * Hour);
+  {
+    ScopedFlag const kepler_coast("kepler_coast", "");
+    Coast({keplerian_pile_up.get()}, J2000 + 1 * Hour);
+  }
+
+  auto const integrated_degrees_of_freedom =
+      PartDegreesOfFreedom(*integrated_part);
+  auto const keplerian_degrees_of_freedom =
+      PartDegreesOfFreedom(*keplerian_part);
+  EXPECT_THAT(keplerian_degrees_of_freedom.position(),
+              AbsoluteErrorFrom(integrated_degrees_of_freedom.position(),
+                                Lt(1 * Metre)));
+  EXPECT_THAT(keplerian_degrees_of_freedom.velocity(),
+              AbsoluteErrorFrom(integrated_degrees_of_freedom.velocity(),
+                                Lt(1 * Milli(Metre) / Second)));
+  EXPECT_EQ(std::prev(keplerian_part->history_end())->time,
+            std::prev(integrated_part->history_end())->time);
+}
+
+// Checks that a pile-up whose Keplerian orbit is too perturbed falls back to
+// the integration.
+TEST_F(PileUpCoastTest, KeplerCoastFallback) {
+  // The tidal acceleration of the perturber is about 8e-5 m/s², which exceeds
+  // the tolerances over the very first step.
+  auto const ephemeris =
+      MakeEphemeris(/*perturber_distance=*/100'000 * Kilo(Metre));
+  auto const integrated_part = MakePart(part_id1_);
+  auto const keplerian_part = MakePart(part_id2_);
+  auto const integrated_pile_up =
+      MakePileUp(integrated_part.get(), ephemeris.get());
+  auto const keplerian_pile_up =
+      MakePileUp(keplerian_part.get(), ephemeris.get());
+
+  Coast({integrated_pile_up.get()}, J2000 + 1 * Hour);
+  {
+    ScopedFlag const kepler_coast("kepler_coast", "");
+    Coast({keplerian_pile_up.get()}, J2000 + 1 * Hour);
+  }
+
+  // The pile-up was integrated throughout, exactly like the one without the
+  // flag.
+  EXPECT_EQ(PartDegreesOfFreedom(*keplerian_part),
+            PartDegreesOfFreedom(*integrated_part));
+  EXPECT_EQ(std::prev(keplerian_part->history_end())->degrees_of_freedom,
+            std::prev(integrated_part->history_end())->degrees_of_freedom);
+}
+
+// Checks that the histories integrated in lock-step are exactly those
+// integrated separately.
+TEST_F(PileUpCoastTest, LockStepHistories) {
+  auto const ephemeris = MakeEphemeris(/*perturber_distance=*/std::nullopt);
+  LockStepHistories lock_step_histories(ephemeris.get(),
+                                        DefaultHistoryParameters());
+
+  // Two orbits, each followed by a pile-up integrated separately and by one
+  // integrated in the group.
+  std::vector<not_null<std::unique_ptr<Part>>> separate_parts;
+  std::vector<not_null<std::unique_ptr<Part>>> lock_step_parts;
+  std::vector<not_null<std::unique_ptr<TestablePileUp>>> separate_pile_ups;
+  std::vector<not_null<std::unique_ptr<TestablePileUp>>> lock_step_pile_ups;
+  for (int i = 0; i < 2; ++i) {
+    Length const r = (i + 1) * r_;
+    separate_parts.push_back(MakePart(part_id1_ + i, r));
+    lock_step_parts.push_back(MakePart(part_id2_ + i, r));
+    separate_pile_ups.push_back(
+        MakePileUp(separate_parts.back().get(), ephemeris.get()));
+    lock_step_pile_ups.push_back(
+        MakePileUp(lock_step_parts.back().get(), ephemeris.get()));
+    lock_step_pile_ups.back()->SetLockStepHistories(&lock_step_histories);
+  }
+
+  Coast({separate_pile_ups[0].get(),
+         separate_pile_ups[1].get(),
+         lock_step_pile_ups[0].get(),
+         lock_step_pile_ups[1].get()},
+        J2000 + 1 * Hour);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_FALSE(lock_step_histories.Contains(separate_pile_ups[i].get()));
+    EXPECT_TRUE(lock_step_histories.Contains(lock_step_pile_ups[i].get()));
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    Part& separate_part = *separate_parts[i];
+    Part& lock_step_part = *lock_step_parts[i];
+    EXPECT_EQ(PartDegreesOfFreedom(lock_step_part),
+              PartDegreesOfFreedom(separate_part));
+    auto separate_it = separate_part.history_begin();
+    auto lock_step_it = lock_step_part.history_begin();
+    for (; separate_it != separate_part.history_end() &&
+           lock_step_it != lock_step_part.history_end();
+         ++separate_it, ++lock_step_it) {
+      EXPECT_EQ(lock_step_it->time, separate_it->time);
+      EXPECT_EQ(lock_step_it->degrees_of_freedom,
+                separate_it->degrees_of_freedom) << lock_step_it->time;
+    }
+    EXPECT_TRUE(separate_it == separate_part.history_end());
+    EXPECT_TRUE(lock_step_it == lock_step_part.history_end());
+  }
+
+  // Detaching a pile-up removes it from the group.
+  lock_step_pile_ups[0]->SetLockStepHistories(nullptr);
+  EXPECT_FALSE(lock_step_histories.Contains(lock_step_pile_ups[0].get()));
+  EXPECT_TRUE(lock_step_histories.Contains(lock_step_pile_ups[1].get()));
+}
+
+// Checks that a pile-up that is behind the group is brought to its time with
+// the adaptive integrator when it joins, and that a pile-up that is ahead of
+// the group or uses other parameters cannot join.
+TEST_F(PileUpCoastTest, LockStepHistoriesAdd) {
+  auto const ephemeris = MakeEphemeris(/*perturber_distance=*/std::nullopt);
+  LockStepHistories lock_step_histories(ephemeris.get(),
+                                        DefaultHistoryParameters());
+  auto const member_part = MakePart(part_id1_);
+  auto const joining_part = MakePart(part_id2_);
+  auto const member = MakePileUp(member_part.get(), ephemeris.get());
+  auto const joining = MakePileUp(joining_part.get(), ephemeris.get());
+  member->SetLockStepHistories(&lock_step_histories);
+  Instant const group_time = J2000 + 2 * Minute;
+  Coast({member.get()}, group_time);
+  ASSERT_TRUE(lock_step_histories.Contains(member.get()));
+
+  DegreesOfFreedom<Barycentric> const joining_degrees_of_freedom =
+      PartDegreesOfFreedom(*joining_part);
+  EXPECT_FALSE(lock_step_histories.Add(
+      joining.get(),
+      group_time + 1 * Second,
+      joining_degrees_of_freedom,
+      DefaultHistoryParameters(),
+      DefaultPsychohistoryParameters()));
+  EXPECT_FALSE(lock_step_histories.Add(
+      joining.get(),
+      J2000,
+      joining_degrees_of_freedom,
+      Ephemeris<Barycentric>::FixedStepParameters(
+          DefaultHistoryParameters().integrator(),
+          2 * DefaultHistoryParameters().step()),
+      DefaultPsychohistoryParameters()));
+  EXPECT_FALSE(lock_step_histories.Contains(joining.get()));
+
+  DiscreteTrajectory<Barycentric> expected_history;
+  EXPECT_OK(expected_history.Append(J2000, joining_degrees_of_freedom));
+  EXPECT_OK(ephemeris->FlowWithAdaptiveStep(
+      &expected_history,
+      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+      group_time,
+      DefaultPsychohistoryParameters(),
+      Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
+
+  EXPECT_TRUE(lock_step_histories.Add(joining.get(),
+                                      J2000,
+                                      joining_degrees_of_freedom,
+                                      DefaultHistoryParameters(),
+                                      DefaultPsychohistoryParameters()));
+  EXPECT_TRUE(lock_step_histories.Contains(joining.get()));
+  DiscreteTrajectory<Barycentric> history;
+  EXPECT_OK(history.Append(J2000, joining_degrees_of_freedom));
+  EXPECT_TRUE(
+      lock_step_histories.FlowHistory(joining.get(), group_time, history));
+  // Only the point at the time of the group is part of the history.
+  EXPECT_EQ(2, history.size());
+  EXPECT_EQ(group_time, history.back().time);
+  EXPECT_EQ(expected_history.back().degrees_of_freedom,
+            history.back().degrees_of_freedom);
+}
+
+// Checks that the group is dissolved when its integration fails.
+TEST_F(PileUpCoastTest, LockStepHistoriesDissolve) {
+  MockEphemeris<Barycentric> ephemeris;
+  LockStepHistories lock_step_histories(&ephemeris,
+                                        DefaultHistoryParameters());
+  auto const part1 = MakePart(part_id1_);
+  auto const part2 = MakePart(part_id2_);
+  auto const pile_up1 = MakePileUp(part1.get(), &ephemeris);
+  auto const pile_up2 = MakePileUp(part2.get(), &ephemeris);
+  DegreesOfFreedom<Barycentric> const degrees_of_freedom =
+      PartDegreesOfFreedom(*part1);
+  for (auto const& pile_up : {pile_up1.get(), pile_up2.get()}) {
+    EXPECT_TRUE(lock_step_histories.Add(pile_up,
+                                        J2000,
+                                        degrees_of_freedom,
+                                        DefaultHistoryParameters(),
+                                        DefaultPsychohistoryParameters()));
+  }
+
+  Instant const t = J2000 + 1 * Minute;
+  auto instance = make_not_null_unique<MockFixedStepSizeIntegrator<
+      Ephemeris<Barycentric>::NewtonianMotionEquation>::MockInstance>();
+  EXPECT_CALL(ephemeris, NewInstance(SizeIs(2), _, _))
+      .WillOnce(Return(ByMove(std::move(instance))));
+  EXPECT_CALL(ephemeris, FlowWithFixedStep(t, _))
+      .WillOnce(Return(absl::OutOfRangeError("Collision")));
+  DiscreteTrajectory<Barycentric> history;
+  EXPECT_OK(history.Append(J2000, degrees_of_freedom));
+  EXPECT_FALSE(lock_step_histories.FlowHistory(pile_up1.get(), t, history));
+  EXPECT_EQ(1, history.size());
+  EXPECT_FALSE(lock_step_histories.Contains(pile_up1.get()));
+  EXPECT_FALSE(lock_step_histories.Contains(pile_up2.get()));
+  // The other pile-up finds out that it must integrate on its own.
+  EXPECT_FALSE(lock_step_histories.FlowHistory(pile_up2.get(), t, history));
+}
+
+// Checks that a pile-up leaves the group when it thrusts and joins it again
+// when it stops.
+TEST_F(PileUpCoastTest, LockStepHistoriesThrust) {
+  auto const ephemeris = MakeEphemeris(/*perturber_distance=*/std::nullopt);
+  LockStepHistories lock_step_histories(ephemeris.get(),
+                                        DefaultHistoryParameters());
+  auto const coasting_part = MakePart(part_id1_);
+  auto const thrusting_part = MakePart(part_id2_);
+  auto const coasting = MakePileUp(coasting_part.get(), ephemeris.get());
+  auto const thrusting = MakePileUp(thrusting_part.get(), ephemeris.get());
+  coasting->SetLockStepHistories(&lock_step_histories);
+  thrusting->SetLockStepHistories(&lock_step_histories);
+  Instant t = J2000 + 1 * Minute;
+  Coast({coasting.get(), thrusting.get()}, t);
+  EXPECT_TRUE(lock_step_histories.Contains(thrusting.get()));
+
+  thrusting_part->apply_intrinsic_force(
+      Vector<Force, Barycentric>({1 * Newton, 0 * Newton, 0 * Newton}));
+  thrusting->RecomputeFromParts();
+  t += coast_step_;
+  EXPECT_OK(coasting->AdvanceTime(t));
+  EXPECT_OK(thrusting->AdvanceTime(t));
+  EXPECT_TRUE(lock_step_histories.Contains(coasting.get()));
+  EXPECT_FALSE(lock_step_histories.Contains(thrusting.get()));
+
+  // The history of the pile-up ends at |t|, which is behind the group once it
+  // has been advanced, so the gap must be bridged when joining.
+  thrusting_part->clear_intrinsic_force();
+  thrusting->RecomputeFromParts();
+  t += coast_step_;
+  EXPECT_OK(coasting->AdvanceTime(t));
+  EXPECT_OK(thrusting->AdvanceTime(t));
+  EXPECT_TRUE(lock_step_histories.Contains(coasting.get()));
+  EXPECT_TRUE(lock_step_histories.Contains(thrusting.get()));
+  EXPECT_EQ(std::prev(coasting_part->history_end())->time,
+            std::prev(thrusting_part->history_end())->time);
+}
+
 TEST_F(PileUpTest, Serialization) {
   MockEphemeris<Barycentric> ephemeris;
   p1_.apply_intrinsic_force(
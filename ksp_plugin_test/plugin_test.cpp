@@ -444,6 +444,21 @@ TEST_F(PluginTest, Serialization) {
   second_message.mutable_vessel(0)->mutable_vessel()
       ->mutable_history()->mutable_segment(0)->clear_zfp();
   EXPECT_THAT(message, EqualsProto(second_message));
+
+  // The trajectory of the unloaded vessel has not been deserialized.  Advance
+  // it and save again: the points recorded since the load must be written.
+  plugin->InsertOrKeepVessel(satellite,
+                             "v" + satellite,
+                             SolarSystemFactory::Earth,
+                             /*loaded=*/false,
+                             inserted);
+  plugin->AdvanceTime(HistoryTime(time, 9), Angle());
+  plugin->CatchUpLaggingVessels(collided_vessels);
+  serialization::Plugin third_message;
+  plugin->WriteToMessage(&third_message);
+  EXPECT_LT(7,
+            third_message.vessel(0).vessel().history().segment(0).zfp()
+                .timeline_size());
 }
 
 TEST_F(PluginTest, Initialization) {
@@ -817,6 +832,17 @@ TEST_F(PluginTest, UpdateCelestialHierarchy) {
   }
 }
 
+TEST_F(PluginTest, EphemerisCompression) {
+  InsertAllSolarSystemBodies();
+  plugin_->EndInitialization();
+  Instant const t = ParseTT(initial_time_) + 1 * Hour;
+  EXPECT_CALL(plugin_->mock_ephemeris(), Prolong(t));
+  // The old polynomials are compressed as time advances.
+  EXPECT_CALL(plugin_->mock_ephemeris(),
+              CompressTrajectoriesBefore(t - 30 * Day));
+  plugin_->AdvanceTime(t, 0 * Radian);
+}
+
 TEST_F(PluginTest, Navball) {
   // Create a plugin with planetarium rotation 0.
   Plugin plugin(initial_time_,
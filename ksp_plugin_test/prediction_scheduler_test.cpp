@@ -0,0 +1,149 @@
+#include "ksp_plugin/prediction_scheduler.hpp"
+
+#include <string>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "base/jthread.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "ksp_plugin_test/mock_vessel.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+
+using ::testing::ElementsAre;
+using namespace principia::base::_jthread;
+using namespace principia::ksp_plugin::_prediction_scheduler;
+using namespace principia::ksp_plugin::_vessel;
+
+class PredictionSchedulerTest : public testing::Test {
+ protected:
+  PredictionSchedulerTest() : scheduler_(/*number_of_workers=*/1) {}
+
+  // Occupies the single worker of the scheduler until |release_| is notified.
+  void BlockWorker() {
+    scheduler_.Submit(&blocker_,
+                      PredictionScheduler::Priority::ActiveVessel,
+                      [this]() {
+                        blocked_.Notify();
+                        release_.WaitForNotification();
+                      });
+    blocked_.WaitForNotification();
+  }
+
+  // Returns a task that records |name| in |log_| and notifies |done| if it is
+  // not null.
+  PredictionScheduler::Task Log(char const* const name,
+                                absl::Notification* const done = nullptr) {
+    return [this, name, done]() {
+      {
+        absl::MutexLock l(&lock_);
+        log_.push_back(name);
+      }
+      if (done != nullptr) {
+        done->Notify();
+      }
+    };
+  }
+
+  MockVessel blocker_;
+  MockVessel vessel1_;
+  MockVessel vessel2_;
+  MockVessel vessel3_;
+  absl::Notification blocked_;
+  absl::Notification release_;
+  absl::Mutex lock_;
+  std::vector<std::string> log_ GUARDED_BY(lock_);
+  // Declared last so that the workers are stopped before the rest of the
+  // fixture is destroyed.
+  PredictionScheduler scheduler_;
+};
+
+TEST_F(PredictionSchedulerTest, Priorities) {
+  BlockWorker();
+  absl::Notification done;
+  scheduler_.Submit(&vessel1_,
+                    PredictionScheduler::Priority::Visible,
+                    Log("visible", &done));
+  scheduler_.Submit(&vessel2_,
+                    PredictionScheduler::Priority::FlightPlan,
+                    Log("flight plan"));
+  scheduler_.Submit(&vessel3_,
+                    PredictionScheduler::Priority::ActiveVessel,
+                    Log("active vessel"));
+  EXPECT_EQ(3, scheduler_.statistics().queue_depth);
+  release_.Notify();
+  done.WaitForNotification();
+
+  absl::MutexLock l(&lock_);
+  EXPECT_THAT(log_, ElementsAre("active vessel", "flight plan", "visible"));
+}
+
+TEST_F(PredictionSchedulerTest, Supersession) {
+  BlockWorker();
+  absl::Notification done;
+  scheduler_.Submit(&vessel1_,
+                    PredictionScheduler::Priority::Visible,
+                    Log("first"));
+  scheduler_.Submit(&vessel2_,
+                    PredictionScheduler::Priority::Visible,
+                    Log("other", &done));
+  scheduler_.Submit(&vessel1_,
+                    PredictionScheduler::Priority::Visible,
+                    Log("second"));
+  EXPECT_EQ(2, scheduler_.statistics().queue_depth);
+  release_.Notify();
+  done.WaitForNotification();
+
+  {
+    absl::MutexLock l(&lock_);
+    // The superseding request keeps the place of the superseded one.
+    EXPECT_THAT(log_, ElementsAre("second", "other"));
+  }
+
+  // The statistics of a request are recorded after it completes, so run
+  // another one to make sure that they are up-to-date.
+  absl::Notification flushed;
+  scheduler_.Submit(&vessel3_,
+                    PredictionScheduler::Priority::ActiveVessel,
+                    [&flushed]() { flushed.Notify(); });
+  flushed.WaitForNotification();
+  auto const statistics = scheduler_.statistics();
+  auto const& visible = statistics.latencies[static_cast<int>(
+      PredictionScheduler::Priority::Visible)];
+  EXPECT_EQ(0, statistics.queue_depth);
+  EXPECT_EQ(2, visible.completed);
+  EXPECT_EQ(1, visible.superseded);
+}
+
+TEST_F(PredictionSchedulerTest, Cancel) {
+  absl::Notification running;
+  bool stopped = false;
+  scheduler_.Submit(&vessel1_,
+                    PredictionScheduler::Priority::ActiveVessel,
+                    [&running, &stopped]() {
+                      running.Notify();
+                      auto const stop_token =
+                          this_stoppable_thread::get_stop_token();
+                      while (!stop_token.stop_requested()) {
+                      }
+                      stopped = true;
+                    });
+  running.WaitForNotification();
+  scheduler_.Cancel(&vessel1_);
+  EXPECT_TRUE(stopped);
+
+  // The scheduler still works after a cancellation.
+  absl::Notification done;
+  scheduler_.Submit(&vessel1_,
+                    PredictionScheduler::Priority::ActiveVessel,
+                    Log("after", &done));
+  done.WaitForNotification();
+  absl::MutexLock l(&lock_);
+  EXPECT_THAT(log_, ElementsAre("after"));
+}
+
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -7,8 +7,10 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
 #include "astronomy/time_scales.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/r3x3_matrix.hpp"
@@ -45,12 +47,15 @@ using ::testing::DoAll;
 using ::testing::ElementsAre;
 using ::testing::Ge;
 using ::testing::Le;
+using ::testing::Mock;
 using ::testing::MockFunction;
+using ::testing::Property;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ::testing::_;
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
@@ -374,6 +379,96 @@ TEST_F(VesselTest, PredictBeyondTheInfinite) {
   }
 }
 
+TEST_F(VesselTest, PredictionExtension) {
+  EXPECT_CALL(ephemeris_, t_min_locked())
+      .WillRepeatedly(Return(t0_));
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 2 * Second));
+  auto const barycentre = Barycentre<DegreesOfFreedom<Barycentric>, Mass>(
+      {p1_dof_, p2_dof_}, {mass1_, mass2_});
+  std::int64_t const max_steps = DefaultPredictionParameters().max_steps();
+
+  // The initial prediction, until t_max.  This call only happens once: the
+  // prediction is not recomputed after the vessel has coasted along it.
+  auto const expected_vessel_prediction =
+      NewLinearTrajectoryTimeline(barycentre,
+                                  /*Δt=*/0.5 * Second,
+                                  /*t1=*/t0_,
+                                  /*t2=*/t0_ + 2.5 * Second);
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+      .WillOnce(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction),
+          Return(absl::OkStatus())));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _,
+                  _,
+                  InfiniteFuture,
+                  Property(&Ephemeris<Barycentric>::AdaptiveStepParameters::
+                               max_steps,
+                           max_steps),
+                  _))
+      .WillOnce(Return(absl::OkStatus()));
+
+  // The extension, which starts at the end of the prediction, after t_max, and
+  // may only use the steps that are not used by the 3 intervals of the
+  // prediction.
+  auto const expected_vessel_extension =
+      NewLinearTrajectoryTimeline(barycentre,
+                                  /*Δt=*/0.5 * Second,
+                                  /*t0=*/t0_,
+                                  /*t1=*/t0_ + 2.5 * Second,
+                                  /*t2=*/t0_ + 4.5 * Second);
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _,
+                  _,
+                  InfiniteFuture,
+                  Property(&Ephemeris<Barycentric>::AdaptiveStepParameters::
+                               max_steps,
+                           max_steps - 3),
+                  _))
+      .WillOnce(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_extension),
+          Return(absl::OkStatus())));
+
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+  vessel_.RefreshPrediction();
+  EXPECT_EQ(t0_ + 2 * Second, vessel_.prediction()->back().time);
+
+  // The parts coast along the prediction, at times that are not those of the
+  // points of the prediction.
+  AppendTrajectoryTimeline<Barycentric>(
+      NewLinearTrajectoryTimeline<Barycentric>(p1_dof_,
+                                               /*Δt=*/0.25 * Second,
+                                               /*t0=*/t0_,
+                                               /*t1=*/t0_ + 0.25 * Second,
+                                               /*t2=*/t0_ + 1 * Second),
+      [this](Instant const& time,
+             DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+        p1_->AppendToHistory(time, degrees_of_freedom);
+      });
+  AppendTrajectoryTimeline<Barycentric>(
+      NewLinearTrajectoryTimeline<Barycentric>(p2_dof_,
+                                               /*Δt=*/0.25 * Second,
+                                               /*t0=*/t0_,
+                                               /*t1=*/t0_ + 0.25 * Second,
+                                               /*t2=*/t0_ + 1 * Second),
+      [this](Instant const& time,
+             DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+        p2_->AppendToHistory(time, degrees_of_freedom);
+      });
+  vessel_.AdvanceTime();
+  vessel_.RefreshPrediction();
+
+  EXPECT_EQ(8, vessel_.prediction()->size());
+  EXPECT_EQ(t0_ + 0.75 * Second, vessel_.prediction()->front().time);
+  EXPECT_EQ(t0_ + 4 * Second, vessel_.prediction()->back().time);
+  EXPECT_EQ(t0_ + 2 * Second,
+            std::next(vessel_.prediction()->begin(), 3)->time);
+}
+
 TEST_F(VesselTest, FlightPlan) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 2 * Second));
@@ -821,18 +916,143 @@ TEST_F(VesselTest, SerializationSuccess) {
   EXPECT_TRUE(message.has_history());
   EXPECT_FALSE(message.flight_plans().empty());
 
-  EXPECT_CALL(ephemeris_, Prolong(_)).Times(2);
+  // Reading the flight plan prolongs the ephemeris.  The trajectory, which
+  // hasn't changed, is written back without being deserialized, so it doesn't
+  // prolong the ephemeris.
+  EXPECT_CALL(ephemeris_, Prolong(_)).Times(1);
   auto const v = Vessel::ReadFromMessage(
       message, &celestial_, &ephemeris_, /*deletion_callback=*/nullptr);
   EXPECT_TRUE(v->has_flight_plan());
   v->ReadFlightPlanFromMessage();
 
   serialization::Vessel second_message;
+  v->PrepareForSerialization();
   v->WriteToMessage(&second_message,
                     serialization_index_for_pile_up.AsStdFunction());
   EXPECT_THAT(message, EqualsProto(second_message));
 }
 
+TEST_F(VesselTest, SerializationBackgroundDeserialization) {
+  MockFunction<int(not_null<PileUp const*>)>
+      serialization_index_for_pile_up;
+  EXPECT_CALL(serialization_index_for_pile_up, Call(_)).Times(0);
+
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 2 * Second));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+      .Times(AnyNumber());
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+
+  serialization::Vessel message;
+  vessel_.WriteToMessage(&message,
+                         serialization_index_for_pile_up.AsStdFunction());
+
+  // Each vessel prolongs the ephemeris when its trajectory is deserialized,
+  // which doesn't happen for the last one.
+  EXPECT_CALL(ephemeris_, Prolong(_)).Times(2);
+  ThreadPool<absl::Status> thread_pool(/*pool_size=*/1);
+  {
+    auto const v = Vessel::ReadFromMessage(
+        message, &celestial_, &ephemeris_, /*deletion_callback=*/nullptr);
+    v->RequestTrajectoryDeserialization(thread_pool);
+    // Racing with the deserialization is fine.
+    EXPECT_EQ(vessel_.trajectory().back().time, v->trajectory().back().time);
+
+    serialization::Vessel second_message;
+    v->WriteToMessage(&second_message,
+                      serialization_index_for_pile_up.AsStdFunction());
+    EXPECT_THAT(message, EqualsProto(second_message));
+  }
+  {
+    // Accessing the trajectory deserializes it, independently of the thread
+    // pool.
+    auto const v = Vessel::ReadFromMessage(
+        message, &celestial_, &ephemeris_, /*deletion_callback=*/nullptr);
+    v->RequestTrajectoryDeserialization(thread_pool);
+    EXPECT_EQ(vessel_.psychohistory()->back().time,
+              v->psychohistory()->back().time);
+  }
+  {
+    // The vessel may be destroyed before its trajectory has been deserialized.
+    // Block the thread pool to make sure that it is.
+    absl::Notification destroyed;
+    thread_pool.Add([&destroyed]() {
+      destroyed.WaitForNotification();
+      return absl::OkStatus();
+    });
+    std::unique_ptr<Vessel> v = Vessel::ReadFromMessage(
+        message, &celestial_, &ephemeris_, /*deletion_callback=*/nullptr);
+    v->RequestTrajectoryDeserialization(thread_pool);
+    v.reset();
+    destroyed.Notify();
+    thread_pool.Add([]() { return absl::OkStatus(); }).wait();
+  }
+}
+
+TEST_F(VesselTest, SerializationDeferredAdvanceTime) {
+  MockFunction<int(not_null<PileUp const*>)>
+      serialization_index_for_pile_up;
+  EXPECT_CALL(serialization_index_for_pile_up, Call(_)).Times(0);
+
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 2 * Second));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+      .Times(AnyNumber());
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+
+  serialization::Vessel message;
+  vessel_.WriteToMessage(&message,
+                         serialization_index_for_pile_up.AsStdFunction());
+  auto const v = Vessel::ReadFromMessage(
+      message, &celestial_, &ephemeris_, /*deletion_callback=*/nullptr);
+
+  // Advance both vessels by two steps.  The parts of |v| are copies of those of
+  // |vessel_|.
+  for (Instant const t1 : {t0_, t0_ + 1 * Second}) {
+    for (PartId const part_id : {part_id1_, part_id2_}) {
+      AppendTrajectoryTimeline<Barycentric>(
+          NewLinearTrajectoryTimeline<Barycentric>(
+              part_id == part_id1_ ? p1_dof_ : p2_dof_,
+              /*Δt=*/0.5 * Second,
+              /*t0=*/t0_,
+              /*t1=*/t1,
+              /*t2=*/t1 + 1 * Second),
+          [&v, part_id, this](
+              Instant const& time,
+              DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+            vessel_.part(part_id)->AppendToHistory(time, degrees_of_freedom);
+            v->part(part_id)->AppendToHistory(time, degrees_of_freedom);
+          });
+    }
+
+    // Neither advancing time nor looking at the end of the psychohistory
+    // deserializes the trajectory, which would prolong the ephemeris.
+    EXPECT_CALL(ephemeris_, Prolong(_)).Times(0);
+    vessel_.AdvanceTime();
+    v->AdvanceTime();
+    EXPECT_EQ(vessel_.psychohistory()->back().time,
+              v->last_psychohistory_point().time);
+    EXPECT_EQ(vessel_.psychohistory()->back().degrees_of_freedom,
+              v->last_psychohistory_point().degrees_of_freedom);
+    Mock::VerifyAndClearExpectations(&ephemeris_);
+  }
+
+  // Since the trajectory has changed, preparing for serialization deserializes
+  // it, which applies the steps.
+  EXPECT_CALL(ephemeris_, Prolong(_)).Times(1);
+  v->PrepareForSerialization();
+  EXPECT_EQ(vessel_.trajectory().size(), v->trajectory().size());
+  EXPECT_EQ(vessel_.psychohistory()->size(), v->psychohistory()->size());
+  for (auto it1 = vessel_.trajectory().begin(), it2 = v->trajectory().begin();
+       it1 != vessel_.trajectory().end() && it2 != v->trajectory().end();
+       ++it1, ++it2) {
+    EXPECT_EQ(it1->time, it2->time);
+    EXPECT_EQ(it1->degrees_of_freedom, it2->degrees_of_freedom);
+  }
+}
+
 #if !defined(_DEBUG)
 TEST_F(VesselTest, TailSerialization) {
   // Must be large enough that truncation happens.
@@ -0,0 +1,72 @@
+#include "numerics/elementary_function_kernels.hpp"
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "base/macros.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _elementary_function_kernels {
+namespace internal {
+
+namespace {
+
+void SqrtGeneric(std::int64_t const n,
+                 double const* const x,
+                 double* const values) {
+  for (std::int64_t i = 0; i < n; ++i) {
+    values[i] = std::sqrt(x[i]);
+  }
+}
+
+// AVX2 implementation.
+
+PRINCIPIA_TARGET_AVX2
+void SqrtAVX2(std::int64_t const n,
+              double const* const x,
+              double* const values) {
+  std::int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(values + i, _mm256_sqrt_pd(_mm256_loadu_pd(x + i)));
+  }
+  for (; i < n; ++i) {
+    values[i] = std::sqrt(x[i]);
+  }
+}
+
+// AVX-512 implementation.  The last iteration is masked to process the
+// elements that don't fill a vector.
+
+PRINCIPIA_TARGET_AVX512
+FORCE_INLINE(inline) __mmask8 TailMask(std::int64_t const n,
+                                       std::int64_t const i) {
+  return n - i >= 8 ? static_cast<__mmask8>(0xFF)
+                    : static_cast<__mmask8>((1u << (n - i)) - 1);
+}
+
+PRINCIPIA_TARGET_AVX512
+void SqrtAVX512(std::int64_t const n,
+                double const* const x,
+                double* const values) {
+  for (std::int64_t i = 0; i < n; i += 8) {
+    __mmask8 const mask = TailMask(n, i);
+    _mm512_mask_storeu_pd(
+        values + i, mask, _mm512_sqrt_pd(_mm512_maskz_loadu_pd(mask, x + i)));
+  }
+}
+
+}  // namespace
+
+CPUDispatch<void(std::int64_t n,
+                 double const* x,
+                 double* values)> const BatchSqrt(&SqrtGeneric,
+                                                  &SqrtAVX2,
+                                                  &SqrtAVX512);
+
+}  // namespace internal
+}  // namespace _elementary_function_kernels
+}  // namespace numerics
+}  // namespace principia
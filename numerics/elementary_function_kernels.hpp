@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "base/cpu_dispatch.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _elementary_function_kernels {
+namespace internal {
+
+using namespace principia::base::_cpu_dispatch;
+
+// Batch evaluation of elementary functions on arrays of |n| doubles.  These
+// functions are useful when many values are computed in a single call; they
+// are vectorized for the instruction sets supported by the processor, but
+// their results are bitwise identical irrespective of the instruction set, and
+// to those of the scalar functions.  The output arrays may be the same as the
+// input arrays, but must not otherwise overlap with them.
+
+// Computes the square root of each of the |x|.  The result is correctly
+// rounded.
+extern CPUDispatch<void(std::int64_t n,
+                        double const* x,
+                        double* values)> const BatchSqrt;
+
+}  // namespace internal
+
+using internal::BatchSqrt;
+
+}  // namespace _elementary_function_kernels
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,76 @@
+#include "numerics/elementary_function_kernels.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "base/cpu_dispatch.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace numerics {
+
+using ::testing::ElementsAreArray;
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::numerics::_elementary_function_kernels;
+
+class ElementaryFunctionKernelsTest : public ::testing::Test {
+ protected:
+  ElementaryFunctionKernelsTest() {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(0, 10);
+    for (int i = 0; i < max_n; ++i) {
+      x_.push_back(distribution(random));
+    }
+    // Make sure that the special values go through the vectorized code.
+    x_[2] = -1.0;
+    x_[3] = -0.0;
+    x_[max_n - 2] = std::numeric_limits<double>::quiet_NaN();
+    x_[max_n - 1] = std::numeric_limits<double>::infinity();
+  }
+
+  // Returns the bits of the |values|, so that NaNs may be compared.
+  static std::vector<std::uint64_t> Bits(std::vector<double> const& values) {
+    std::vector<std::uint64_t> bits(values.size());
+    std::memcpy(bits.data(), values.data(), values.size() * sizeof(double));
+    return bits;
+  }
+
+  static constexpr int max_n = 19;
+  std::vector<double> x_;
+};
+
+TEST_F(ElementaryFunctionKernelsTest, BitwiseIdentical) {
+  for (int i = 0;
+       i <= static_cast<int>(SupportedInstructionSet());
+       ++i) {
+    auto const instruction_set = static_cast<InstructionSet>(i);
+    // Exercise all the remainders of the vector lengths.
+    for (std::int64_t n = 0; n <= max_n; ++n) {
+      std::vector<double> expected(max_n, -1);
+      std::vector<double> actual(max_n, -1);
+      for (std::int64_t j = 0; j < n; ++j) {
+        expected[j] = std::sqrt(x_[j]);
+      }
+      BatchSqrt.implementation(instruction_set)(n, x_.data(), actual.data());
+      EXPECT_THAT(Bits(actual), ElementsAreArray(Bits(expected)))
+          << instruction_set << " " << n;
+    }
+  }
+}
+
+TEST_F(ElementaryFunctionKernelsTest, InPlace) {
+  std::vector<double> expected;
+  for (double const x : x_) {
+    expected.push_back(std::sqrt(x));
+  }
+  BatchSqrt(x_.size(), x_.data(), x_.data());
+  EXPECT_THAT(Bits(x_), ElementsAreArray(Bits(expected)));
+}
+
+}  // namespace numerics
+}  // namespace principia
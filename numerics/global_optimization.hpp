@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/hilbert.hpp"
 #include "numerics/nearest_neighbour.hpp"
 #include "quantities/named_quantities.hpp"
@@ -17,6 +18,7 @@ namespace _global_optimization {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_hilbert;
 using namespace principia::numerics::_nearest_neighbour;
 using namespace principia::quantities::_named_quantities;
@@ -41,6 +43,9 @@ using Gradient =
 // problem.  It it is 1 or 2, the box is 1- or 2-dimensional and the computation
 // of rₖ is adjusted accordingly.  In all cases, the dimensions of the box must
 // be nonzero.
+// If the search is executed on a stoppable thread, it terminates early when a
+// stop is requested, returning the stationary points found so far; the caller
+// is expected to check for cancellation.
 template<typename Scalar, typename Argument, int dimensions = 3>
 class MultiLevelSingleLinkage {
  public:
@@ -58,10 +63,15 @@ class MultiLevelSingleLinkage {
     Measure measure() const;
   };
 
+  // If |thread_pool| is not null, it is used to evaluate |f| at the sample
+  // points and to run the local searches in parallel.  The result doesn't
+  // depend on whether a |thread_pool| is given, but |f| and |grad_f| must then
+  // be thread-safe.
   MultiLevelSingleLinkage(
       Box const& box,
       Field<Scalar, Argument> f,
-      Field<Gradient<Scalar, Argument>, Argument> grad_f);
+      Field<Gradient<Scalar, Argument>, Argument> grad_f,
+      ThreadPool<void>* thread_pool = nullptr);
 
   // If |number_of_rounds| is given, the algorithm does |number_of_rounds|
   // iterations, each time adding |points_per_round| to the sample.
@@ -110,6 +120,19 @@ class MultiLevelSingleLinkage {
   // Returns a vector of size |values_per_round|.  The points are in |box_|.
   Arguments RandomArguments(std::int64_t values_per_round);
 
+  // Returns the values of |f| at the given |arguments|, in the same order.
+  std::vector<Scalar> Evaluate(Arguments const& arguments,
+                               Field<Scalar, Argument> const& f);
+
+  // Runs a local search from each of the |starts| and returns the stationary
+  // points, in the same order.  An element of the result is empty if the search
+  // failed or if it was not run because a stop was requested.
+  std::vector<std::optional<Argument>> LocalSearches(
+      std::vector<Argument const*> const& starts,
+      NormType local_search_tolerance,
+      Field<Scalar, Argument> const& f,
+      Field<Gradient<Scalar, Argument>, Argument> const& grad_f);
+
   // Returns the square of the radius rₖ from [RT87a], eqn. 35, specialized for
   // |dimensions|.
   Norm²Type CriticalRadius²(double σ, std::int64_t kN);
@@ -119,6 +142,7 @@ class MultiLevelSingleLinkage {
   typename Box::Measure const box_measure_;
   Field<Scalar, Argument> const f_;
   Field<Gradient<Scalar, Argument>, Argument> const grad_f_;
+  ThreadPool<void>* const thread_pool_;
 
   std::mt19937_64 random_;
   std::uniform_real_distribution<> distribution_;
@@ -3,11 +3,14 @@
 #include "numerics/global_optimization.hpp"
 
 #include <algorithm>
+#include <future>
 #include <map>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "base/jthread.hpp"
 #include "base/macros.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "numerics/gradient_descent.hpp"
@@ -19,6 +22,7 @@ namespace _global_optimization {
 namespace internal {
 
 using base::noreturn;
+using namespace principia::base::_jthread;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
@@ -31,6 +35,10 @@ using namespace principia::quantities::_quantities;
 // evaluations in the leaf search.
 constexpr int64_t pcp_tree_max_values_per_cell = 20;
 
+// The number of evaluations of the field performed by a single task of the
+// thread pool.  Evaluations are cheap compared to the overhead of a task.
+constexpr std::int64_t evaluations_per_task = 64;
+
 template<typename Scalar, typename Argument, int dimensions>
 typename MultiLevelSingleLinkage<Scalar, Argument, dimensions>::Box::Measure
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::Box::measure() const {
@@ -58,12 +66,14 @@ template<typename Scalar, typename Argument, int dimensions>
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::MultiLevelSingleLinkage(
     Box const& box,
     Field<Scalar, Argument> f,
-    Field<Gradient<Scalar, Argument>, Argument> grad_f)
+    Field<Gradient<Scalar, Argument>, Argument> grad_f,
+    ThreadPool<void>* const thread_pool)
     : box_(box),
       box_diametre_(box_.diametre()),
       box_measure_(box_.measure()),
       f_(std::move(f)),
       grad_f_(std::move(grad_f)),
+      thread_pool_(thread_pool),
       random_(42),
       distribution_(-1.0, 1.0) {
   for (auto const& vertex : box_.vertices) {
@@ -120,6 +130,20 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
   Arguments points;
   points.reserve(points_per_round);
 
+  // When a thread pool is available, the values of |f| at the sample points
+  // are computed in parallel when the points are generated.  Otherwise they are
+  // computed lazily, when needed by the nearest neighbour searches.
+  absl::flat_hash_map<Argument const*, Scalar> values;
+  auto const value_at = [this, &f, &values](Argument const& x) -> Scalar {
+    if (thread_pool_ == nullptr) {
+      return f(x);
+    } else {
+      return values.at(&x);
+    }
+  };
+
+  stop_token const token = this_stoppable_thread::get_stop_token();
+
   // The PCP tree used for detecting proximity of the stationary points.  It
   // gets updated as new stationary points are found.
   PrincipalComponentPartitioningTree<Argument> stationary_point_neighbourhoods(
@@ -198,6 +222,15 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
     // Anyway, reducing the sample would be annoying with our data structures,
     // so let's not go there, 'tis a silly place.
     Arguments pointsₖ = RandomArguments(N);
+    if (thread_pool_ != nullptr) {
+      std::vector<Scalar> const valuesₖ = Evaluate(pointsₖ, f);
+      for (std::int64_t i = 0; i < pointsₖ.size(); ++i) {
+        values.emplace(pointsₖ[i].get(), valuesₖ[i]);
+      }
+    }
+    if (token.stop_requested()) {
+      break;
+    }
     for (auto& pointₖ : pointsₖ) {
       points.push_back(std::move(pointₖ));
       Argument const* const pointₖ_pointer = points.back().get();
@@ -211,38 +244,24 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
     Norm²Type const rₖ² = CriticalRadius²(/*σ=*/4, kN);
 
     // Process the points whose nearest neighbour is "sufficiently far" (or
-    // unknown).
+    // unknown).  The local searches are independent from each other, so we
+    // first collect their starting points and then run them, possibly in
+    // parallel.
+    std::vector<Argument const*> local_search_starts;
     for (auto it = schedule.upper_bound(rₖ²); it != schedule.end();) {
       Argument const& xᵢ = *it->second;
       auto* const xⱼ = point_neighbourhoods.FindNearestNeighbour(
-          xᵢ, [f_xᵢ = f(xᵢ), rₖ², f, xᵢ](Argument const* const xⱼ) {
-            return (xᵢ - *xⱼ).Norm²() <= rₖ² && f(*xⱼ) < f_xᵢ;
+          xᵢ,
+          [f_xᵢ = value_at(xᵢ), rₖ², &value_at, &xᵢ](
+              Argument const* const xⱼ) {
+            return (xᵢ - *xⱼ).Norm²() <= rₖ² && value_at(*xⱼ) < f_xᵢ;
           });
 
       if (xⱼ == nullptr) {
         // We must do a local search as xᵢ couldn't be added to an existing
-        // cluster.  Note that the radius of the search has to be the diametre
-        // of the box: it's possible that xᵢ would be near one vertex of the box
-        // and the stationary point near the opposite vertex.
-        ++number_of_local_searches;
-        auto const stationary_point =
-            BroydenFletcherGoldfarbShanno(xᵢ,
-                                          f,
-                                          grad_f,
-                                          local_search_tolerance,
-                                          box_diametre_);
-
-        // If the new stationary point is sufficiently far from the ones we
-        // already know, record it.
-        if (stationary_point.has_value() &&
-            IsNewStationaryPoint(stationary_point.value(),
-                                 stationary_point_neighbourhoods,
-                                 local_search_tolerance)) {
-          stationary_points.push_back(
-              std::make_unique<Argument>(stationary_point.value()));
-          stationary_point_neighbourhoods.Add(stationary_points.back().get());
-        }
-        // A local search has been started from xᵢ, so no point in considering
+        // cluster.
+        local_search_starts.push_back(&xᵢ);
+        // A local search will be started from xᵢ, so no point in considering
         // it again.
         it = schedule.erase(it);
       } else {
@@ -256,6 +275,27 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
         schedule.emplace(distance²_to_xⱼ, &xᵢ);
       }
     }
+
+    number_of_local_searches += local_search_starts.size();
+    auto const local_search_stationary_points = LocalSearches(
+        local_search_starts, local_search_tolerance, f, grad_f);
+
+    // If a new stationary point is sufficiently far from the ones we already
+    // know, record it.  This is done in the order of the starting points so
+    // that the result is deterministic.
+    for (auto const& stationary_point : local_search_stationary_points) {
+      if (stationary_point.has_value() &&
+          IsNewStationaryPoint(stationary_point.value(),
+                               stationary_point_neighbourhoods,
+                               local_search_tolerance)) {
+        stationary_points.push_back(
+            std::make_unique<Argument>(stationary_point.value()));
+        stationary_point_neighbourhoods.Add(stationary_points.back().get());
+      }
+    }
+    if (token.stop_requested()) {
+      break;
+    }
   }
 
   DLOG(ERROR) << "Number of local searches: " << number_of_local_searches;
@@ -301,6 +341,86 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::RandomArguments(
   return arguments;
 }
 
+template<typename Scalar, typename Argument, int dimensions>
+std::vector<Scalar>
+MultiLevelSingleLinkage<Scalar, Argument, dimensions>::Evaluate(
+    Arguments const& arguments,
+    Field<Scalar, Argument> const& f) {
+  std::int64_t const size = arguments.size();
+  std::vector<Scalar> values(size);
+  auto const evaluate = [&arguments, &f, &values](std::int64_t const begin,
+                                                  std::int64_t const end) {
+    for (std::int64_t i = begin; i < end; ++i) {
+      values[i] = f(*arguments[i]);
+    }
+  };
+
+  if (thread_pool_ == nullptr) {
+    evaluate(0, size);
+  } else {
+    std::vector<std::future<void>> futures;
+    for (std::int64_t begin = 0; begin < size; begin += evaluations_per_task) {
+      std::int64_t const end = std::min(begin + evaluations_per_task, size);
+      futures.push_back(thread_pool_->Add(
+          [begin, end, &evaluate]() { evaluate(begin, end); }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+  return values;
+}
+
+template<typename Scalar, typename Argument, int dimensions>
+std::vector<std::optional<Argument>>
+MultiLevelSingleLinkage<Scalar, Argument, dimensions>::LocalSearches(
+    std::vector<Argument const*> const& starts,
+    NormType const local_search_tolerance,
+    Field<Scalar, Argument> const& f,
+    Field<Gradient<Scalar, Argument>, Argument> const& grad_f) {
+  // The stop token of the calling thread, which the threads of the pool cannot
+  // see.
+  stop_token const token = this_stoppable_thread::get_stop_token();
+  std::vector<std::optional<Argument>> stationary_points(starts.size());
+
+  // Note that the radius of the search has to be the diametre of the box: it's
+  // possible that a starting point would be near one vertex of the box and the
+  // stationary point near the opposite vertex.
+  auto const local_search = [this,
+                             &f,
+                             &grad_f,
+                             local_search_tolerance,
+                             &starts,
+                             &stationary_points,
+                             token](std::int64_t const i) {
+    if (!token.stop_requested()) {
+      stationary_points[i] =
+          BroydenFletcherGoldfarbShanno(*starts[i],
+                                        f,
+                                        grad_f,
+                                        local_search_tolerance,
+                                        box_diametre_);
+    }
+  };
+
+  if (thread_pool_ == nullptr) {
+    for (std::int64_t i = 0; i < starts.size(); ++i) {
+      local_search(i);
+    }
+  } else {
+    std::vector<std::future<void>> futures;
+    for (std::int64_t i = 0; i < starts.size(); ++i) {
+      futures.push_back(thread_pool_->Add([i, &local_search]() {
+        local_search(i);
+      }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+  return stationary_points;
+}
+
 template<typename Scalar, typename Argument, int dimensions>
 typename MultiLevelSingleLinkage<Scalar, Argument, dimensions>::Norm²Type
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::CriticalRadius²(
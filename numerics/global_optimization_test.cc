@@ -1,5 +1,6 @@
 #include "numerics/global_optimization.hpp"
 
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/space.hpp"
@@ -21,6 +22,7 @@ namespace numerics {
 using ::testing::ElementsAre;
 using ::testing::IsEmpty;
 using ::testing::_;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_space;
@@ -42,6 +44,19 @@ using namespace principia::testing_utilities::_vanishes_before;
 class GlobalOptimizationTest : public ::testing::Test {
  protected:
   using World = Frame<struct WorldTag>;
+  using Hartmann3Optimizer =
+      MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
+
+  // The unit cube on which |Hartmann3| is minimized.
+  static Hartmann3Optimizer::Box Hartmann3Box() {
+    return {
+        .centre = Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre}),
+        .vertices = {
+            Displacement<World>({0.5 * Metre, 0 * Metre, 0 * Metre}),
+            Displacement<World>({0 * Metre, 0.5 * Metre, 0 * Metre}),
+            Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
+        }};
+  }
 };
 
 TEST_F(GlobalOptimizationTest, Branin) {
@@ -224,42 +239,23 @@ TEST_F(GlobalOptimizationTest, GoldsteinPrice) {
 }
 
 TEST_F(GlobalOptimizationTest, Hartmann3) {
-  using Optimizer =
-      MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
   int function_invocations = 0;
   int gradient_invocations = 0;
 
   auto hartmann3 =
       [&function_invocations](Displacement<World> const& displacement) {
     ++function_invocations;
-    auto const& coordinates = displacement.coordinates();
-    double const x₀ = coordinates[0] / Metre;
-    double const x₁ = coordinates[1] / Metre;
-    double const x₂ = coordinates[2] / Metre;
-    return Hartmann3(x₀, x₁, x₂);
+    return Hartmann3(displacement);
   };
 
   auto grad_hartmann3 = [&gradient_invocations](
                             Displacement<World> const& displacement) {
     ++gradient_invocations;
-    auto const& coordinates = displacement.coordinates();
-    double const x₀ = coordinates[0] / Metre;
-    double const x₁ = coordinates[1] / Metre;
-    double const x₂ = coordinates[2] / Metre;
-    auto const [g₀, g₁, g₂] = 𝛁Hartmann3(x₀, x₁, x₂);
-    return Vector<Inverse<Length>, World>({g₀ / Metre, g₁ / Metre, g₂ / Metre});
+    return 𝛁Hartmann3(displacement);
   };
 
-  Optimizer::Box const box = {
-      .centre = Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre}),
-      .vertices = {
-          Displacement<World>({0.5 * Metre, 0 * Metre, 0 * Metre}),
-          Displacement<World>({0 * Metre, 0.5 * Metre, 0 * Metre}),
-          Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
-      }};
-
   auto const tolerance = 1e-6 * Metre;
-  Optimizer optimizer(box, hartmann3, grad_hartmann3);
+  Hartmann3Optimizer optimizer(Hartmann3Box(), hartmann3, grad_hartmann3);
 
   {
     auto const minima = optimizer.FindGlobalMinima(/*points_per_round=*/10,
@@ -367,5 +363,26 @@ TEST_F(GlobalOptimizationTest, Potential) {
   }
 }
 
+// Check that parallelizing the search doesn't change its result.
+TEST_F(GlobalOptimizationTest, Parallel) {
+  auto const tolerance = 1e-6 * Metre;
+  ThreadPool<void> thread_pool(/*pool_size=*/4);
+  Hartmann3Optimizer serial_optimizer(
+      Hartmann3Box(), &Hartmann3<World>, &𝛁Hartmann3<World>);
+  Hartmann3Optimizer parallel_optimizer(Hartmann3Box(),
+                                        &Hartmann3<World>,
+                                        &𝛁Hartmann3<World>,
+                                        &thread_pool);
+
+  for (std::optional<std::int64_t> const number_of_rounds :
+       {std::optional<std::int64_t>(10), std::optional<std::int64_t>()}) {
+    auto const serial_minima = serial_optimizer.FindGlobalMinima(
+        /*points_per_round=*/10, number_of_rounds, tolerance);
+    auto const parallel_minima = parallel_optimizer.FindGlobalMinima(
+        /*points_per_round=*/10, number_of_rounds, tolerance);
+    EXPECT_EQ(serial_minima, parallel_minima);
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -59,8 +59,21 @@ NewhallApproximationInMonomialBasis(int degree,
                                     Instant const& t_max,
                                     Difference<Value>& error_estimate);
 
+// Returns the |error_estimate| that the preceding function would compute for
+// the given |degree|, without computing the approximation.  This is much
+// cheaper than computing the approximation, and makes it possible to pick a
+// degree before fitting.
+template<typename Value>
+Difference<Value> NewhallApproximationErrorEstimate(
+    int degree,
+    std::vector<Value> const& q,
+    std::vector<Variation<Value>> const& v,
+    Instant const& t_min,
+    Instant const& t_max);
+
 }  // namespace internal
 
+using internal::NewhallApproximationErrorEstimate;
 using internal::NewhallApproximationInЧебышёвBasis;
 using internal::NewhallApproximationInMonomialBasis;
 
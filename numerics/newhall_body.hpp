@@ -23,6 +23,15 @@ using namespace principia::quantities::_quantities;
 // Only supports 8 divisions for now.
 constexpr int divisions = 8;
 
+// Returns the vector of positions and scaled velocities by which Newhall's
+// matrices get multiplied, with the positions taken relative to |Value{}|.
+template<typename Value>
+FixedVector<Difference<Value>, 2 * divisions + 2> NewhallInputs(
+    std::vector<Value> const& q,
+    std::vector<Variation<Value>> const& v,
+    Instant const& t_min,
+    Instant const& t_max);
+
 template<typename Value, int degree,
          template<typename, typename, int> class Evaluator>
 PolynomialInMonomialBasis<Value, Instant, degree, Evaluator> Dehomogeneize(
@@ -50,6 +59,30 @@ struct Dehomogeneizer<Value, DehomogeneizedCoefficients, degree, degree> {
       DehomogeneizedCoefficients& dehomogeneized_coefficients);
 };
 
+template<typename Value>
+FixedVector<Difference<Value>, 2 * divisions + 2> NewhallInputs(
+    std::vector<Value> const& q,
+    std::vector<Variation<Value>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) {
+  CHECK_EQ(divisions + 1, q.size());
+  CHECK_EQ(divisions + 1, v.size());
+
+  Value const origin{};
+  Time const duration_over_two = 0.5 * (t_max - t_min);
+
+  // Tricky.  The order in Newhall's matrices is such that the entries for the
+  // largest time occur first.
+  FixedVector<Difference<Value>, 2 * divisions + 2> qv;
+  for (int i = 0, j = 2 * divisions;
+       i < divisions + 1 && j >= 0;
+       ++i, j -= 2) {
+    qv[j] = q[i] - origin;
+    qv[j + 1] = v[i] * duration_over_two;
+  }
+  return qv;
+}
+
 template<typename Value, int degree,
          template<typename, typename, int> class Evaluator>
 PolynomialInMonomialBasis<Value, Instant, degree, Evaluator> Dehomogeneize(
@@ -199,21 +232,9 @@ NewhallApproximationInMonomialBasis(std::vector<Value> const& q,
                                     Instant const& t_min,
                                     Instant const& t_max,
                                     Difference<Value>& error_estimate) {
-  CHECK_EQ(divisions + 1, q.size());
-  CHECK_EQ(divisions + 1, v.size());
-
   Value const origin{};
   Time const duration_over_two = 0.5 * (t_max - t_min);
-
-  // Tricky.  The order in Newhall's matrices is such that the entries for the
-  // largest time occur first.
-  FixedVector<Difference<Value>, 2 * divisions + 2> qv;
-  for (int i = 0, j = 2 * divisions;
-       i < divisions + 1 && j >= 0;
-       ++i, j -= 2) {
-    qv[j] = q[i] - origin;
-    qv[j + 1] = v[i] * duration_over_two;
-  }
+  auto const qv = NewhallInputs(q, v, t_min, t_max);
 
   Instant const t_mid = Barycentre<Instant, double>({t_min, t_max}, {1, 1});
   return origin +
@@ -263,6 +284,45 @@ NewhallApproximationInMonomialBasis(int degree,
 
 #undef PRINCIPIA_NEWHALL_APPROXIMATION_IN_MONOMIAL_BASIS_CASE
 
+#define PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(degree)               \
+  case (degree):                                                    \
+    return newhall_c_matrix_чебышёв_degree_##degree##_divisions_8_w04 \
+               .row<(degree)>() *                                   \
+           qv
+
+template<typename Value>
+Difference<Value> NewhallApproximationErrorEstimate(
+    int const degree,
+    std::vector<Value> const& q,
+    std::vector<Variation<Value>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) {
+  // Only the last row of the matrix in the Чебышёв basis is needed.
+  auto const qv = NewhallInputs(q, v, t_min, t_max);
+  switch (degree) {
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(3);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(4);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(5);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(6);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(7);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(8);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(9);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(10);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(11);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(12);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(13);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(14);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(15);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(16);
+    PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE(17);
+    default:
+      LOG(FATAL) << "Unexpected degree " << degree;
+      break;
+  }
+}
+
+#undef PRINCIPIA_NEWHALL_ERROR_ESTIMATE_CASE
+
 }  // namespace internal
 }  // namespace _newhall
 }  // namespace numerics
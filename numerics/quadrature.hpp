@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <tuple>
 #include <type_traits>
 
 #include "quantities/named_quantities.hpp"
@@ -13,6 +14,18 @@ namespace internal {
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 
+// The result of integrating a function whose values are tuples, componentwise.
+template<typename Tuple, typename Argument>
+struct TuplePrimitiveGenerator;
+
+template<typename... Values, typename Argument>
+struct TuplePrimitiveGenerator<std::tuple<Values...>, Argument> {
+  using Type = std::tuple<Primitive<Values, Argument>...>;
+};
+
+template<typename Tuple, typename Argument>
+using TuplePrimitive = typename TuplePrimitiveGenerator<Tuple, Argument>::Type;
+
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument> GaussLegendre(
     Function const& f,
@@ -33,6 +46,20 @@ AutomaticClenshawCurtis(
     std::optional<double> max_relative_error,
     std::optional<int> max_points);
 
+// Same as above for a function |f| that returns a |std::tuple|, integrated
+// componentwise.  All the components are computed from the same evaluations of
+// |f|, and the number of points is increased until the relative error
+// criterion is satisfied for all of them.  This is useful when the components
+// are expensive to evaluate separately.
+template<int initial_points = 3, typename Argument, typename Function>
+TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>
+AutomaticClenshawCurtisOfTuple(
+    Function const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::optional<double> max_relative_error,
+    std::optional<int> max_points);
+
 // |points| must be of the form 2ᵖ + 1 for some p ∈ ℕ.  Returns the
 // Clenshaw-Curtis quadrature of f with the given number of points.
 template<int points, typename Argument, typename Function>
@@ -59,6 +86,7 @@ Primitive<std::invoke_result_t<Function, Argument>, Argument> Midpoint(
 }  // namespace internal
 
 using internal::AutomaticClenshawCurtis;
+using internal::AutomaticClenshawCurtisOfTuple;
 using internal::GaussLegendre;
 using internal::MaxPointsHeuristicsForAutomaticClenshawCurtis;
 using internal::Midpoint;
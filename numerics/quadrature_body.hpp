@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "base/bits.hpp"
@@ -75,6 +77,36 @@ ClenshawCurtisImplementation(
     std::vector<std::invoke_result_t<Function, Argument>>&
         f_cos_N⁻¹π_bit_reversed);
 
+// Computes the Clenshaw-Curtis quadrature on |points| from a cache that has
+// been filled by |FillClenshawCurtisCache|.
+template<int points, typename Argument, typename Value>
+Primitive<Value, Argument> ClenshawCurtisFromCache(
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::vector<Value> const& f_cos_N⁻¹π_bit_reversed);
+
+template<int points, typename Argument, typename Function>
+TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>
+AutomaticClenshawCurtisOfTupleImplementation(
+    Function const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::optional<double> const max_relative_error,
+    std::optional<int> const max_points,
+    TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument> const&
+        previous_estimate,
+    std::vector<std::invoke_result_t<Function, Argument>>&
+        f_cos_N⁻¹π_bit_reversed);
+
+template<int points, typename Argument, typename Function>
+TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>
+ClenshawCurtisOfTupleImplementation(
+    Function const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::vector<std::invoke_result_t<Function, Argument>>&
+        f_cos_N⁻¹π_bit_reversed);
+
 // Our automatic Cleshaw-Curtis implementation doubles the number of points
 // repeatedly until it reaches a suitable exit criterion.  Naïvely evaluating
 // the function N times for each iteration would be wasteful.  Assume that we
@@ -199,18 +231,24 @@ ClenshawCurtisImplementation(
     Argument const& upper_bound,
     std::vector<std::invoke_result_t<Function, Argument>>&
         f_cos_N⁻¹π_bit_reversed) {
-  // We follow the notation from [Gen72b] and [Gen72c].
-  using Value = std::invoke_result_t<Function, Argument>;
+  FillClenshawCurtisCache<points>(
+      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+  return ClenshawCurtisFromCache<points>(
+      lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+}
 
+template<int points, typename Argument, typename Value>
+Primitive<Value, Argument> ClenshawCurtisFromCache(
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::vector<Value> const& f_cos_N⁻¹π_bit_reversed) {
+  // We follow the notation from [Gen72b] and [Gen72c].
   constexpr int N = points - 1;
   constexpr int log2_N = FloorLog2(N);
 
   Difference<Argument> const half_width = (upper_bound - lower_bound) / 2;
   constexpr Angle N⁻¹π = π * Radian / N;
 
-  FillClenshawCurtisCache<points>(
-      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
-
   // TODO(phl): If might be possible to avoid copies since
   // f_cos_N⁻¹π_bit_reversed is tantalizing close to the order needed for the
   // FFT.
@@ -249,6 +287,84 @@ ClenshawCurtisImplementation(
   return Σʺ * half_width;
 }
 
+template<int points, typename Argument, typename Function>
+TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>
+AutomaticClenshawCurtisOfTupleImplementation(
+    Function const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::optional<double> const max_relative_error,
+    std::optional<int> const max_points,
+    TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument> const&
+        previous_estimate,
+    std::vector<std::invoke_result_t<Function, Argument>>&
+        f_cos_N⁻¹π_bit_reversed) {
+  using Result =
+      TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>;
+
+  Result const estimate =
+      ClenshawCurtisOfTupleImplementation<points>(
+          f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+
+  // The naïve estimate of [Gen72b], p. 339, must be satisfied by all the
+  // components.
+  bool const accurate = max_relative_error.has_value() &&
+      [&]<std::size_t... i>(std::index_sequence<i...>) {
+        return ((Hilbert<std::tuple_element_t<i, Result>>::Norm(
+                     std::get<i>(previous_estimate) - std::get<i>(estimate)) <=
+                 max_relative_error.value() *
+                     Hilbert<std::tuple_element_t<i, Result>>::Norm(
+                         std::get<i>(estimate))) && ...);
+      }(std::make_index_sequence<std::tuple_size_v<Result>>());
+
+  if (!accurate &&
+      (!max_points.has_value() || points < max_points.value())) {
+    if constexpr (points > 1 << 24) {
+      LOG(FATAL) << "Too many refinements while integrating from "
+                 << lower_bound << " to " << upper_bound;
+    } else {
+      f_cos_N⁻¹π_bit_reversed.reserve(2 * points - 1);
+      return AutomaticClenshawCurtisOfTupleImplementation<2 * points - 1>(
+          f,
+          lower_bound, upper_bound,
+          max_relative_error, max_points,
+          estimate,
+          f_cos_N⁻¹π_bit_reversed);
+    }
+  }
+  return estimate;
+}
+
+template<int points, typename Argument, typename Function>
+TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>
+ClenshawCurtisOfTupleImplementation(
+    Function const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::vector<std::invoke_result_t<Function, Argument>>&
+        f_cos_N⁻¹π_bit_reversed) {
+  using Value = std::invoke_result_t<Function, Argument>;
+
+  FillClenshawCurtisCache<points>(
+      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+
+  // Each component is integrated from its own copy of the cache, which is
+  // cheap compared to the evaluations of |f|.
+  return [&]<std::size_t... i>(std::index_sequence<i...>) {
+    auto const component_quadrature = [&]<std::size_t j>() {
+      std::vector<std::tuple_element_t<j, Value>> component;
+      component.reserve(points);
+      for (int k = 0; k < points; ++k) {
+        component.push_back(std::get<j>(f_cos_N⁻¹π_bit_reversed[k]));
+      }
+      return ClenshawCurtisFromCache<points>(
+          lower_bound, upper_bound, component);
+    };
+    return TuplePrimitive<Value, Argument>(
+        component_quadrature.template operator()<i>()...);
+  }(std::make_index_sequence<std::tuple_size_v<Value>>());
+}
+
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument> GaussLegendre(
     Function const& f,
@@ -285,6 +401,29 @@ AutomaticClenshawCurtis(
       f_cos_N⁻¹π_bit_reversed);
 }
 
+template<int initial_points, typename Argument, typename Function>
+TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>
+AutomaticClenshawCurtisOfTuple(
+    Function const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::optional<double> const max_relative_error,
+    std::optional<int> const max_points) {
+  using Result =
+      TuplePrimitive<std::invoke_result_t<Function, Argument>, Argument>;
+  using Value = std::invoke_result_t<Function, Argument>;
+  std::vector<Value> f_cos_N⁻¹π_bit_reversed;
+  f_cos_N⁻¹π_bit_reversed.reserve(2 * initial_points - 1);
+  Result const estimate = ClenshawCurtisOfTupleImplementation<initial_points>(
+      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+  return AutomaticClenshawCurtisOfTupleImplementation<2 * initial_points - 1>(
+      f,
+      lower_bound, upper_bound,
+      max_relative_error, max_points,
+      estimate,
+      f_cos_N⁻¹π_bit_reversed);
+}
+
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument> ClenshawCurtis(
     Function const& f,
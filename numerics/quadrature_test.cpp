@@ -1,6 +1,7 @@
 #include "numerics/quadrature.hpp"
 
 #include <limits>
+#include <tuple>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -15,6 +16,7 @@ namespace quadrature {
 
 using ::testing::AnyOf;
 using ::testing::Eq;
+using ::testing::Lt;
 using namespace principia::numerics::_quadrature;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_quantities;
@@ -130,6 +132,38 @@ TEST_F(QuadratureTest, Sin10) {
               AnyOf(Eq(32769), Eq(65537), Eq(262145), Eq(524289), Eq(1048577)));
 }
 
+TEST_F(QuadratureTest, Tuple) {
+  int evaluations = 0;
+  auto const f = [&evaluations](Angle const x) {
+    ++evaluations;
+    return std::tuple(Sin(x), Cos(2 * x) * Metre);
+  };
+  auto const ʃf₀ = (Cos(2.0 * Radian) - Cos(5.0 * Radian)) * Radian;
+  auto const ʃf₁ = (Sin(10 * Radian) + Sin(4 * Radian)) / 2 * Metre * Radian;
+
+  auto const [ʃf₀_tuple, ʃf₁_tuple] = AutomaticClenshawCurtisOfTuple(
+      f,
+      -2.0 * Radian,
+      5.0 * Radian,
+      /*max_relative_error=*/1e-10,
+      /*max_points=*/std::nullopt);
+  int const tuple_evaluations = evaluations;
+
+  // The components are integrated with the number of points required by the
+  // most demanding one.
+  evaluations = 0;
+  auto const ʃf₁_alone = AutomaticClenshawCurtis(
+      [&f](Angle const x) { return std::get<1>(f(x)); },
+      -2.0 * Radian,
+      5.0 * Radian,
+      /*max_relative_error=*/1e-10,
+      /*max_points=*/std::nullopt);
+  EXPECT_THAT(tuple_evaluations, Eq(evaluations));
+  EXPECT_THAT(ʃf₁_tuple, Eq(ʃf₁_alone));
+  EXPECT_THAT(ʃf₀_tuple, RelativeErrorFrom(ʃf₀, Lt(1e-10)));
+  EXPECT_THAT(ʃf₁_tuple, RelativeErrorFrom(ʃf₁, Lt(1e-10)));
+}
+
 }  // namespace quadrature
 }  // namespace numerics
 }  // namespace principia
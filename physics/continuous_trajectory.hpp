@@ -1,7 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -75,6 +79,10 @@ class ContinuousTrajectory : public Trajectory<Frame> {
                       DegreesOfFreedom<Frame> const& degrees_of_freedom)
       EXCLUDES(lock_);
 
+  // Returns true iff the next call to |Append| will compute a new polynomial,
+  // which is much more expensive than just recording a point.
+  bool next_append_fits() const EXCLUDES(lock_);
+
   // Prepends the given |trajectory| to this one.  Ideally the last point of
   // |trajectory| should match the first point of this object.
   // Note the rvalue reference: |ContinuousTrajectory| is not moveable and not
@@ -84,6 +92,18 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // we require the use of std::move.
   void Prepend(ContinuousTrajectory&& trajectory);
 
+  // Moves the polynomials that end at or before |t| to a cold tier where they
+  // are compressed in blocks, with an error well below the tolerance given at
+  // construction.  Evaluating the trajectory over the cold tier decompresses
+  // the relevant block; the few most recently used blocks are kept
+  // decompressed.  Polynomials that end after |t| are not affected.
+  void CompressBefore(Instant const& t) EXCLUDES(lock_);
+
+  // The approximate number of bytes used to store the polynomials of this
+  // trajectory.  Only useful for benchmarking or analyzing performance.  Do not
+  // use in real code.
+  std::int64_t polynomials_memory_size() const EXCLUDES(lock_);
+
   // Implementation of the interface |Trajectory|.
 
   // |t_max| may be less than the last time passed to Append because the
@@ -174,12 +194,30 @@ class ContinuousTrajectory : public Trajectory<Frame> {
         Instant t_max,
         not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
             polynomial);
+    // Constructs a pair whose polynomial is in the cold tier.
+    explicit InstantPolynomialPair(Instant t_max);
     Instant t_max;
-    not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
-        polynomial;
+    // Null if the polynomial is in the cold tier.
+    std::unique_ptr<Polynomial<Position<Frame>, Instant>> polynomial;
   };
   using InstantPolynomialPairs = std::vector<InstantPolynomialPair>;
 
+  // A block of |cold_block_size| consecutive polynomials in the cold tier.
+  struct ColdBlock {
+    // The index in |polynomials_| of the first polynomial of the block.
+    std::int64_t first;
+    std::vector<std::int8_t> degrees;
+    // The origins and the coefficients of degree 0 of the polynomials,
+    // compressed losslessly, followed by their other coefficients, compressed
+    // with ZFP.  The coefficient of degree k > 0 of a polynomial is multiplied
+    // by the k-th power of the half-length of the interval of that polynomial,
+    // so that these coefficients are lengths that bound their contribution to
+    // the position.
+    std::string zfp;
+  };
+  using HotBlock = std::vector<
+      not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>>;
+
   // Really a static method, but may be overridden for testing.
   virtual not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
   NewhallApproximationInMonomialBasis(
@@ -190,6 +228,14 @@ class ContinuousTrajectory : public Trajectory<Frame> {
       Instant const& t_max,
       Displacement<Frame>& error_estimate) const;
 
+  // Really a static method, but may be overridden for testing.
+  virtual Displacement<Frame> NewhallApproximationErrorEstimate(
+      int degree,
+      std::vector<Position<Frame>> const& q,
+      std::vector<Velocity<Frame>> const& v,
+      Instant const& t_min,
+      Instant const& t_max) const;
+
   // Computes the best Newhall approximation based on the desired tolerance.
   // Adjust the |degree_| and other member variables to stay within the
   // tolerance while minimizing the computational cost and avoiding numerical
@@ -207,6 +253,26 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   FindPolynomialForInstantLocked(Instant const& time) const
       REQUIRES_SHARED(lock_);
 
+  // Returns the polynomial at |it|, decompressing its block if it is in the
+  // cold tier.  In that case, |hot_block| is set to the decompressed block and
+  // must be kept alive as long as the polynomial is used.
+  Polynomial<Position<Frame>, Instant> const& PolynomialLocked(
+      typename InstantPolynomialPairs::const_iterator it,
+      std::shared_ptr<HotBlock const>& hot_block) const REQUIRES_SHARED(lock_);
+
+  // Compresses the |cold_block_size| polynomials starting at index |first|,
+  // which must all be hot.
+  ColdBlock CompressLocked(std::int64_t first) const REQUIRES_SHARED(lock_);
+  HotBlock DecompressLocked(ColdBlock const& block) const
+      REQUIRES_SHARED(lock_);
+
+  // Moves back to |polynomials_| the cold blocks that contain polynomials at or
+  // after |index|.
+  void ThawLocked(std::int64_t index) REQUIRES(lock_);
+
+  // The half-length of the interval of the polynomial at |index|.
+  Time HalfIntervalLocked(std::int64_t index) const REQUIRES_SHARED(lock_);
+
   // Construction parameters;
   Time const step_;
   Length const tolerance_;
@@ -244,6 +310,17 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // Any value in the range of |polynomials_| or 0 is correct.
   mutable std::int64_t last_accessed_polynomial_ GUARDED_BY(lock_) = 0;
 
+  // The blocks of the cold tier, in increasing order of |first|.
+  std::vector<ColdBlock> cold_blocks_ GUARDED_BY(lock_);
+
+  // The most recently used decompressed blocks, most recent first, identified
+  // by their index in |cold_blocks_|.  This member has its own lock because it
+  // is updated by the evaluation functions, which hold |lock_| in shared mode,
+  // if at all.
+  mutable absl::Mutex hot_blocks_lock_;
+  mutable std::list<std::pair<std::int64_t, std::shared_ptr<HotBlock const>>>
+      hot_blocks_ GUARDED_BY(hot_blocks_lock_);
+
   // The time at which this trajectory starts.  Set for a nonempty trajectory.
   std::optional<Instant> first_time_ GUARDED_BY(lock_);
 
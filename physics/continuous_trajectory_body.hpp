@@ -4,17 +4,24 @@
 
 #include <algorithm>
 #include <limits>
+#include <list>
+#include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "base/status_utilities.hpp"
+#include "base/zfp_compressor.hpp"
 #include "geometry/interval.hpp"
 #include "glog/stl_logging.h"
 #include "numerics/newhall.hpp"
 #include "numerics/ulp_distance.hpp"
 #include "numerics/чебышёв_series.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/si.hpp"
 
 namespace principia {
@@ -23,6 +30,7 @@ namespace _continuous_trajectory {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_zfp_compressor;
 using namespace principia::geometry::_interval;
 using namespace principia::numerics::_newhall;
 using namespace principia::numerics::_poisson_series;
@@ -30,6 +38,7 @@ using namespace principia::numerics::_polynomial;
 using namespace principia::numerics::_polynomial_evaluators;
 using namespace principia::numerics::_ulp_distance;
 using namespace principia::numerics::_чебышёв_series;
+using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
@@ -40,6 +49,30 @@ int const max_degree_age = 100;
 // Only supports 8 divisions for now.
 int const divisions = 8;
 
+// The number of polynomials in a block of the cold tier, and the number of
+// decompressed blocks that are retained.  The block size is a multiple of 16
+// so that each row of coefficients fills whole ZFP blocks.
+int const cold_block_size = 256;
+std::size_t const max_hot_blocks = 4;
+
+// The error on the coefficients of the polynomials of the cold tier is such
+// that the error on a position is at most this fraction of the tolerance.
+double const cold_tolerance_fraction = 1e-2;
+
+// Calls |f| with an |std::integral_constant| holding |degree|, which must be
+// in [min_degree, max_degree].
+template<typename F>
+void WithDegree(int const degree, F&& f) {
+  bool const found = [degree, &f]<int... d>(
+                         std::integer_sequence<int, d...>) {
+    return ((degree == d + min_degree
+                 ? (f(std::integral_constant<int, d + min_degree>{}), true)
+                 : false) ||
+            ...);
+  }(std::make_integer_sequence<int, max_degree - min_degree + 1>{});
+  CHECK(found) << "Unexpected degree " << degree;
+}
+
 template<typename Frame>
 ContinuousTrajectory<Frame>::ContinuousTrajectory(Time const& step,
                                                   Length const& tolerance)
@@ -71,7 +104,14 @@ double ContinuousTrajectory<Frame>::average_degree() const {
   } else {
     double total = 0;
     for (auto const& pair : polynomials_) {
-      total += pair.polynomial->degree();
+      if (pair.polynomial != nullptr) {
+        total += pair.polynomial->degree();
+      }
+    }
+    for (auto const& block : cold_blocks_) {
+      for (int const degree : block.degrees) {
+        total += degree;
+      }
     }
     return total / polynomials_.size();
   }
@@ -127,6 +167,12 @@ absl::Status ContinuousTrajectory<Frame>::Append(
   return status;
 }
 
+template<typename Frame>
+bool ContinuousTrajectory<Frame>::next_append_fits() const {
+  absl::ReaderMutexLock l(&lock_);
+  return last_points_.size() == divisions;
+}
+
 template<typename Frame>
 void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
   absl::MutexLock l1(&lock_);
@@ -145,6 +191,7 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
     degree_ = prefix.degree_;
     degree_age_ = prefix.degree_age_;
     polynomials_ = std::move(prefix.polynomials_);
+    cold_blocks_ = std::move(prefix.cold_blocks_);
     last_accessed_polynomial_ = prefix.last_accessed_polynomial_;
     first_time_ = prefix.first_time_;
     last_points_ = prefix.last_points_;
@@ -155,6 +202,19 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
     // library, so we cannot check that the trajectories are "continuous" at the
     // junction.
     CHECK_EQ(*first_time_, prefix.polynomials_.back().t_max);
+    // The cold blocks of this object are shifted by the size of |prefix|, and
+    // their indices in |cold_blocks_| change.
+    for (auto& block : cold_blocks_) {
+      block.first += prefix.polynomials_.size();
+    }
+    std::move(cold_blocks_.begin(),
+              cold_blocks_.end(),
+              std::back_inserter(prefix.cold_blocks_));
+    cold_blocks_.swap(prefix.cold_blocks_);
+    {
+      absl::MutexLock l3(&hot_blocks_lock_);
+      hot_blocks_.clear();
+    }
     // This operation is in O(prefix.size()).
     std::move(polynomials_.begin(),
               polynomials_.end(),
@@ -167,6 +227,49 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
   }
 }
 
+template<typename Frame>
+void ContinuousTrajectory<Frame>::CompressBefore(Instant const& t) {
+  absl::MutexLock l(&lock_);
+  // The polynomials before the first cold block, if any, were prepended and
+  // remain hot.
+  std::int64_t first = cold_blocks_.empty()
+                           ? 0
+                           : cold_blocks_.back().first + cold_block_size;
+  std::int64_t const end =
+      std::upper_bound(polynomials_.begin(),
+                       polynomials_.end(),
+                       t,
+                       [](Instant const& left,
+                          InstantPolynomialPair const& right) {
+                         return left < right.t_max;
+                       }) -
+      polynomials_.begin();
+  for (; first + cold_block_size <= end; first += cold_block_size) {
+    cold_blocks_.push_back(CompressLocked(first));
+    for (std::int64_t i = first; i < first + cold_block_size; ++i) {
+      polynomials_[i].polynomial.reset();
+    }
+  }
+}
+
+template<typename Frame>
+std::int64_t ContinuousTrajectory<Frame>::polynomials_memory_size() const {
+  absl::ReaderMutexLock l(&lock_);
+  std::int64_t size = polynomials_.capacity() * sizeof(InstantPolynomialPair);
+  for (auto const& pair : polynomials_) {
+    if (pair.polynomial != nullptr) {
+      // The coefficients, the origin and the virtual table pointer.
+      size += (pair.polynomial->degree() + 1) * sizeof(Position<Frame>) +
+              sizeof(Instant) + sizeof(void*);
+    }
+  }
+  size += cold_blocks_.capacity() * sizeof(ColdBlock);
+  for (auto const& block : cold_blocks_) {
+    size += block.degrees.capacity() + block.zfp.capacity();
+  }
+  return size;
+}
+
 template<typename Frame>
 Instant ContinuousTrajectory<Frame>::t_min() const {
   absl::ReaderMutexLock l(&lock_);
@@ -212,8 +315,9 @@ int ContinuousTrajectory<Frame>::PiecewisePoissonSeriesDegree(
   auto const it_min = FindPolynomialForInstantLocked(t_min);
   auto const it_max = FindPolynomialForInstantLocked(t_max);
   int degree = min_degree;
+  std::shared_ptr<HotBlock const> hot_block;
   for (auto it = it_min;; ++it) {
-    degree = std::max(degree, it->polynomial->degree());
+    degree = std::max(degree, PolynomialLocked(it, hot_block).degree());
     if (it == it_max) {
       break;
     }
@@ -305,12 +409,14 @@ ContinuousTrajectory<Frame>::ToPiecewisePoissonSeries(
   auto const it_min = FindPolynomialForInstantLocked(t_min);
   auto const it_max = FindPolynomialForInstantLocked(t_max);
   Instant current_t_min = t_min;
+  std::shared_ptr<HotBlock const> hot_block;
   for (auto it = it_min;; ++it) {
     Instant const current_t_max = std::min(t_max, it->t_max);
     Interval<Instant> interval;
     interval.Include(current_t_min);
     interval.Include(current_t_max);
-    auto const polynomial_cast_to_degree = cast_to_degree(it->polynomial.get());
+    auto const polynomial_cast_to_degree =
+        cast_to_degree(&PolynomialLocked(it, hot_block));
     if (result == nullptr) {
       result = std::make_unique<PiecewisePoisson>(
           interval, Poisson(polynomial_cast_to_degree, {{}}));
@@ -342,16 +448,36 @@ void ContinuousTrajectory<Frame>::WriteToMessage(
   // true since Fatou (#2149), but we maintain compatibility with older saves,
   // see #3039.  When such an old save is rewritten, we end up with polynomials
   // before the oldest checkpoint.
-  for (auto const& pair : polynomials_) {
-    Instant const& t_max = pair.t_max;
-    auto const& polynomial = pair.polynomial;
-    if (t_max <= checkpointer_->oldest_checkpoint()) {
-      auto* const pair = message->add_instant_polynomial_pair();
-      t_max.WriteToMessage(pair->mutable_t_max());
-      polynomial->WriteToMessage(pair->mutable_polynomial());
-    } else {
+  // The blocks of the cold tier are written as they are, so that reading them
+  // back yields the same polynomials.  A block that extends past the oldest
+  // checkpoint is written decompressed, as far as the checkpoint.
+  std::shared_ptr<HotBlock const> hot_block;
+  auto cold_block = cold_blocks_.cbegin();
+  for (auto it = polynomials_.cbegin(); it != polynomials_.cend(); ++it) {
+    Instant const& t_max = it->t_max;
+    if (t_max > checkpointer_->oldest_checkpoint()) {
       break;
     }
+    std::int64_t const index = it - polynomials_.cbegin();
+    if (cold_block != cold_blocks_.cend() && cold_block->first == index) {
+      auto const last = it + (cold_block_size - 1);
+      if (last->t_max <= checkpointer_->oldest_checkpoint()) {
+        auto* const block = message->add_cold_block();
+        block->set_first(index);
+        for (auto p = it; p != std::next(last); ++p) {
+          p->t_max.WriteToMessage(block->add_t_max());
+        }
+        block->set_degree(std::string(cold_block->degrees.begin(),
+                                      cold_block->degrees.end()));
+        block->set_zfp(cold_block->zfp);
+        it = last;
+        ++cold_block;
+        continue;
+      }
+    }
+    auto* const pair = message->add_instant_polynomial_pair();
+    t_max.WriteToMessage(pair->mutable_t_max());
+    PolynomialLocked(it, hot_block).WriteToMessage(pair->mutable_polynomial());
   }
   if (first_time_) {
     first_time_->WriteToMessage(message->mutable_first_time());
@@ -411,6 +537,29 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
               error_estimate));
     }
   } else {
+    // The cold blocks are interleaved with the pairs based on their index.
+    auto next_cold_block = message.cold_block().begin();
+    auto const read_cold_blocks = [&continuous_trajectory,
+                                   &message,
+                                   &next_cold_block]() {
+      auto& polynomials = continuous_trajectory->polynomials_;
+      while (next_cold_block != message.cold_block().end() &&
+             next_cold_block->first() ==
+                 static_cast<std::int64_t>(polynomials.size())) {
+        CHECK_EQ(cold_block_size, next_cold_block->t_max_size());
+        CHECK_EQ(cold_block_size, next_cold_block->degree().size());
+        auto const& degree = next_cold_block->degree();
+        continuous_trajectory->cold_blocks_.push_back(
+            {.first = next_cold_block->first(),
+             .degrees = std::vector<std::int8_t>(degree.begin(), degree.end()),
+             .zfp = next_cold_block->zfp()});
+        for (auto const& t_max : next_cold_block->t_max()) {
+          polynomials.emplace_back(Instant::ReadFromMessage(t_max));
+        }
+        ++next_cold_block;
+      }
+    };
+    read_cold_blocks();
     for (auto const& pair : message.instant_polynomial_pair()) {
       if (is_pre_gröbner) {
         // The easiest way to implement compatibility is to patch the serialized
@@ -434,7 +583,9 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
             Polynomial<Position<Frame>, Instant>::template ReadFromMessage<
                 EstrinEvaluator>(pair.polynomial()));
       }
+      read_cold_blocks();
     }
+    CHECK(next_cold_block == message.cold_block().end());
   }
   if (message.has_first_time()) {
     continuous_trajectory->first_time_ =
@@ -549,6 +700,7 @@ ContinuousTrajectory<Frame>::MakeCheckpointerReader() {
 
       // Restore the other members to their state at the time of the checkpoint.
       if (last_points_.empty()) {
+        ThawLocked(/*index=*/0);
         polynomials_.clear();
         first_time_ = std::nullopt;
       } else {
@@ -566,6 +718,7 @@ ContinuousTrajectory<Frame>::MakeCheckpointerReader() {
                                 InstantPolynomialPair const& right) {
                                return left < right.t_max;
                              });
+        ThawLocked(/*index=*/it - polynomials_.begin());
         polynomials_.erase(it, polynomials_.end());
         if (polynomials_.empty()) {
           first_time_ = oldest_time;
@@ -603,7 +756,8 @@ Position<Frame> ContinuousTrajectory<Frame>::EvaluatePositionLocked(
   CHECK_GE(t_max_locked(), time);
   auto const it = FindPolynomialForInstantLocked(time);
   CHECK(it != polynomials_.end());
-  auto const& polynomial = *it->polynomial;
+  std::shared_ptr<HotBlock const> hot_block;
+  auto const& polynomial = PolynomialLocked(it, hot_block);
   return polynomial(time);
 }
 
@@ -614,7 +768,8 @@ Velocity<Frame> ContinuousTrajectory<Frame>::EvaluateVelocityLocked(
   CHECK_GE(t_max_locked(), time);
   auto const it = FindPolynomialForInstantLocked(time);
   CHECK(it != polynomials_.end());
-  auto const& polynomial = *it->polynomial;
+  std::shared_ptr<HotBlock const> hot_block;
+  auto const& polynomial = PolynomialLocked(it, hot_block);
   return polynomial.EvaluateDerivative(time);
 }
 
@@ -626,7 +781,8 @@ ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedomLocked(
   CHECK_GE(t_max_locked(), time);
   auto const it = FindPolynomialForInstantLocked(time);
   CHECK(it != polynomials_.end());
-  auto const& polynomial = *it->polynomial;
+  std::shared_ptr<HotBlock const> hot_block;
+  auto const& polynomial = PolynomialLocked(it, hot_block);
   return DegreesOfFreedom<Frame>(polynomial(time),
                                  polynomial.EvaluateDerivative(time));
 }
@@ -647,6 +803,11 @@ ContinuousTrajectory<Frame>::InstantPolynomialPair::InstantPolynomialPair(
     : t_max(t_max),
       polynomial(std::move(polynomial)) {}
 
+template<typename Frame>
+ContinuousTrajectory<Frame>::InstantPolynomialPair::InstantPolynomialPair(
+    Instant const t_max)
+    : t_max(t_max) {}
+
 template<typename Frame>
 not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
 ContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
@@ -663,6 +824,19 @@ ContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
                                                error_estimate);
 }
 
+template<typename Frame>
+Displacement<Frame>
+ContinuousTrajectory<Frame>::NewhallApproximationErrorEstimate(
+    int const degree,
+    std::vector<Position<Frame>> const& q,
+    std::vector<Velocity<Frame>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) const {
+  return numerics::_newhall::NewhallApproximationErrorEstimate(degree,
+                                                               q, v,
+                                                               t_min, t_max);
+}
+
 template<typename Frame>
 absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     Instant const& time,
@@ -682,18 +856,16 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     degree_age_ = 0;
   }
 
-  // Compute the approximation with the current degree.
-  Displacement<Frame> displacement_error_estimate;
-  polynomials_.emplace_back(time,
-                            NewhallApproximationInMonomialBasis(
-                                degree_,
-                                q, v,
-                                last_points_.cbegin()->first, time,
-                                displacement_error_estimate));
+  // Only the error estimates are computed while searching for the best degree.
+  // They are much cheaper than the approximation, which is only computed once,
+  // for the chosen degree.
+  Instant const t_min = last_points_.cbegin()->first;
 
-  // Estimate the error.  For initializing |previous_error_estimate|, any value
-  // greater than |error_estimate| will do.
-  Length error_estimate = displacement_error_estimate.Norm();
+  // Estimate the error with the current degree.  For initializing
+  // |previous_error_estimate|, any value greater than |error_estimate| will
+  // do.
+  Length error_estimate =
+      NewhallApproximationErrorEstimate(degree_, q, v, t_min, time).Norm();
   Length previous_error_estimate = error_estimate + error_estimate;
 
   // If we are in the zone of numerical instabilities and we exceeded the
@@ -721,15 +893,21 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     ++degree_;
     VLOG(1) << "Increasing degree for " << this << " to " <<degree_
             << " because error estimate was " << error_estimate;
-    polynomials_.back().polynomial = NewhallApproximationInMonomialBasis(
-                                         degree_,
-                                         q, v,
-                                         last_points_.cbegin()->first, time,
-                                         displacement_error_estimate);
     previous_error_estimate = error_estimate;
-    error_estimate = displacement_error_estimate.Norm();
+    error_estimate =
+        NewhallApproximationErrorEstimate(degree_, q, v, t_min, time).Norm();
   }
 
+  // The approximation has the degree of the last error estimate, even if we
+  // revert to a lower degree below for the next approximations.
+  Displacement<Frame> displacement_error_estimate;
+  polynomials_.emplace_back(time,
+                            NewhallApproximationInMonomialBasis(
+                                degree_,
+                                q, v,
+                                t_min, time,
+                                displacement_error_estimate));
+
   // If we have entered the zone of numerical instability, go back to the
   // point where the error was decreasing and nudge the tolerance since we
   // won't be able to reliably do better than that.
@@ -793,6 +971,176 @@ ContinuousTrajectory<Frame>::FindPolynomialForInstantLocked(
   }
 }
 
+template<typename Frame>
+Polynomial<Position<Frame>, Instant> const&
+ContinuousTrajectory<Frame>::PolynomialLocked(
+    typename InstantPolynomialPairs::const_iterator const it,
+    std::shared_ptr<HotBlock const>& hot_block) const {
+  if (it->polynomial != nullptr) {
+    return *it->polynomial;
+  }
+
+  std::int64_t const index = it - polynomials_.begin();
+  auto const block =
+      std::prev(std::upper_bound(cold_blocks_.begin(),
+                                 cold_blocks_.end(),
+                                 index,
+                                 [](std::int64_t const left,
+                                    ColdBlock const& right) {
+                                   return left < right.first;
+                                 }));
+  std::int64_t const block_index = block - cold_blocks_.begin();
+
+  absl::MutexLock l(&hot_blocks_lock_);
+  auto hot = std::find_if(hot_blocks_.begin(),
+                          hot_blocks_.end(),
+                          [block_index](auto const& pair) {
+                            return pair.first == block_index;
+                          });
+  if (hot == hot_blocks_.end()) {
+    hot_blocks_.emplace_front(
+        block_index,
+        std::make_shared<HotBlock const>(DecompressLocked(*block)));
+    if (hot_blocks_.size() > max_hot_blocks) {
+      hot_blocks_.pop_back();
+    }
+  } else {
+    hot_blocks_.splice(hot_blocks_.begin(), hot_blocks_, hot);
+  }
+  hot_block = hot_blocks_.front().second;
+  return *(*hot_block)[index - block->first];
+}
+
+template<typename Frame>
+typename ContinuousTrajectory<Frame>::ColdBlock
+ContinuousTrajectory<Frame>::CompressLocked(std::int64_t const first) const {
+  ColdBlock block{.first = first};
+  block.degrees.reserve(cold_block_size);
+  int block_degree = min_degree;
+  for (std::int64_t i = first; i < first + cold_block_size; ++i) {
+    int const degree = polynomials_[i].polynomial->degree();
+    block.degrees.push_back(degree);
+    block_degree = std::max(block_degree, degree);
+  }
+
+  // The coefficients are laid out in rows, one for each degree and coordinate,
+  // so that the coefficients of consecutive polynomials, which are correlated,
+  // end up in the same ZFP blocks.  Missing coefficients are zero.  The
+  // coefficients of degree 0 are positions, whose ulp may exceed the accuracy
+  // of the other coefficients, so they are stored losslessly with the origins.
+  std::vector<double> lossless(4 * cold_block_size);
+  std::vector<double> coefficients(3 * block_degree * cold_block_size);
+  for (std::int64_t j = 0; j < cold_block_size; ++j) {
+    Time const half_interval = HalfIntervalLocked(first + j);
+    WithDegree(block.degrees[j], [&]<int degree>(
+                                     std::integral_constant<int, degree>) {
+      auto const& polynomial = dynamic_cast<
+          PolynomialInMonomialBasis<Position<Frame>, Instant,
+                                    degree, EstrinEvaluator> const&>(
+          *polynomials_[first + j].polynomial);
+      auto const& c = polynomial.coefficients();
+      auto const& position = (std::get<0>(c) - Frame::origin).coordinates();
+      lossless[0 * cold_block_size + j] =
+          (polynomial.origin() - Instant()) / Second;
+      lossless[1 * cold_block_size + j] = position.x / Metre;
+      lossless[2 * cold_block_size + j] = position.y / Metre;
+      lossless[3 * cold_block_size + j] = position.z / Metre;
+      auto const encode = [&]<int k>() {
+        auto const& coordinates =
+            (std::get<k>(c) * Pow<k>(half_interval)).coordinates();
+        coefficients[(3 * k - 3) * cold_block_size + j] = coordinates.x / Metre;
+        coefficients[(3 * k - 2) * cold_block_size + j] = coordinates.y / Metre;
+        coefficients[(3 * k - 1) * cold_block_size + j] = coordinates.z / Metre;
+      };
+      [&encode]<int... k>(std::integer_sequence<int, k...>) {
+        (encode.template operator()<k + 1>(), ...);
+      }(std::make_integer_sequence<int, degree>());
+    });
+  }
+
+  // Each coefficient of degree k > 0 contributes at most its absolute error to
+  // the error on the position.
+  ZfpCompressor const lossless_compressor(0);
+  ZfpCompressor const coefficient_compressor(
+      cold_tolerance_fraction * tolerance_ / (block_degree * Metre));
+  lossless_compressor.WriteToMessageMultidimensional<2>(lossless, &block.zfp);
+  coefficient_compressor.WriteToMessageMultidimensional<2>(coefficients,
+                                                           &block.zfp);
+  block.zfp.shrink_to_fit();
+  return block;
+}
+
+template<typename Frame>
+typename ContinuousTrajectory<Frame>::HotBlock
+ContinuousTrajectory<Frame>::DecompressLocked(ColdBlock const& block) const {
+  int const block_degree =
+      *std::max_element(block.degrees.begin(), block.degrees.end());
+  std::vector<double> lossless(4 * cold_block_size);
+  std::vector<double> coefficients(3 * block_degree * cold_block_size);
+  ZfpCompressor decompressor;
+  std::string_view zfp(block.zfp.data(), block.zfp.size());
+  decompressor.ReadFromMessageMultidimensional<2>(lossless, zfp);
+  decompressor.ReadFromMessageMultidimensional<2>(coefficients, zfp);
+
+  HotBlock hot_block;
+  hot_block.reserve(cold_block_size);
+  for (std::int64_t j = 0; j < cold_block_size; ++j) {
+    Time const half_interval = HalfIntervalLocked(block.first + j);
+    WithDegree(block.degrees[j], [&]<int degree>(
+                                     std::integral_constant<int, degree>) {
+      using P = PolynomialInMonomialBasis<Position<Frame>, Instant,
+                                          degree, EstrinEvaluator>;
+      typename P::Coefficients c;
+      std::get<0>(c) =
+          Frame::origin +
+          Displacement<Frame>({lossless[1 * cold_block_size + j] * Metre,
+                               lossless[2 * cold_block_size + j] * Metre,
+                               lossless[3 * cold_block_size + j] * Metre});
+      auto const decode = [&]<int k>() {
+        Displacement<Frame> const homogeneous(
+            {coefficients[(3 * k - 3) * cold_block_size + j] * Metre,
+             coefficients[(3 * k - 2) * cold_block_size + j] * Metre,
+             coefficients[(3 * k - 1) * cold_block_size + j] * Metre});
+        std::get<k>(c) = homogeneous / Pow<k>(half_interval);
+      };
+      [&decode]<int... k>(std::integer_sequence<int, k...>) {
+        (decode.template operator()<k + 1>(), ...);
+      }(std::make_integer_sequence<int, degree>());
+      hot_block.push_back(make_not_null_unique<P>(
+          c, Instant() + lossless[0 * cold_block_size + j] * Second));
+    });
+  }
+  return hot_block;
+}
+
+template<typename Frame>
+void ContinuousTrajectory<Frame>::ThawLocked(std::int64_t const index) {
+  lock_.AssertHeld();
+  if (cold_blocks_.empty() ||
+      cold_blocks_.back().first + cold_block_size <= index) {
+    return;
+  }
+  while (!cold_blocks_.empty() &&
+         cold_blocks_.back().first + cold_block_size > index) {
+    ColdBlock const& block = cold_blocks_.back();
+    HotBlock hot_block = DecompressLocked(block);
+    for (std::int64_t j = 0; j < cold_block_size; ++j) {
+      polynomials_[block.first + j].polynomial = std::move(hot_block[j]);
+    }
+    cold_blocks_.pop_back();
+  }
+  absl::MutexLock l(&hot_blocks_lock_);
+  hot_blocks_.clear();
+}
+
+template<typename Frame>
+Time ContinuousTrajectory<Frame>::HalfIntervalLocked(
+    std::int64_t const index) const {
+  Instant const& t_min =
+      index == 0 ? *first_time_ : polynomials_[index - 1].t_max;
+  return 0.5 * (polynomials_[index].t_max - t_min);
+}
+
 }  // namespace internal
 }  // namespace _continuous_trajectory
 }  // namespace physics
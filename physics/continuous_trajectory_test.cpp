@@ -1,6 +1,7 @@
 #include "physics/continuous_trajectory.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <limits>
@@ -29,6 +30,7 @@
 namespace principia {
 namespace physics {
 
+using ::testing::Lt;
 using ::testing::Sequence;
 using ::testing::SetArgReferee;
 using ::testing::_;
@@ -65,7 +67,14 @@ class TestableContinuousTrajectory : public ContinuousTrajectory<Frame> {
       Instant const& t_min,
       Instant const& t_max,
       Displacement<Frame>& error_estimate) const override;
+  Displacement<Frame> NewhallApproximationErrorEstimate(
+      int degree,
+      std::vector<Position<Frame>> const& q,
+      std::vector<Velocity<Frame>> const& v,
+      Instant const& t_min,
+      Instant const& t_max) const override;
 
+  // Called for each error estimate.
   MOCK_METHOD(
       void,
       FillNewhallApproximationInMonomialBasis,
@@ -104,14 +113,27 @@ TestableContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
                 Position<Frame>, Instant, /*degree=*/1, HornerEvaluator>;
   typename P::Coefficients const coefficients = {Position<Frame>(),
                                                  Velocity<Frame>()};
-  not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
-      polynomial = make_not_null_unique<P>(coefficients, Instant());
+  return make_not_null_unique<P>(coefficients, Instant());
+}
+
+template<typename Frame>
+Displacement<Frame>
+TestableContinuousTrajectory<Frame>::NewhallApproximationErrorEstimate(
+    int const degree,
+    std::vector<Position<Frame>> const& q,
+    std::vector<Velocity<Frame>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) const {
+  Displacement<Frame> error_estimate;
+  auto polynomial =
+      NewhallApproximationInMonomialBasis(degree, q, v, t_min, t_max,
+                                          error_estimate);
   FillNewhallApproximationInMonomialBasis(degree,
                                           q, v,
                                           t_min, t_max,
                                           error_estimate,
                                           polynomial);
-  return polynomial;
+  return error_estimate;
 }
 
 template<typename Frame>
@@ -619,6 +641,121 @@ TEST_F(ContinuousTrajectoryTest, Continuity) {
   EXPECT_THAT(p1, AlmostEquals(p3, 0, 2));
 }
 
+TEST_F(ContinuousTrajectoryTest, NextAppendFits) {
+  Time const step = 1 * Second;
+  Velocity<World> const velocity({1 * Metre / Second,
+                                  0 * Metre / Second,
+                                  0 * Metre / Second});
+  auto const trajectory = std::make_unique<ContinuousTrajectory<World>>(
+                              step,
+                              /*tolerance=*/1 * Milli(Metre));
+  int number_of_fits = 0;
+  for (int i = 0; i < 30; ++i) {
+    Instant const t = t0_ + i * step;
+    bool const fits = trajectory->next_append_fits();
+    Instant const t_max = trajectory->t_max();
+    EXPECT_OK(trajectory->Append(
+        t, DegreesOfFreedom<World>(World::origin + (t - t0_) * velocity,
+                                   velocity)));
+    // A fit is exactly what makes the trajectory longer.
+    EXPECT_EQ(fits, trajectory->t_max() != t_max) << i;
+    number_of_fits += fits;
+  }
+  EXPECT_EQ(3, number_of_fits);
+}
+
+TEST_F(ContinuousTrajectoryTest, CompressBefore) {
+  int const number_of_steps = 3000;
+  Length const distance = 1000 * Kilo(Metre);
+  Time const period = 1 * Hour;
+  Time const step = 10 * Second;
+  Length const tolerance = 1 * Milli(Metre);
+
+  auto position_function = [this, distance, period](Instant const t) {
+    Angle const angle = 2 * π * Radian * (t - t0_) / period;
+    return World::origin +
+        Displacement<World>({
+            distance * Cos(angle),
+            distance * Sin(angle),
+            0 * Metre});
+  };
+  auto velocity_function = [this, distance, period](Instant const t) {
+    AngularFrequency const ω = 2 * π * Radian / period;
+    Angle const angle = ω * (t - t0_);
+    return Velocity<World>({
+        -ω * distance * Sin(angle) / Radian,
+        ω * distance * Cos(angle) / Radian,
+        0 * Metre / Second});
+  };
+
+  auto const trajectory =
+      std::make_unique<ContinuousTrajectory<World>>(step, tolerance);
+  FillTrajectory(number_of_steps,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_,
+                 *trajectory);
+
+  std::vector<Instant> times;
+  std::vector<DegreesOfFreedom<World>> hot_degrees_of_freedom;
+  for (Instant t = trajectory->t_min();
+       t <= trajectory->t_max();
+       t += 7.3 * Second) {
+    times.push_back(t);
+    hot_degrees_of_freedom.push_back(trajectory->EvaluateDegreesOfFreedom(t));
+  }
+  double const average_degree = trajectory->average_degree();
+  std::int64_t const hot_size = trajectory->polynomials_memory_size();
+
+  // Only complete blocks are compressed, so the last polynomials remain hot.
+  trajectory->CompressBefore(trajectory->t_max());
+  EXPECT_EQ(average_degree, trajectory->average_degree());
+  EXPECT_LT(trajectory->polynomials_memory_size(), hot_size);
+
+  // Evaluate backwards to exercise the eviction of the decompressed blocks.
+  for (int i = static_cast<int>(times.size()) - 1; i >= 0; --i) {
+    DegreesOfFreedom<World> const cold_degrees_of_freedom =
+        trajectory->EvaluateDegreesOfFreedom(times[i]);
+    EXPECT_THAT((cold_degrees_of_freedom.position() -
+                 hot_degrees_of_freedom[i].position()).Norm(),
+                Lt(0.01 * tolerance)) << times[i];
+    EXPECT_THAT((cold_degrees_of_freedom.velocity() -
+                 hot_degrees_of_freedom[i].velocity()).Norm(),
+                Lt(0.01 * tolerance / Second)) << times[i];
+  }
+
+  // The cold blocks are serialized as they are, so the trajectory read back
+  // is identical to the compressed one.
+  trajectory->WriteToCheckpoint(trajectory->t_max());
+  serialization::ContinuousTrajectory message;
+  trajectory->WriteToMessage(&message);
+  EXPECT_LT(0, message.cold_block_size());
+  EXPECT_LT(0, message.instant_polynomial_pair_size());
+  auto const trajectory_read = ContinuousTrajectory<World>::ReadFromMessage(
+      /*desired_t_min=*/InfiniteFuture,
+      message);
+  EXPECT_LT(trajectory_read->polynomials_memory_size(), hot_size);
+  for (Instant const& t : times) {
+    EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(t),
+              trajectory_read->EvaluateDegreesOfFreedom(t)) << t;
+  }
+  serialization::ContinuousTrajectory second_message;
+  trajectory_read->WriteToMessage(&second_message);
+  EXPECT_THAT(message, EqualsProto(second_message));
+
+  // Appending is not affected by compression.
+  FillTrajectory(number_of_steps,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_ + number_of_steps * step,
+                 *trajectory);
+  EXPECT_THAT((trajectory->EvaluatePosition(times.back()) -
+               hot_degrees_of_freedom.back().position()).Norm(),
+              Lt(0.01 * tolerance));
+}
+
 TEST_F(ContinuousTrajectoryTest, Prepend) {
   int const number_of_steps1 = 20;
   int const number_of_steps2 = 15;
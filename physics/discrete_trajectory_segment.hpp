@@ -1,12 +1,14 @@
 #pragma once
 
 #include <cstdint>
+#include <future>
 #include <iterator>
 #include <optional>
 #include <vector>
 
 #include "absl/container/btree_map.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
@@ -16,6 +18,7 @@
 #include "physics/discrete_trajectory_segment_iterator.hpp"
 #include "physics/discrete_trajectory_types.hpp"
 #include "physics/trajectory.hpp"
+#include "quantities/quantities.hpp"
 #include "serialization/physics.pb.h"
 
 namespace principia {
@@ -50,6 +53,7 @@ using namespace principia::physics::_discrete_trajectory_iterator;
 using namespace principia::physics::_discrete_trajectory_segment_iterator;
 using namespace principia::physics::_discrete_trajectory_types;
 using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_quantities;
 
 template<typename Frame>
 class DiscreteTrajectorySegment : public Trajectory<Frame> {
@@ -189,9 +193,27 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
 
   // Called by |Append| after appending a point to this segment.  If
   // appropriate, performs downsampling and deletes some of the points of the
-  // segment.
+  // segment.  With asynchronous downsampling, the fit is started here and its
+  // result is applied by a later call.
   absl::Status DownsampleIfNeeded();
 
+  // Waits for the pending asynchronous fit, if any, and applies it.
+  absl::Status AwaitDownsampling();
+
+  // Returns the indices in |dense_points| of the right endpoints of the Hermite
+  // fit of these points; the last index is the start of the new dense span.
+  static absl::StatusOr<std::vector<std::int64_t>> FitDensePoints(
+      std::vector<value_type> const& dense_points,
+      Length const& tolerance);
+
+  // Erases the points that are not |right_endpoints| among the
+  // |number_of_points| points starting at |first_time|, which are the dense
+  // points on which the fit was computed.  This is done in a single pass over
+  // the timeline.
+  void ApplyDownsampling(Instant const& first_time,
+                         std::int64_t number_of_points,
+                         std::vector<std::int64_t> const& right_endpoints);
+
   // Returns the Hermite interpolation for the left-open, right-closed
   // trajectory segment bounded above by |upper|.
   Hermite3<Instant, Position<Frame>> GetInterpolation(
@@ -223,6 +245,16 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
 
   bool was_downsampled_ = false;
 
+  // A fit of the dense points running on a background thread.  It is dropped
+  // by any operation other than |Append| that changes the timeline, in which
+  // case the points stay dense and are fitted again by a later |Append|.
+  struct PendingDownsampling {
+    Instant first_time;
+    std::int64_t number_of_points;
+    std::future<absl::StatusOr<std::vector<std::int64_t>>> right_endpoints;
+  };
+  std::optional<PendingDownsampling> pending_downsampling_;
+
   DiscreteTrajectorySegmentIterator<Frame> self_;
   Timeline timeline_;
 
@@ -3,12 +3,16 @@
 #include "physics/discrete_trajectory_segment.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <iterator>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/container/btree_set.h"
+#include "base/thread_pool.hpp"
 #include "base/zfp_compressor.hpp"
 #include "glog/logging.h"
 #include "numerics/fit_hermite_spline.hpp"
@@ -20,11 +24,22 @@ namespace physics {
 namespace _discrete_trajectory_segment {
 namespace internal {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_zfp_compressor;
 using namespace principia::numerics::_fit_hermite_spline;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+// The pool on which the segments with asynchronous downsampling fit their dense
+// points.  Shared by all the segments.
+inline ThreadPool<absl::StatusOr<std::vector<std::int64_t>>>&
+DownsamplingThreadPool() {
+  static auto* const thread_pool =
+      new ThreadPool<absl::StatusOr<std::vector<std::int64_t>>>(
+          /*pool_size=*/HardwareConcurrency());
+  return *thread_pool;
+}
+
 template<typename Frame>
 DiscreteTrajectorySegment<Frame>::DiscreteTrajectorySegment(
     DiscreteTrajectorySegmentIterator<Frame> const self)
@@ -93,6 +108,7 @@ std::int64_t DiscreteTrajectorySegment<Frame>::size() const {
 
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::clear() {
+  pending_downsampling_.reset();
   downsampling_parameters_.reset();
   number_of_dense_points_ = 0;
   was_downsampled_ = false;
@@ -175,12 +191,14 @@ void DiscreteTrajectorySegment<Frame>::SetDownsampling(
   // more are unclear.  Let's not do that.
   CHECK_LE(timeline_.size(), 1);
   CHECK(!was_downsampled_);
+  pending_downsampling_.reset();
   downsampling_parameters_ = downsampling_parameters;
   number_of_dense_points_ = timeline_.empty() ? 0 : 1;
 }
 
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::ClearDownsampling() {
+  pending_downsampling_.reset();
   downsampling_parameters_ = std::nullopt;
 }
 
@@ -382,6 +400,7 @@ void DiscreteTrajectorySegment<Frame>::ForgetAfter(Instant const& t) {
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::ForgetAfter(
     typename Timeline::const_iterator const begin) {
+  pending_downsampling_.reset();
   std::int64_t number_of_points_to_remove =
       std::distance(begin, timeline_.cend());
   number_of_dense_points_ =
@@ -399,6 +418,7 @@ void DiscreteTrajectorySegment<Frame>::ForgetBefore(Instant const& t) {
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::ForgetBefore(
     typename Timeline::const_iterator const end) {
+  pending_downsampling_.reset();
   std::int64_t const number_of_points_to_remove =
       std::distance(timeline_.cbegin(), end);
   std::int64_t const number_of_dense_points_to_remove = std::max<std::int64_t>(
@@ -443,6 +463,7 @@ absl::Status DiscreteTrajectorySegment<Frame>::Append(
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::Merge(
     DiscreteTrajectorySegment<Frame> segment) {
+  pending_downsampling_.reset();
   if (segment.timeline_.empty()) {
     return;
   } else if (timeline_.empty()) {
@@ -515,62 +536,138 @@ template<typename Frame>
 absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
   ++number_of_dense_points_;
   // Points, hence one more than intervals.
-  if (number_of_dense_points_ >
-      downsampling_parameters_->max_dense_intervals) {
-    // Obtain iterators for all the dense points of the segment.
-    using ConstIterators = std::vector<typename Timeline::const_iterator>;
-    ConstIterators dense_iterators(number_of_dense_points_);
-    CHECK_LE(dense_iterators.size(), timeline_.size());
-    auto it = timeline_.crbegin();
-    for (int i = dense_iterators.size() - 1; i >= 0; --i) {
-      dense_iterators[i] = std::prev(it.base());
-      ++it;
-    }
+  auto const must_downsample = [this]() {
+    return number_of_dense_points_ >
+           downsampling_parameters_->max_dense_intervals;
+  };
 
-    absl::StatusOr<std::list<typename ConstIterators::const_iterator>>
-        right_endpoints = FitHermiteSpline<Instant, Position<Frame>>(
-            dense_iterators,
-            [](auto&& it) -> auto&& { return it->time; },
-            [](auto&& it) -> auto&& {
-              return it->degrees_of_freedom.position();
-            },
-            [](auto&& it) -> auto&& {
-              return it->degrees_of_freedom.velocity();
-            },
-            downsampling_parameters_->tolerance);
-    if (!right_endpoints.ok()) {
-      // Note that the actual appending took place; the propagated status only
-      // reflects a lack of downsampling.
-      return right_endpoints.status();
+  // Apply the result of a background fit as soon as it is available.  Only
+  // block on it if the points appended since it was started (plus the last
+  // point of the fit, which stays dense) would themselves call for a new fit.
+  absl::Status status;
+  if (pending_downsampling_.has_value()) {
+    bool const must_await =
+        number_of_dense_points_ - pending_downsampling_->number_of_points + 1 >
+        downsampling_parameters_->max_dense_intervals;
+    if (!must_await &&
+        pending_downsampling_->right_endpoints.wait_for(
+            std::chrono::seconds(0)) != std::future_status::ready) {
+      return absl::OkStatus();
     }
+    status = AwaitDownsampling();
+  }
 
-    if (right_endpoints->empty()) {
-      right_endpoints->push_back(std::prev(dense_iterators.end()));
+  if (must_downsample()) {
+    // Copy all the dense points of the segment.
+    std::vector<value_type> dense_points;
+    dense_points.reserve(number_of_dense_points_);
+    CHECK_LE(number_of_dense_points_, timeline_size());
+    for (auto it = std::prev(timeline_.cend(), number_of_dense_points_);
+         it != timeline_.cend();
+         ++it) {
+      dense_points.push_back(*it);
     }
-
-    // Obtain the times for the right endpoints.  This is necessary because we
-    // cannot use iterators for erasing points, as they would get invalidated
-    // after the first erasure.
-    std::vector<Instant> right_endpoints_times;
-    right_endpoints_times.reserve(right_endpoints.value().size());
-    for (auto const& it_in_dense_iterators : right_endpoints.value()) {
-      right_endpoints_times.push_back((*it_in_dense_iterators)->time);
+    Instant const first_time = dense_points.front().time;
+    std::int64_t const number_of_points = dense_points.size();
+    Length const tolerance = downsampling_parameters_->tolerance;
+
+    if (downsampling_parameters_->asynchronous) {
+      auto const shared_dense_points =
+          std::make_shared<std::vector<value_type> const>(
+              std::move(dense_points));
+      pending_downsampling_ = PendingDownsampling{
+          .first_time = first_time,
+          .number_of_points = number_of_points,
+          .right_endpoints = DownsamplingThreadPool().Add(
+              [shared_dense_points, tolerance]() {
+                return FitDensePoints(*shared_dense_points, tolerance);
+              })};
+    } else {
+      auto const right_endpoints = FitDensePoints(dense_points, tolerance);
+      if (!right_endpoints.ok()) {
+        // Note that the actual appending took place; the propagated status
+        // only reflects a lack of downsampling.
+        return right_endpoints.status();
+      }
+      ApplyDownsampling(first_time, number_of_points, *right_endpoints);
     }
+  }
+  return status;
+}
 
-    // Poke holes in the timeline at the places given by
-    // |right_endpoints_times|.  This requires one lookup per erasure.
-    auto left_it = dense_iterators.front();
-    for (Instant const& right : right_endpoints_times) {
-      ++left_it;
-      auto const right_it = timeline_.find(right);
-      left_it = timeline_.erase(left_it, right_it);
-    }
-    number_of_dense_points_ = std::distance(left_it, timeline_.cend());
-    was_downsampled_ = true;
+template<typename Frame>
+absl::Status DiscreteTrajectorySegment<Frame>::AwaitDownsampling() {
+  if (!pending_downsampling_.has_value()) {
+    return absl::OkStatus();
+  }
+  auto const right_endpoints = pending_downsampling_->right_endpoints.get();
+  Instant const first_time = pending_downsampling_->first_time;
+  std::int64_t const number_of_points =
+      pending_downsampling_->number_of_points;
+  pending_downsampling_.reset();
+  if (!right_endpoints.ok()) {
+    // The points remain dense and will be fitted again.
+    return right_endpoints.status();
   }
+  ApplyDownsampling(first_time, number_of_points, *right_endpoints);
   return absl::OkStatus();
 }
 
+template<typename Frame>
+absl::StatusOr<std::vector<std::int64_t>>
+DiscreteTrajectorySegment<Frame>::FitDensePoints(
+    std::vector<value_type> const& dense_points,
+    Length const& tolerance) {
+  absl::StatusOr<std::list<typename std::vector<value_type>::const_iterator>>
+      right_endpoints = FitHermiteSpline<Instant, Position<Frame>>(
+          dense_points,
+          [](auto&& point) -> auto&& { return point.time; },
+          [](auto&& point) -> auto&& {
+            return point.degrees_of_freedom.position();
+          },
+          [](auto&& point) -> auto&& {
+            return point.degrees_of_freedom.velocity();
+          },
+          tolerance);
+  if (!right_endpoints.ok()) {
+    return right_endpoints.status();
+  }
+
+  std::vector<std::int64_t> indices;
+  indices.reserve(right_endpoints->size() + 1);
+  for (auto const& it : right_endpoints.value()) {
+    indices.push_back(std::distance(dense_points.cbegin(), it));
+  }
+  if (indices.empty()) {
+    indices.push_back(dense_points.size() - 1);
+  }
+  return indices;
+}
+
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::ApplyDownsampling(
+    Instant const& first_time,
+    std::int64_t const number_of_points,
+    std::vector<std::int64_t> const& right_endpoints) {
+  CHECK_LE(number_of_points, number_of_dense_points_);
+  CHECK_LT(right_endpoints.back(), number_of_points);
+  auto left_it = timeline_.find(first_time);
+  CHECK(left_it != timeline_.cend()) << "Cannot find time " << first_time;
+
+  // Poke holes in the timeline between consecutive endpoints, walking forward
+  // from the first dense point.
+  std::int64_t left = 0;
+  for (std::int64_t const right : right_endpoints) {
+    auto const first_erased = std::next(left_it);
+    left_it = timeline_.erase(first_erased,
+                              std::next(first_erased, right - left - 1));
+    left = right;
+  }
+  // The points appended after the fit was started are still dense.
+  number_of_dense_points_ -= right_endpoints.back();
+  was_downsampled_ = true;
+}
+
 template<typename Frame>
 Hermite3<Instant, Position<Frame>>
 DiscreteTrajectorySegment<Frame>::GetInterpolation(
@@ -1,10 +1,14 @@
 #include "physics/discrete_trajectory_segment.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <vector>
 
+#include "absl/synchronization/notification.h"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
@@ -28,6 +32,7 @@ using ::testing::Eq;
 using ::testing::Le;
 using ::testing::Lt;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_space;
@@ -84,6 +89,10 @@ class DiscreteTrajectorySegmentTest : public ::testing::Test {
     segment.ForgetBefore(t);
   }
 
+  absl::Status AwaitDownsampling(DiscreteTrajectorySegment<World>& segment) {
+    return segment.AwaitDownsampling();
+  }
+
   static DiscreteTrajectorySegmentIterator<World> MakeIterator(
       not_null<Segments*> const segments,
       typename Segments::iterator iterator) {
@@ -362,6 +371,92 @@ TEST_F(DiscreteTrajectorySegmentTest, DownsamplingForgetAfter) {
               AlmostEquals(0 * Metre / Second, 0));
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, DownsamplingAsynchronous) {
+  auto const circle_segments = MakeSegments(1);
+  auto const asynchronous_circle_segments = MakeSegments(1);
+  auto& circle = *circle_segments->begin();
+  auto& asynchronous_circle = *asynchronous_circle_segments->begin();
+  circle.SetDownsampling(
+      {.max_dense_intervals = 50, .tolerance = 1 * Milli(Metre)});
+  asynchronous_circle.SetDownsampling({.max_dense_intervals = 50,
+                                       .tolerance = 1 * Milli(Metre),
+                                       .asynchronous = true});
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Time const Δt = 10 * Milli(Second);
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 10 * Second;
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2),
+      /*to=*/circle);
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2),
+      /*to=*/asynchronous_circle);
+
+  // The points removed by the last fit may not have been erased yet.
+  EXPECT_OK(AwaitDownsampling(asynchronous_circle));
+
+  // The fits depend on when the background results are applied, so the points
+  // may differ from those of synchronous downsampling, but the tolerance is
+  // met.
+  EXPECT_THAT(circle.size(), Eq(77));
+  EXPECT_THAT(asynchronous_circle.size(), Lt(1001));
+  EXPECT_TRUE(asynchronous_circle.was_downsampled());
+  std::vector<Length> position_errors;
+  for (auto const& [time, degrees_of_freedom] :
+       NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2)) {
+    position_errors.push_back(
+        (asynchronous_circle.EvaluatePosition(time) -
+         degrees_of_freedom.position()).Norm());
+  }
+  EXPECT_THAT(*std::max_element(position_errors.begin(), position_errors.end()),
+              Le(1 * Milli(Metre)));
+}
+
+TEST_F(DiscreteTrajectorySegmentTest, DownsamplingAsynchronousDoesNotBlock) {
+  auto& thread_pool = _discrete_trajectory_segment::internal::
+      DownsamplingThreadPool();
+  auto const circle_segments = MakeSegments(1);
+  auto& circle = *circle_segments->begin();
+  circle.SetDownsampling({.max_dense_intervals = 50,
+                          .tolerance = 1 * Milli(Metre),
+                          .asynchronous = true});
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Time const Δt = 10 * Milli(Second);
+  auto const timeline =
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t0_, t0_ + 10 * Second);
+
+  // Occupy all the threads of the pool so that the fit cannot complete.
+  absl::Notification release;
+  std::vector<std::future<absl::StatusOr<std::vector<std::int64_t>>>>
+      blockers;
+  for (std::int64_t i = 0; i < HardwareConcurrency(); ++i) {
+    blockers.push_back(thread_pool.Add(
+        [&release]() -> absl::StatusOr<std::vector<std::int64_t>> {
+          release.WaitForNotification();
+          return std::vector<std::int64_t>{};
+        }));
+  }
+
+  // The 51st point starts a fit; the 30 points that follow are appended while
+  // it is pending, without waiting for it.
+  auto it = timeline.begin();
+  for (int i = 0; i < 81; ++i, ++it) {
+    EXPECT_OK(circle.Append(it->time, it->degrees_of_freedom));
+  }
+  EXPECT_THAT(circle.size(), Eq(81));
+  EXPECT_FALSE(circle.was_downsampled());
+
+  release.Notify();
+  for (auto& blocker : blockers) {
+    blocker.wait();
+  }
+  EXPECT_OK(AwaitDownsampling(circle));
+  EXPECT_THAT(circle.size(), Lt(81));
+  EXPECT_TRUE(circle.was_downsampled());
+}
+
 TEST_F(DiscreteTrajectorySegmentTest, SerializationWithDownsampling) {
   auto const circle_segments = MakeSegments(1);
   auto& circle = *circle_segments->begin();
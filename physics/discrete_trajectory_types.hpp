@@ -27,10 +27,13 @@ using namespace principia::quantities::_quantities;
 
 // |max_dense_intervals| is the maximal number of dense intervals before
 // downsampling occurs.  |tolerance| is the tolerance for downsampling with
-// |FitHermiteSpline|.
+// |FitHermiteSpline|.  If |asynchronous| is true, the fit runs on a background
+// thread and the points that it removes are erased by a subsequent |Append|;
+// this flag is not serialized.
 struct DownsamplingParameters {
   std::int64_t max_dense_intervals;
   Length tolerance;
+  bool asynchronous = false;
 };
 
 template<typename Frame>
@@ -151,6 +151,11 @@ class Ephemeris {
   // the |t_min()| of the ephemeris is at or before |desired_t_min|.
   void AwaitReanimation(Instant const& desired_t_min);
 
+  // Moves the polynomials of the trajectories that end at or before |t| to
+  // their cold tier, where they use less memory but are slower to evaluate.
+  // See |ContinuousTrajectory::CompressBefore|.
+  virtual void CompressTrajectoriesBefore(Instant const& t) EXCLUDES(lock_);
+
   // Creates an instance suitable for integrating the given |trajectories| with
   // their |intrinsic_accelerations| using a fixed-step integrator parameterized
   // by |parameters|.
@@ -389,6 +394,18 @@ class Ephemeris {
       std::vector<Vector<Acceleration, Frame>>& accelerations) const
       REQUIRES_SHARED(lock_);
 
+  // Computes the accelerations due to all the spherical bodies on massless
+  // bodies at the given |positions| using the vectorized kernel
+  // |AccumulateSphericalBodyAccelerations|.  The results are bitwise identical
+  // to those of |ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies|
+  // applied to each spherical body in turn.  Returns an integer for efficiency.
+  std::underlying_type_t<absl::StatusCode>
+  ComputeGravitationalAccelerationBySphericalBodiesOnMasslessBodies(
+      Instant const& t,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const
+      REQUIRES_SHARED(lock_);
+
   // Computes the potential resulting from one body, |body1| (with index |b1| in
   // the |bodies_| and |trajectories_| arrays) at the given |positions|.  The
   // template parameter specifies what we know about the massive body, and
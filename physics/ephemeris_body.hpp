@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <limits>
 #include <optional>
 #include <utility>
@@ -16,6 +17,7 @@
 #include "base/macros.hpp"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/symmetric_bilinear_form.hpp"
@@ -23,6 +25,7 @@
 #include "integrators/ordinary_differential_equations.hpp"
 #include "numerics/hermite3.hpp"
 #include "physics/continuous_trajectory.hpp"
+#include "physics/gravity_kernel.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
@@ -40,6 +43,7 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::base::_jthread;
 using namespace principia::base::_map_util;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
@@ -53,6 +57,7 @@ using namespace principia::integrators::_ordinary_differential_equations;
 using namespace principia::numerics::_double_precision;
 using namespace principia::numerics::_hermite3;
 using namespace principia::numerics::_root_finders;
+using namespace principia::physics::_gravity_kernel;
 using namespace principia::physics::_oblate_body;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
@@ -67,11 +72,22 @@ constexpr Time max_time_between_checkpoints = 180 * Day;
 // Below this threshold detect a collision to prevent the integrator and the
 // downsampling from going postal.
 constexpr double min_radius_tolerance = 0.99;
+// Below this number of massless bodies, the accelerations due to the spherical
+// bodies are not computed by the vectorized kernel.
+constexpr std::size_t min_massless_bodies_for_gravity_kernel = 8;
 
 inline absl::Status CollisionDetected() {
   return absl::OutOfRangeError("Collision detected");
 }
 
+// The pool on which the trajectories of the massive bodies compute their
+// Newhall approximations.  Shared by all the ephemerides.
+inline ThreadPool<absl::Status>& FittingThreadPool() {
+  static auto* const thread_pool = new ThreadPool<absl::Status>(
+      /*pool_size=*/HardwareConcurrency());
+  return *thread_pool;
+}
+
 template<typename Frame>
 Ephemeris<Frame>::AccuracyParameters::AccuracyParameters(
     Length const& fitting_tolerance,
@@ -270,6 +286,16 @@ void Ephemeris<Frame>::AwaitReanimation(Instant const& desired_t_min) {
   lock_.Await(absl::Condition(&desired_t_min_reached));
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::CompressTrajectoriesBefore(Instant const& t) {
+  // Each trajectory locks itself to exclude its own evaluations while it
+  // compresses.  The |trajectories_| don't change after construction, so there
+  // is no need to lock the ephemeris, which would block the integrations.
+  for (auto const& trajectory : trajectories_) {
+    trajectory->CompressBefore(t);
+  }
+}
+
 template<typename Frame>
 absl::Status Ephemeris<Frame>::Prolong(Instant const& t) {
   // Short-circuit without locking.
@@ -1093,16 +1119,34 @@ std::vector<absl::Status>
 Ephemeris<Frame>::AppendMassiveBodiesStateToTrajectories(
     typename NewtonianMotionEquation::State const& state,
     std::vector<not_null<ContinuousTrajectoryPtr>> const& trajectories) {
-  std::vector<absl::Status> statuses;
-  statuses.reserve(trajectories.size());
   Instant const time = state.time.value;
-  int index = 0;
-  for (auto& trajectory : trajectories) {
-    statuses.push_back(trajectory->Append(
+  auto const append = [&state, &time, &trajectories](int const index) {
+    return trajectories[index]->Append(
         time,
         DegreesOfFreedom<Frame>(state.positions[index].value,
-                                state.velocities[index].value)));
-    ++index;
+                                state.velocities[index].value));
+  };
+
+  std::vector<absl::Status> statuses;
+  statuses.reserve(trajectories.size());
+  // The trajectories are appended to in lockstep, so they all compute their
+  // Newhall approximations at the same step.  Because they are disjoint, the
+  // fits may proceed concurrently.  The other steps just record a point and
+  // are not worth dispatching.
+  if (trajectories.size() > 1 && trajectories.front()->next_append_fits()) {
+    std::vector<std::future<absl::Status>> fits;
+    fits.reserve(trajectories.size());
+    for (int index = 0; index < trajectories.size(); ++index) {
+      fits.push_back(FittingThreadPool().Add(
+          [&append, index]() { return append(index); }));
+    }
+    for (auto& fit : fits) {
+      statuses.push_back(fit.get());
+    }
+  } else {
+    for (int index = 0; index < trajectories.size(); ++index) {
+      statuses.push_back(append(index));
+    }
   }
   return statuses;
 }
@@ -1361,6 +1405,76 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
   return error;
 }
 
+template<typename Frame>
+std::underlying_type_t<absl::StatusCode>
+Ephemeris<Frame>::
+ComputeGravitationalAccelerationBySphericalBodiesOnMasslessBodies(
+    Instant const& t,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  lock_.AssertReaderHeld();
+  // TODO(phl): Use std::to_underlying when we have C++23.
+  auto error = static_cast<std::underlying_type_t<absl::StatusCode>>(
+      absl::StatusCode::kOk);
+
+  // The kernel works on structures of arrays in SI units.  The buffers are
+  // reused across calls to avoid allocations.
+  thread_local std::vector<double> qx;
+  thread_local std::vector<double> qy;
+  thread_local std::vector<double> qz;
+  thread_local std::vector<double> ax;
+  thread_local std::vector<double> ay;
+  thread_local std::vector<double> az;
+  std::size_t const n = positions.size();
+  qx.resize(n);
+  qy.resize(n);
+  qz.resize(n);
+  ax.resize(n);
+  ay.resize(n);
+  az.resize(n);
+  for (std::size_t b2 = 0; b2 < n; ++b2) {
+    auto const q = (positions[b2] - Frame::origin).coordinates();
+    qx[b2] = q.x / si::Unit<Length>;
+    qy[b2] = q.y / si::Unit<Length>;
+    qz[b2] = q.z / si::Unit<Length>;
+    auto const a = accelerations[b2].coordinates();
+    ax[b2] = a.x / si::Unit<Acceleration>;
+    ay[b2] = a.y / si::Unit<Acceleration>;
+    az[b2] = a.z / si::Unit<Acceleration>;
+  }
+
+  for (std::size_t b1 = number_of_oblate_bodies_;
+       b1 < number_of_oblate_bodies_ +
+            number_of_spherical_bodies_;
+       ++b1) {
+    MassiveBody const& body1 = *bodies_[b1];
+    auto const q1 = (trajectories_[b1]->EvaluatePositionLocked(t) -
+                     Frame::origin).coordinates();
+    bool const collision = AccumulateSphericalBodyAccelerations(
+        body1.gravitational_parameter() / si::Unit<GravitationalParameter>,
+        q1.x / si::Unit<Length>,
+        q1.y / si::Unit<Length>,
+        q1.z / si::Unit<Length>,
+        min_radius_tolerance * body1.min_radius() / si::Unit<Length>,
+        n,
+        qx.data(), qy.data(), qz.data(),
+        ax.data(), ay.data(), az.data());
+    error |= collision
+                 ? static_cast<std::underlying_type_t<absl::StatusCode>>(
+                       absl::StatusCode::kOutOfRange)
+                 : static_cast<std::underlying_type_t<absl::StatusCode>>(
+                       absl::StatusCode::kOk);
+  }
+
+  for (std::size_t b2 = 0; b2 < n; ++b2) {
+    accelerations[b2] = Vector<Acceleration, Frame>(
+        {ax[b2] * si::Unit<Acceleration>,
+         ay[b2] * si::Unit<Acceleration>,
+         az[b2] * si::Unit<Acceleration>});
+  }
+  return error;
+}
+
 template<typename Frame>
 template<bool body1_is_oblate>
 void Ephemeris<Frame>::ComputeGravitationalPotentialsOfMassiveBody(
@@ -1474,17 +1588,24 @@ ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
                  positions,
                  accelerations);
   }
-  for (std::size_t b1 = number_of_oblate_bodies_;
-       b1 < number_of_oblate_bodies_ +
-            number_of_spherical_bodies_;
-       ++b1) {
-    MassiveBody const& body1 = *bodies_[b1];
-    error |= ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
-                 /*body1_is_oblate=*/false>(
-                 t,
-                 body1, b1,
-                 positions,
-                 accelerations);
+  // With few massless bodies the vectors are mostly empty and marshalling the
+  // data costs more than it saves.
+  if (positions.size() >= min_massless_bodies_for_gravity_kernel) {
+    error |= ComputeGravitationalAccelerationBySphericalBodiesOnMasslessBodies(
+        t, positions, accelerations);
+  } else {
+    for (std::size_t b1 = number_of_oblate_bodies_;
+         b1 < number_of_oblate_bodies_ +
+              number_of_spherical_bodies_;
+         ++b1) {
+      MassiveBody const& body1 = *bodies_[b1];
+      error |= ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
+                   /*body1_is_oblate=*/false>(
+                   t,
+                   body1, b1,
+                   positions,
+                   accelerations);
+    }
   }
   return static_cast<absl::StatusCode>(error);
 }
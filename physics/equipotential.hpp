@@ -4,7 +4,9 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "base/jthread.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/plane.hpp"
@@ -22,7 +24,9 @@ namespace physics {
 namespace _equipotential {
 namespace internal {
 
+using namespace principia::base::_jthread;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_plane;
@@ -84,7 +88,8 @@ class Equipotential {
   // from a well if it encloses the peak but not the well, or vice-versa.  Given
   // a position, |towards_infinity| should return a position far away where the
   // potential is lower, in a direction where not much happens, e.g., away from
-  // the centre in a rotating frame.
+  // the centre in a rotating frame.  If the calling thread is stopped, returns
+  // early with an incomplete set of lines.
   Lines ComputeLines(
       Plane<Frame> const& plane,
       Instant const& t,
@@ -93,6 +98,20 @@ class Equipotential {
       std::function<Position<Frame>(Position<Frame>)> towards_infinity,
       SpecificEnergy const& energy) const;
 
+  // Same as above for each of the |energies|; the result has one element per
+  // energy.  The lines for a given energy depend on each other through the
+  // delineations, but the energies are independent, so they are processed
+  // concurrently if a |thread_pool| is given.  If the calling thread is
+  // stopped, returns early with incomplete sets of lines.
+  std::vector<Lines> ComputeLines(
+      Plane<Frame> const& plane,
+      Instant const& t,
+      std::vector<Position<Frame>> const& peaks,
+      std::vector<Well> const& wells,
+      std::function<Position<Frame>(Position<Frame>)> towards_infinity,
+      std::vector<SpecificEnergy> const& energies,
+      ThreadPool<void>* thread_pool = nullptr) const;
+
  private:
   using IndependentVariableDifference =
       typename ODE::IndependentVariableDifference;
@@ -110,6 +129,17 @@ class Equipotential {
   static constexpr Quotient<Time, IndependentVariable>
       reinterpret_independent_variable_as_time = 1 * Second;
 
+  // Same as |ComputeLines| for a single energy, but checks the given |token|,
+  // which makes it possible to interrupt computations running on a thread pool.
+  Lines ComputeLinesUnlessStopped(
+      Plane<Frame> const& plane,
+      Instant const& t,
+      std::vector<Position<Frame>> const& peaks,
+      std::vector<Well> const& wells,
+      std::function<Position<Frame>(Position<Frame>)> const& towards_infinity,
+      SpecificEnergy const& energy,
+      stop_token const& token) const;
+
   // The |binormal| determines in what direction we go around the curve.  It may
   // be anything, but must be consistent across calls to the right-hand side.
   absl::Status RightHandSide(Bivector<double, Frame> const& binormal,
@@ -3,6 +3,7 @@
 #include "physics/equipotential.hpp"
 
 #include <functional>
+#include <future>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -24,6 +25,8 @@ namespace internal {
 using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
+using namespace principia::base::_jthread;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
@@ -107,6 +110,74 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
     std::vector<Well> const& wells,
     std::function<Position<Frame>(Position<Frame>)> towards_infinity,
     SpecificEnergy const& energy) const -> Lines {
+  return ComputeLinesUnlessStopped(plane,
+                                   t,
+                                   peaks,
+                                   wells,
+                                   towards_infinity,
+                                   energy,
+                                   this_stoppable_thread::get_stop_token());
+}
+
+template<typename InertialFrame, typename Frame>
+auto Equipotential<InertialFrame, Frame>::ComputeLines(
+    Plane<Frame> const& plane,
+    Instant const& t,
+    std::vector<Position<Frame>> const& peaks,
+    std::vector<Well> const& wells,
+    std::function<Position<Frame>(Position<Frame>)> towards_infinity,
+    std::vector<SpecificEnergy> const& energies,
+    ThreadPool<void>* const thread_pool) const -> std::vector<Lines> {
+  // The stop token of the calling thread, to be checked by the computations
+  // running on the |thread_pool|.
+  stop_token const token = this_stoppable_thread::get_stop_token();
+
+  std::vector<Lines> all_lines(energies.size());
+  if (thread_pool == nullptr) {
+    for (std::int64_t i = 0; i < energies.size(); ++i) {
+      if (token.stop_requested()) {
+        break;
+      }
+      all_lines[i] = ComputeLinesUnlessStopped(
+          plane, t, peaks, wells, towards_infinity, energies[i], token);
+    }
+  } else {
+    std::vector<std::future<void>> futures;
+    futures.reserve(energies.size());
+    for (std::int64_t i = 0; i < energies.size(); ++i) {
+      futures.push_back(thread_pool->Add([this,
+                                          &all_lines,
+                                          &energies,
+                                          &peaks,
+                                          &plane,
+                                          &t,
+                                          &token,
+                                          &towards_infinity,
+                                          &wells,
+                                          i]() {
+        if (token.stop_requested()) {
+          return;
+        }
+        all_lines[i] = ComputeLinesUnlessStopped(
+            plane, t, peaks, wells, towards_infinity, energies[i], token);
+      }));
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+  }
+  return all_lines;
+}
+
+template<typename InertialFrame, typename Frame>
+auto Equipotential<InertialFrame, Frame>::ComputeLinesUnlessStopped(
+    Plane<Frame> const& plane,
+    Instant const& t,
+    std::vector<Position<Frame>> const& peaks,
+    std::vector<Well> const& wells,
+    std::function<Position<Frame>(Position<Frame>)> const& towards_infinity,
+    SpecificEnergy const& energy,
+    stop_token const& token) const -> Lines {
   using WellIterator = typename std::vector<Well>::const_iterator;
 
   // A |PeakDelineation| represents:
@@ -126,6 +197,10 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
     }
   }
 
+  // Scratch storage reused across lines to avoid repeated allocations.
+  std::vector<Position<Frame>> positions;
+  std::set<WellIterator> enclosed_wells;
+
   Lines lines;
   for (int i = 0; i < peaks.size(); ++i) {
     auto const& delineation = peak_delineations[i];
@@ -138,6 +213,9 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
 
     while (!delineation.indistinct_wells.empty() ||
            !delineation.delineated_from_infinity) {
+      if (token.stop_requested()) {
+        return lines;
+      }
       std::optional<WellIterator> expected_delineated_well;
       bool expect_delineation_from_infinity = false;
       if (!delineation.indistinct_wells.empty()) {
@@ -204,13 +282,14 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
             Barycentre(std::pair(peak, far_away), std::pair(x, 1 - x));
         lines.push_back(ComputeLine(plane, t, equipotential_position));
       }
-      std::vector<Position<Frame>> positions;
+      positions.clear();
+      positions.reserve(lines.back().size());
       for (auto const& [s, dof] : lines.back()) {
         positions.push_back(dof.position());
       }
 
       // Figure out whether the equipotential introduces new delineations.
-      std::set<WellIterator> enclosed_wells;
+      enclosed_wells.clear();
       for (auto it = wells.begin(); it != wells.end(); ++it) {
         std::int64_t const winding_number =
             WindingNumber(plane, it->position, positions);
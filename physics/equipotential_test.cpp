@@ -8,6 +8,7 @@
 
 #include "absl/strings/str_cat.h"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
@@ -38,6 +39,7 @@ namespace principia {
 namespace physics {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
@@ -537,6 +539,72 @@ TEST_F(EquipotentialTest, RotatingPulsating_GlobalOptimization) {
              ExpressIn(Metre));
 }
 
+TEST_F(EquipotentialTest, RotatingPulsating_Parallel) {
+  auto const earth = solar_system_->massive_body(
+      *ephemeris_, SolarSystemFactory::name(SolarSystemFactory::Earth));
+  auto const moon = solar_system_->massive_body(
+      *ephemeris_, SolarSystemFactory::name(SolarSystemFactory::Moon));
+  auto const reference_frame(
+      RotatingPulsatingReferenceFrame<Barycentric, World>(
+          ephemeris_.get(), moon, earth));
+  Instant const t = t0_ + 1 * Day;
+  CHECK_OK(ephemeris_->Prolong(t));
+
+  constexpr Length characteristic_length = 1 * Nano(Metre);
+  Equipotential<Barycentric, World> const equipotential(
+      {EmbeddedExplicitRungeKuttaIntegrator<
+           DormandPrince1986RK547FC,
+           Equipotential<Barycentric, World>::ODE>(),
+       /*max_steps=*/1000,
+       /*length_integration_tolerance=*/characteristic_length},
+      &reference_frame,
+      characteristic_length);
+  auto const plane =
+      Plane<World>::OrthogonalTo(Vector<double, World>({0, 0, 1}));
+
+  auto const& [l4, l5] = ComputeLagrangePoints(SolarSystemFactory::Earth,
+                                                SolarSystemFactory::Moon,
+                                                t,
+                                                reference_frame,
+                                                plane);
+  Position<World> const earth_position =
+      ComputePositionInWorld(t, reference_frame, SolarSystemFactory::Earth);
+  Position<World> const moon_position =
+      ComputePositionInWorld(t, reference_frame, SolarSystemFactory::Moon);
+  Length const r = (ephemeris_->trajectory(moon)->EvaluatePosition(t) -
+                    ephemeris_->trajectory(earth)->EvaluatePosition(t))
+                       .Norm();
+  std::vector<Equipotential<Barycentric, World>::Well> const wells{
+      {moon_position, moon->min_radius() / r * (1 * Metre)},
+      {earth_position, earth->min_radius() / r * (1 * Metre)}};
+  auto const towards_infinity = [](Position<World> q) {
+    return World::origin + Normalize(q - World::origin) * 3 * Metre;
+  };
+
+  // Energies between L₄ and the Moon.
+  std::vector<SpecificEnergy> energies;
+  for (double const x : {0.2, 0.4, 0.6}) {
+    energies.push_back(reference_frame.GeometricPotential(
+        t, Barycentre(std::pair(moon_position, l4), std::pair(x, 1 - x))));
+  }
+
+  ThreadPool<void> thread_pool(/*pool_size=*/4);
+  auto const parallel_lines = equipotential.ComputeLines(
+      plane, t, {l4, l5}, wells, towards_infinity, energies, &thread_pool);
+  ASSERT_EQ(energies.size(), parallel_lines.size());
+  for (int i = 0; i < energies.size(); ++i) {
+    auto const serial_lines = equipotential.ComputeLines(
+        plane, t, {l4, l5}, wells, towards_infinity, energies[i]);
+    EXPECT_FALSE(serial_lines.empty());
+    ASSERT_EQ(serial_lines.size(), parallel_lines[i].size());
+    for (int j = 0; j < serial_lines.size(); ++j) {
+      EXPECT_EQ(serial_lines[j].size(), parallel_lines[i][j].size());
+      EXPECT_EQ(serial_lines[j].back().degrees_of_freedom,
+                parallel_lines[i][j].back().degrees_of_freedom);
+    }
+  }
+}
+
 #endif
 
 }  // namespace physics
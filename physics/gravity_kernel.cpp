@@ -0,0 +1,211 @@
+#include "physics/gravity_kernel.hpp"
+
+#include <immintrin.h>
+
+#include "base/macros.hpp"
+
+// The multiplications and additions must not be contracted, otherwise the
+// implementations would not give the same results.
+#if PRINCIPIA_COMPILER_CLANG || PRINCIPIA_COMPILER_CLANG_CL
+#pragma clang fp contract(off)
+#elif PRINCIPIA_COMPILER_MSVC
+#pragma fp_contract(off)
+#elif PRINCIPIA_COMPILER_GCC
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace principia {
+namespace physics {
+namespace _gravity_kernel {
+namespace internal {
+
+namespace {
+
+// Processes the massless body with index |i|.  Returns true if it collides with
+// the spherical body.  This is used by all the implementations for the bodies
+// that don't fill a vector.
+FORCE_INLINE(inline) bool AccumulateOne(__m128d const μ,
+                                        __m128d const q1x,
+                                        __m128d const q1y,
+                                        __m128d const q1z,
+                                        double const collision_radius,
+                                        std::int64_t const i,
+                                        double const* const qx,
+                                        double const* const qy,
+                                        double const* const qz,
+                                        double* const ax,
+                                        double* const ay,
+                                        double* const az) {
+  __m128d const Δqx = _mm_sub_sd(q1x, _mm_load_sd(qx + i));
+  __m128d const Δqy = _mm_sub_sd(q1y, _mm_load_sd(qy + i));
+  __m128d const Δqz = _mm_sub_sd(q1z, _mm_load_sd(qz + i));
+  __m128d const Δq² = _mm_add_sd(
+      _mm_add_sd(_mm_mul_sd(Δqx, Δqx), _mm_mul_sd(Δqy, Δqy)),
+      _mm_mul_sd(Δqz, Δqz));
+  __m128d const Δq_norm = _mm_sqrt_sd(Δq², Δq²);
+  __m128d const one_over_Δq³ = _mm_div_sd(Δq_norm, _mm_mul_sd(Δq², Δq²));
+  __m128d const μ_over_Δq³ = _mm_mul_sd(μ, one_over_Δq³);
+  _mm_store_sd(ax + i,
+               _mm_add_sd(_mm_load_sd(ax + i), _mm_mul_sd(Δqx, μ_over_Δq³)));
+  _mm_store_sd(ay + i,
+               _mm_add_sd(_mm_load_sd(ay + i), _mm_mul_sd(Δqy, μ_over_Δq³)));
+  _mm_store_sd(az + i,
+               _mm_add_sd(_mm_load_sd(az + i), _mm_mul_sd(Δqz, μ_over_Δq³)));
+  // Written so that a NaN distance is a collision.
+  return !(_mm_cvtsd_f64(Δq_norm) > collision_radius);
+}
+
+bool AccumulateGeneric(double const μ,
+                       double const q1x,
+                       double const q1y,
+                       double const q1z,
+                       double const collision_radius,
+                       std::int64_t const n,
+                       double const* const qx,
+                       double const* const qy,
+                       double const* const qz,
+                       double* const ax,
+                       double* const ay,
+                       double* const az) {
+  __m128d const μ_128d = _mm_set_sd(μ);
+  __m128d const q1x_128d = _mm_set_sd(q1x);
+  __m128d const q1y_128d = _mm_set_sd(q1y);
+  __m128d const q1z_128d = _mm_set_sd(q1z);
+  bool collision = false;
+  for (std::int64_t i = 0; i < n; ++i) {
+    collision |= AccumulateOne(μ_128d, q1x_128d, q1y_128d, q1z_128d,
+                               collision_radius,
+                               i, qx, qy, qz, ax, ay, az);
+  }
+  return collision;
+}
+
+PRINCIPIA_TARGET_AVX2
+bool AccumulateAVX2(double const μ,
+                    double const q1x,
+                    double const q1y,
+                    double const q1z,
+                    double const collision_radius,
+                    std::int64_t const n,
+                    double const* const qx,
+                    double const* const qy,
+                    double const* const qz,
+                    double* const ax,
+                    double* const ay,
+                    double* const az) {
+  __m256d const μ_256d = _mm256_set1_pd(μ);
+  __m256d const q1x_256d = _mm256_set1_pd(q1x);
+  __m256d const q1y_256d = _mm256_set1_pd(q1y);
+  __m256d const q1z_256d = _mm256_set1_pd(q1z);
+  __m256d const collision_radius_256d = _mm256_set1_pd(collision_radius);
+  __m256d collisions = _mm256_setzero_pd();
+  std::int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d const Δqx = _mm256_sub_pd(q1x_256d, _mm256_loadu_pd(qx + i));
+    __m256d const Δqy = _mm256_sub_pd(q1y_256d, _mm256_loadu_pd(qy + i));
+    __m256d const Δqz = _mm256_sub_pd(q1z_256d, _mm256_loadu_pd(qz + i));
+    __m256d const Δq² = _mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(Δqx, Δqx), _mm256_mul_pd(Δqy, Δqy)),
+        _mm256_mul_pd(Δqz, Δqz));
+    __m256d const Δq_norm = _mm256_sqrt_pd(Δq²);
+    collisions = _mm256_or_pd(
+        collisions,
+        _mm256_cmp_pd(Δq_norm, collision_radius_256d, _CMP_NGT_UQ));
+    __m256d const one_over_Δq³ =
+        _mm256_div_pd(Δq_norm, _mm256_mul_pd(Δq², Δq²));
+    __m256d const μ_over_Δq³ = _mm256_mul_pd(μ_256d, one_over_Δq³);
+    _mm256_storeu_pd(ax + i,
+                     _mm256_add_pd(_mm256_loadu_pd(ax + i),
+                                   _mm256_mul_pd(Δqx, μ_over_Δq³)));
+    _mm256_storeu_pd(ay + i,
+                     _mm256_add_pd(_mm256_loadu_pd(ay + i),
+                                   _mm256_mul_pd(Δqy, μ_over_Δq³)));
+    _mm256_storeu_pd(az + i,
+                     _mm256_add_pd(_mm256_loadu_pd(az + i),
+                                   _mm256_mul_pd(Δqz, μ_over_Δq³)));
+  }
+  bool collision = _mm256_movemask_pd(collisions) != 0;
+  __m128d const μ_128d = _mm_set_sd(μ);
+  __m128d const q1x_128d = _mm_set_sd(q1x);
+  __m128d const q1y_128d = _mm_set_sd(q1y);
+  __m128d const q1z_128d = _mm_set_sd(q1z);
+  for (; i < n; ++i) {
+    collision |= AccumulateOne(μ_128d, q1x_128d, q1y_128d, q1z_128d,
+                               collision_radius,
+                               i, qx, qy, qz, ax, ay, az);
+  }
+  return collision;
+}
+
+PRINCIPIA_TARGET_AVX512
+bool AccumulateAVX512(double const μ,
+                      double const q1x,
+                      double const q1y,
+                      double const q1z,
+                      double const collision_radius,
+                      std::int64_t const n,
+                      double const* const qx,
+                      double const* const qy,
+                      double const* const qz,
+                      double* const ax,
+                      double* const ay,
+                      double* const az) {
+  __m512d const μ_512d = _mm512_set1_pd(μ);
+  __m512d const q1x_512d = _mm512_set1_pd(q1x);
+  __m512d const q1y_512d = _mm512_set1_pd(q1y);
+  __m512d const q1z_512d = _mm512_set1_pd(q1z);
+  __m512d const collision_radius_512d = _mm512_set1_pd(collision_radius);
+  __mmask8 collisions = 0;
+  // The last iteration is masked to process the bodies that don't fill a
+  // vector.  The masked lanes are computed on zeros and not stored.
+  for (std::int64_t i = 0; i < n; i += 8) {
+    __mmask8 const mask =
+        n - i >= 8 ? static_cast<__mmask8>(0xFF)
+                   : static_cast<__mmask8>((1u << (n - i)) - 1);
+    __m512d const Δqx =
+        _mm512_sub_pd(q1x_512d, _mm512_maskz_loadu_pd(mask, qx + i));
+    __m512d const Δqy =
+        _mm512_sub_pd(q1y_512d, _mm512_maskz_loadu_pd(mask, qy + i));
+    __m512d const Δqz =
+        _mm512_sub_pd(q1z_512d, _mm512_maskz_loadu_pd(mask, qz + i));
+    __m512d const Δq² = _mm512_add_pd(
+        _mm512_add_pd(_mm512_mul_pd(Δqx, Δqx), _mm512_mul_pd(Δqy, Δqy)),
+        _mm512_mul_pd(Δqz, Δqz));
+    __m512d const Δq_norm = _mm512_sqrt_pd(Δq²);
+    collisions |= _mm512_mask_cmp_pd_mask(
+        mask, Δq_norm, collision_radius_512d, _CMP_NGT_UQ);
+    __m512d const one_over_Δq³ =
+        _mm512_div_pd(Δq_norm, _mm512_mul_pd(Δq², Δq²));
+    __m512d const μ_over_Δq³ = _mm512_mul_pd(μ_512d, one_over_Δq³);
+    _mm512_mask_storeu_pd(ax + i,
+                          mask,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, ax + i),
+                                        _mm512_mul_pd(Δqx, μ_over_Δq³)));
+    _mm512_mask_storeu_pd(ay + i,
+                          mask,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, ay + i),
+                                        _mm512_mul_pd(Δqy, μ_over_Δq³)));
+    _mm512_mask_storeu_pd(az + i,
+                          mask,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, az + i),
+                                        _mm512_mul_pd(Δqz, μ_over_Δq³)));
+  }
+  return collisions != 0;
+}
+
+}  // namespace
+
+CPUDispatch<bool(double μ,
+                 double q1x, double q1y, double q1z,
+                 double collision_radius,
+                 std::int64_t n,
+                 double const* qx, double const* qy, double const* qz,
+                 double* ax, double* ay, double* az)> const
+    AccumulateSphericalBodyAccelerations(&AccumulateGeneric,
+                                         &AccumulateAVX2,
+                                         &AccumulateAVX512);
+
+}  // namespace internal
+}  // namespace _gravity_kernel
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+#include "base/cpu_dispatch.hpp"
+
+namespace principia {
+namespace physics {
+namespace _gravity_kernel {
+namespace internal {
+
+using namespace principia::base::_cpu_dispatch;
+
+// Adds to (ax[i], ay[i], az[i]) the acceleration exerted by a spherical body of
+// gravitational parameter |μ| located at (q1x, q1y, q1z) on a massless body
+// located at (qx[i], qy[i], qz[i]), for i in [0, n[.  All the quantities are
+// in SI units.  Returns true if any of the massless bodies is at a distance
+// less than or equal to |collision_radius| from the spherical body, or at a
+// NaN distance.
+// The computation is the same as that of the |Ephemeris| for spherical bodies,
+// and all the implementations perform the same operations in the same order
+// without FMA, so the results are bitwise identical irrespective of the
+// instruction set.  The arrays must not overlap.
+extern CPUDispatch<bool(double μ,
+                        double q1x, double q1y, double q1z,
+                        double collision_radius,
+                        std::int64_t n,
+                        double const* qx, double const* qy, double const* qz,
+                        double* ax, double* ay, double* az)> const
+    AccumulateSphericalBodyAccelerations;
+
+}  // namespace internal
+
+using internal::AccumulateSphericalBodyAccelerations;
+
+}  // namespace _gravity_kernel
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,157 @@
+#include "physics/gravity_kernel.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "base/cpu_dispatch.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace physics {
+
+using ::testing::ElementsAreArray;
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::physics::_gravity_kernel;
+
+class GravityKernelTest : public ::testing::Test {
+ protected:
+  struct Accelerations {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+  };
+
+  GravityKernelTest() {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(-1e9, 1e9);
+    for (int i = 0; i < max_n; ++i) {
+      qx_.push_back(distribution(random));
+      qy_.push_back(distribution(random));
+      qz_.push_back(distribution(random));
+    }
+  }
+
+  // The computation done by the |Ephemeris| for a spherical body.
+  bool Reference(std::int64_t const n, Accelerations& accelerations) const {
+    bool collision = false;
+    for (std::int64_t i = 0; i < n; ++i) {
+      double const Δqx = q1x_ - qx_[i];
+      double const Δqy = q1y_ - qy_[i];
+      double const Δqz = q1z_ - qz_[i];
+      double const Δq² = Δqx * Δqx + Δqy * Δqy + Δqz * Δqz;
+      double const Δq_norm = std::sqrt(Δq²);
+      collision |= !(Δq_norm > collision_radius_);
+      double const one_over_Δq³ = Δq_norm / (Δq² * Δq²);
+      double const μ_over_Δq³ = μ_ * one_over_Δq³;
+      accelerations.x[i] += Δqx * μ_over_Δq³;
+      accelerations.y[i] += Δqy * μ_over_Δq³;
+      accelerations.z[i] += Δqz * μ_over_Δq³;
+    }
+    return collision;
+  }
+
+  bool Accumulate(InstructionSet const instruction_set,
+                  std::int64_t const n,
+                  Accelerations& accelerations) const {
+    return AccumulateSphericalBodyAccelerations.implementation(
+        instruction_set)(μ_,
+                         q1x_, q1y_, q1z_,
+                         collision_radius_,
+                         n,
+                         qx_.data(), qy_.data(), qz_.data(),
+                         accelerations.x.data(),
+                         accelerations.y.data(),
+                         accelerations.z.data());
+  }
+
+  static Accelerations InitialAccelerations() {
+    Accelerations accelerations;
+    for (int i = 0; i < max_n; ++i) {
+      accelerations.x.push_back(i);
+      accelerations.y.push_back(-i);
+      accelerations.z.push_back(0.5 * i);
+    }
+    return accelerations;
+  }
+
+  static constexpr int max_n = 21;
+  double const μ_ = 3.986004418e14;
+  double const q1x_ = 1e8;
+  double const q1y_ = -2e8;
+  double const q1z_ = 3e7;
+  double const collision_radius_ = 6.4e6;
+  std::vector<double> qx_;
+  std::vector<double> qy_;
+  std::vector<double> qz_;
+};
+
+TEST_F(GravityKernelTest, BitwiseIdentical) {
+  for (int i = 0;
+       i <= static_cast<int>(SupportedInstructionSet());
+       ++i) {
+    auto const instruction_set = static_cast<InstructionSet>(i);
+    // Exercise all the remainders of the vector lengths.
+    for (std::int64_t n = 0; n <= max_n; ++n) {
+      Accelerations expected = InitialAccelerations();
+      Accelerations actual = InitialAccelerations();
+      EXPECT_FALSE(Reference(n, expected));
+      EXPECT_FALSE(Accumulate(instruction_set, n, actual))
+          << instruction_set << " " << n;
+      EXPECT_THAT(actual.x, ElementsAreArray(expected.x))
+          << instruction_set << " " << n;
+      EXPECT_THAT(actual.y, ElementsAreArray(expected.y))
+          << instruction_set << " " << n;
+      EXPECT_THAT(actual.z, ElementsAreArray(expected.z))
+          << instruction_set << " " << n;
+    }
+  }
+}
+
+TEST_F(GravityKernelTest, Collisions) {
+  for (int i = 0;
+       i <= static_cast<int>(SupportedInstructionSet());
+       ++i) {
+    auto const instruction_set = static_cast<InstructionSet>(i);
+    // A collision in the vector part, and one in the remainder.
+    for (std::int64_t const colliding : {2, max_n - 1}) {
+      auto const qx = qx_;
+      auto const qy = qy_;
+      auto const qz = qz_;
+      qx_[colliding] = q1x_ + collision_radius_ / 2;
+      qy_[colliding] = q1y_;
+      qz_[colliding] = q1z_;
+      Accelerations accelerations = InitialAccelerations();
+      EXPECT_TRUE(Accumulate(instruction_set, max_n, accelerations))
+          << instruction_set << " " << colliding;
+      // A NaN is also a collision.
+      qx_[colliding] = std::numeric_limits<double>::quiet_NaN();
+      EXPECT_TRUE(Accumulate(instruction_set, max_n, accelerations))
+          << instruction_set << " " << colliding;
+      qx_ = qx;
+      qy_ = qy;
+      qz_ = qz;
+    }
+    // Bodies beyond |n| are ignored.
+    auto const qx = qx_;
+    auto const qy = qy_;
+    auto const qz = qz_;
+    qx_[max_n - 1] = q1x_;
+    qy_[max_n - 1] = q1y_;
+    qz_[max_n - 1] = q1z_;
+    Accelerations accelerations = InitialAccelerations();
+    EXPECT_TRUE(Accumulate(instruction_set, max_n, accelerations))
+        << instruction_set;
+    EXPECT_FALSE(Accumulate(instruction_set, max_n - 1, accelerations))
+        << instruction_set;
+    qx_ = qx;
+    qy_ = qy;
+    qz_ = qz;
+  }
+}
+
+}  // namespace physics
+}  // namespace principia
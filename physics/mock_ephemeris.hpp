@@ -44,6 +44,7 @@ class MockEphemeris : public Ephemeris<Frame> {
               (const, override));
 
   MOCK_METHOD(absl::Status, Prolong, (Instant const& t), (override));
+  MOCK_METHOD(void, CompressTrajectoriesBefore, (Instant const& t), (override));
   MOCK_METHOD(
       not_null<std::unique_ptr<
           typename Integrator<NewtonianMotionEquation>::Instance>>,
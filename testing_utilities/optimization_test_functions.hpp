@@ -2,11 +2,21 @@
 
 #include <array>
 
+#include "geometry/grassmann.hpp"
+#include "geometry/space.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
 namespace principia {
 namespace testing_utilities {
 namespace _optimization_test_functions {
 namespace internal {
 
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_space;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+
 // See https://www.sfu.ca/~ssurjano/branin.html.
 double Branin(double x₁, double x₂);
 std::array<double, 2> 𝛁Branin(double x₁, double x₂);
@@ -19,6 +29,14 @@ std::array<double, 2> 𝛁GoldsteinPrice(double x₁, double x₂);
 double Hartmann3(double x₁, double x₂, double x₃);
 std::array<double, 3> 𝛁Hartmann3(double x₁, double x₂, double x₃);
 
+// The same function and its gradient, taking as arguments the coordinates of a
+// displacement in metres, for use with |MultiLevelSingleLinkage|.
+template<typename Frame>
+double Hartmann3(Displacement<Frame> const& displacement);
+template<typename Frame>
+Vector<Inverse<Length>, Frame> 𝛁Hartmann3(
+    Displacement<Frame> const& displacement);
+
 }  // namespace internal
 
 using internal::𝛁Branin;
@@ -31,3 +49,5 @@ using internal::Hartmann3;
 }  // namespace _optimization_test_functions
 }  // namespace testing_utilities
 }  // namespace principia
+
+#include "testing_utilities/optimization_test_functions_body.hpp"
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "testing_utilities/optimization_test_functions.hpp"
+
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace testing_utilities {
+namespace _optimization_test_functions {
+namespace internal {
+
+using namespace principia::quantities::_si;
+
+template<typename Frame>
+double Hartmann3(Displacement<Frame> const& displacement) {
+  auto const& coordinates = displacement.coordinates();
+  double const x₀ = coordinates[0] / Metre;
+  double const x₁ = coordinates[1] / Metre;
+  double const x₂ = coordinates[2] / Metre;
+  return Hartmann3(x₀, x₁, x₂);
+}
+
+template<typename Frame>
+Vector<Inverse<Length>, Frame> 𝛁Hartmann3(
+    Displacement<Frame> const& displacement) {
+  auto const& coordinates = displacement.coordinates();
+  double const x₀ = coordinates[0] / Metre;
+  double const x₁ = coordinates[1] / Metre;
+  double const x₂ = coordinates[2] / Metre;
+  auto const [g₀, g₁, g₂] = 𝛁Hartmann3(x₀, x₁, x₂);
+  return Vector<Inverse<Length>, Frame>({g₀ / Metre, g₁ / Metre, g₂ / Metre});
+}
+
+}  // namespace internal
+}  // namespace _optimization_test_functions
+}  // namespace testing_utilities
+}  // namespace principia
@@ -1719,9 +1719,13 @@ void JournalProtoProcessor::ProcessMethodExtension(
   }
   cxx_interface_method_declaration_[descriptor] += ");\n\n";
 
+  bool const is_diagnostic =
+      options.HasExtension(journal::serialization::is_diagnostic) &&
+      options.GetExtension(journal::serialization::is_diagnostic);
   cxx_play_statement_[descriptor] =
       "  ran |= RunIfAppropriate<" + name + ">(\n"
-      "             *method_in, *method_out_return);\n";
+      "             *method_in, *method_out_return, /*is_diagnostic=*/" +
+      (is_diagnostic ? "true" : "false") + ");\n";
 }
 
 bool JournalProtoProcessor::HasMarshaler(